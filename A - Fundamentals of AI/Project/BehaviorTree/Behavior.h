@@ -4,25 +4,151 @@
 #ifndef _FULLSAIL_AI_FUNDAMENTALS_BEHAVIOR_H_
 #define _FULLSAIL_AI_FUNDAMENTALS_BEHAVIOR_H_
 
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
 #include <vector>
 #include "../platform.h"
 #include "../QueueList/QueueList.h"
+#include "../QueueList/RingQueue.h"
 
 namespace fullsail_ai { namespace fundamentals {
 
+	class BehaviorArena;
+
+	//! \brief Allocates from \a arena (see <code>BehaviorArena</code>), or from the heap if
+	//! \a arena is NULL.
+	DLLEXPORT void* allocateFrom(BehaviorArena* arena, size_t size, size_t alignment);
+
+	//! \brief Frees what <code>allocateFrom()</code> returned. Arena memory is only freed
+	//! with its arena, so this does nothing unless \a arena is NULL.
+	DLLEXPORT void deallocateFrom(BehaviorArena* arena, void* pointer);
+
+	//! \brief The allocator of a behavior's child list: the heap by default, or the arena
+	//! that holds the behavior.
+	template <typename T>
+	class ChildAllocator
+	{
+		template <typename U>
+		friend class ChildAllocator;
+
+		BehaviorArena* arena;
+
+	public:
+		typedef T value_type;
+		typedef std::true_type propagate_on_container_copy_assignment;
+		typedef std::true_type propagate_on_container_move_assignment;
+		typedef std::true_type propagate_on_container_swap;
+
+		ChildAllocator(BehaviorArena* _arena = NULL) : arena(_arena) {}
+
+		template <typename U>
+		ChildAllocator(ChildAllocator<U> const& other) : arena(other.arena) {}
+
+		T* allocate(size_t count)
+		{
+			return static_cast<T*>(allocateFrom(arena, count * sizeof(T), alignof(T)));
+		}
+
+		void deallocate(T* pointer, size_t)
+		{
+			deallocateFrom(arena, pointer);
+		}
+
+		template <typename U>
+		bool operator==(ChildAllocator<U> const& other) const { return arena == other.arena; }
+
+		template <typename U>
+		bool operator!=(ChildAllocator<U> const& other) const { return arena != other.arena; }
+	};
+
 	//! \brief C++ implementation of an n-ary behavior tree node.
-	class Behavior
+	class DLLEXPORT_CLASS Behavior
 	{
+		friend class BehaviorArena;
+
 	private:
-		static unsigned createdCount;
-		static unsigned destroyedCount;
+		// Atomic so that trees may be built and torn down on several threads at once.
+		static std::atomic<unsigned> createdCount;
+		static std::atomic<unsigned> destroyedCount;
+
+		// Lends a thread's scratch queue to one breadth-first traversal at a time, or a
+		// local queue to a traversal started inside another. However the traversal ends,
+		// even by a visitor throwing, the scratch queue is emptied and handed back.
+		class ScratchQueue
+		{
+			RingQueue<Behavior const*>& scratch;
+			bool& scratchInUse;
+			RingQueue<Behavior const*> local;
+			bool owner;
+
+			ScratchQueue(ScratchQueue const&) = delete;
+			ScratchQueue& operator=(ScratchQueue const&) = delete;
+
+		public:
+			ScratchQueue(RingQueue<Behavior const*>& _scratch, bool& _scratchInUse)
+				: scratch(_scratch), scratchInUse(_scratchInUse), owner(!_scratchInUse)
+			{
+				scratchInUse = true;
+			}
+
+			~ScratchQueue()
+			{
+				if (owner)
+				{
+					scratch.removeAll();
+					scratchInUse = false;
+				}
+			}
+
+			RingQueue<Behavior const*>& get() { return owner ? scratch : local; }
+		};
+
+		// Marks where one depth-first traversal starts on a thread's explicit stack, which
+		// a traversal started inside another works above. However the traversal ends, even
+		// by a visitor throwing, the stack is cut back to that mark.
+		template <typename Entry>
+		class ScratchStack
+		{
+			std::vector<Entry>& pending;
+			size_t base;
+
+			ScratchStack(ScratchStack const&) = delete;
+			ScratchStack& operator=(ScratchStack const&) = delete;
+
+		public:
+			explicit ScratchStack(std::vector<Entry>& _pending)
+				: pending(_pending), base(_pending.size())
+			{
+			}
+
+			~ScratchStack()
+			{
+				pending.erase(pending.begin() + base, pending.end());
+			}
+
+			size_t getBase() const { return base; }
+		};
 
 	protected:
 		Behavior* parent;
-		std::vector<Behavior*> children;
+		std::vector<Behavior*, ChildAllocator<Behavior*> > children;
 		char const* description;
 
 	public:
+		//! \brief The outcome of <code>step()</code>.
+		enum Status { FAILURE = 0, SUCCESS, RUNNING };
+
+		//! \brief The version of the library's exported interface that these headers
+		//! describe. Version 2 made <code>~Behavior()</code> virtual and added
+		//! <code>step()</code>, which changed the vtable of every behavior.
+		enum { ABI_VERSION = 2 };
+
+		//! \brief Returns the <code>ABI_VERSION</code> the library was built with. A module
+		//! built against headers of another version must not use the library.
+		DLLEXPORT static unsigned getAbiVersion();
+
 		DLLEXPORT static unsigned getCreatedCount();
 		DLLEXPORT static unsigned getDestroyedCount();
 
@@ -33,6 +159,10 @@ namespace fullsail_ai { namespace fundamentals {
 		//! \brief Creates a new <code>%Behavior</code>with the description.
 		DLLEXPORT Behavior(char const* _description);
 
+		//! \brief Destroys this <code>%Behavior</code>, but not its children; whoever built
+		//! the tree deletes every node, or destroys the <code>BehaviorArena</code> holding it.
+		DLLEXPORT virtual ~Behavior();
+
 		//! \brief Returns a string representation of this <code>%Behavior</code>.
 		DLLEXPORT char const* toString() const;
 
@@ -67,7 +197,8 @@ namespace fullsail_ai { namespace fundamentals {
 		//! \pre     <code>NULL !=</code> \a this
 		DLLEXPORT void breadthFirstTraverse(void (*dataFunction)(Behavior const*)) const;
 
-		//! \brief Traverses the root and all sub-nodes in pre-order fashion.
+		//! \brief Traverses the root and all sub-nodes in pre-order fashion. Works from an
+		//! explicit stack, so the depth of the tree is not limited by the call stack.
 		//!
 		//! \param   dataFunction  a single-argument function that accepts the traversed node
 		//!                        a valid argument.
@@ -75,7 +206,8 @@ namespace fullsail_ai { namespace fundamentals {
 		//! \pre     <code>NULL !=</code> \a this
 		DLLEXPORT void preOrderTraverse(void (*dataFunction)(Behavior const*)) const;
 
-		//! \brief Traverses the root and all sub-nodes in post-order fashion.
+		//! \brief Traverses the root and all sub-nodes in post-order fashion. Works from an
+		//! explicit stack, so the depth of the tree is not limited by the call stack.
 		//!
 		//! \param   dataFunction  a single-argument function that accepts the traversed node
 		//!                        a valid argument.
@@ -83,6 +215,33 @@ namespace fullsail_ai { namespace fundamentals {
 		//! \pre     <code>NULL !=</code> \a this
 		DLLEXPORT void postOrderTraverse(void (*dataFunction)(Behavior const*)) const;
 
+		//! \brief Traverses the root and all sub-nodes breadth-first, calling \a visitor on
+		//! each.
+		//!
+		//! Unlike the function-pointer overload, this one is compiled into the caller, so a
+		//! lambda or function object \a visitor can be inlined. Function pointers still pick
+		//! the exported overload.
+		//!
+		//! \param   visitor  a callable that accepts the traversed node.
+		//!
+		//! \pre     <code>NULL !=</code> \a this
+		template <typename Visitor>
+		void breadthFirstTraverse(Visitor&& visitor) const;
+
+		//! \brief Traverses the root and all sub-nodes in pre-order fashion, calling
+		//! \a visitor on each. Inlinable, like the templated <code>breadthFirstTraverse()</code>.
+		//!
+		//! \pre     <code>NULL !=</code> \a this
+		template <typename Visitor>
+		void preOrderTraverse(Visitor&& visitor) const;
+
+		//! \brief Traverses the root and all sub-nodes in post-order fashion, calling
+		//! \a visitor on each. Inlinable, like the templated <code>breadthFirstTraverse()</code>.
+		//!
+		//! \pre     <code>NULL !=</code> \a this
+		template <typename Visitor>
+		void postOrderTraverse(Visitor&& visitor) const;
+
 		//=======================================
 		//  VIRTUAL (BEHAVIOR-SPECIFIC) METHODS
 		//=======================================
@@ -94,7 +253,89 @@ namespace fullsail_ai { namespace fundamentals {
 		//!
 		//! \pre     <code>NULL !=</code> \a this
 		DLLEXPORT virtual bool run(void (*dataFunction)(Behavior const*), void* context) = 0;
+
+		//! \brief Executes the behavior like <code>run()</code>, but may also leave it in
+		//! progress. Returns <code>SUCCESS</code> (and runs dataFunction) or
+		//! <code>FAILURE</code> as <code>run()</code> would, or <code>RUNNING</code>, without
+		//! running dataFunction, if the behavior needs more ticks to finish; the next call
+		//! continues it. (Default: the result of <code>run()</code>.)
+		//!
+		//! \pre     <code>NULL !=</code> \a this
+		DLLEXPORT virtual Status step(void (*dataFunction)(Behavior const*), void* context);
 	};
+
+	template <typename Visitor>
+	void Behavior::breadthFirstTraverse(Visitor&& visitor) const
+	{
+		// The same per-thread queue scheme as the exported overload, one per visitor type.
+		static thread_local RingQueue<Behavior const*> scratch;
+		static thread_local bool scratchInUse = false;
+
+		ScratchQueue lease(scratch, scratchInUse);
+		RingQueue<Behavior const*>& queue = lease.get();
+		queue.enqueue(this);
+
+		while (!queue.isEmpty())
+		{
+			Behavior const* node = queue.getFront();
+			queue.dequeue();
+			visitor(node);
+
+			for (size_t index = 0; index < node->children.size(); index++)
+				queue.enqueue(node->children[index]);
+		}
+	}
+
+	template <typename Visitor>
+	void Behavior::preOrderTraverse(Visitor&& visitor) const
+	{
+		// The same explicit stack as the exported overload, one per visitor type.
+		static thread_local std::vector<Behavior const*> pending;
+		ScratchStack<Behavior const*> mark(pending);
+		size_t base = mark.getBase();
+		pending.push_back(this);
+
+		while (pending.size() > base)
+		{
+			Behavior const* node = pending.back();
+			pending.pop_back();
+			visitor(node);
+
+			for (size_t index = node->children.size(); index-- > 0; )
+				pending.push_back(node->children[index]);
+		}
+	}
+
+	template <typename Visitor>
+	void Behavior::postOrderTraverse(Visitor&& visitor) const
+	{
+		static thread_local std::vector<std::pair<Behavior const*, size_t> > pending;
+		ScratchStack<std::pair<Behavior const*, size_t> > mark(pending);
+		size_t base = mark.getBase();
+		Behavior const* node = this;
+		size_t next = 0;
+
+		for (;;)
+		{
+			if (next < node->children.size())
+			{
+				pending.push_back(std::make_pair(node, next + 1));
+				node = node->children[next];
+				next = 0;
+			}
+			else
+			{
+				visitor(node);
+
+				if (pending.size() == base)
+					return;
+
+				node = pending.back().first;
+				next = pending.back().second;
+				pending.pop_back();
+			}
+		}
+	}
 }}  // namespace fullsail_ai::fundamentals
 
 #endif  // _FULLSAIL_AI_FUNDAMENTALS_BEHAVIOR_H_
@@ -0,0 +1,97 @@
+//! \file BehaviorArena.cpp
+//! \brief Implements the <code>fullsail_ai::fundamentals::BehaviorArena</code> class.
+
+#include <cstdint>
+#include "BehaviorArena.h"
+
+namespace fullsail_ai { namespace fundamentals {
+
+	void* allocateFrom(BehaviorArena* arena, size_t size, size_t alignment)
+	{
+		return arena ? arena->allocate(size, alignment) : ::operator new(size);
+	}
+
+	void deallocateFrom(BehaviorArena* arena, void* pointer)
+	{
+		if (!arena)
+			::operator delete(pointer);
+	}
+
+	BehaviorArena::BehaviorArena(size_t _blockSize)
+		: current(0), cursor(NULL), limit(NULL), blockSize(_blockSize), bytesAllocated(0)
+	{
+	}
+
+	BehaviorArena::~BehaviorArena()
+	{
+		destroyNodes();
+
+		for (size_t index = 0; index < blocks.size(); index++)
+			::operator delete(blocks[index].data);
+	}
+
+	void* BehaviorArena::allocate(size_t size, size_t alignment)
+	{
+		std::uintptr_t address = (reinterpret_cast<std::uintptr_t>(cursor) + alignment - 1) & ~(std::uintptr_t)(alignment - 1);
+
+		if (!cursor || address + size > reinterpret_cast<std::uintptr_t>(limit))
+		{
+			// Whatever is left of the current block is abandoned; nodes are small next to it.
+			// The next block is reused if a clear() left one big enough.
+			size_t bytes = (size + alignment > blockSize) ? size + alignment : blockSize;
+			size_t next = cursor ? current + 1 : 0;
+
+			if (next == blocks.size() || blocks[next].size < bytes)
+			{
+				Block block = { static_cast<char*>(::operator new(bytes)), bytes };
+
+				blocks.insert(blocks.begin() + next, block);
+				bytesAllocated += bytes;
+			}
+
+			current = next;
+			cursor = blocks[current].data;
+			limit = cursor + blocks[current].size;
+			address = (reinterpret_cast<std::uintptr_t>(cursor) + alignment - 1) & ~(std::uintptr_t)(alignment - 1);
+		}
+
+		cursor = reinterpret_cast<char*>(address + size);
+		return reinterpret_cast<void*>(address);
+	}
+
+	void BehaviorArena::adopt(Behavior* behavior)
+	{
+		std::vector<Behavior*, ChildAllocator<Behavior*> > children(behavior->children.begin(), behavior->children.end(),
+		                                                              ChildAllocator<Behavior*>(this));
+
+		behavior->children = std::move(children);
+		nodes.push_back(behavior);
+	}
+
+	void BehaviorArena::destroyNodes()
+	{
+		// Newest first, so a node is gone before anything it was built from. Their child
+		// lists live in the blocks, so the destructors free nothing.
+		for (size_t index = nodes.size(); index-- > 0; )
+			nodes[index]->~Behavior();
+
+		nodes.clear();
+	}
+
+	void BehaviorArena::clear()
+	{
+		destroyNodes();
+		current = 0;
+		cursor = limit = NULL;
+	}
+
+	size_t BehaviorArena::getNodeCount() const
+	{
+		return nodes.size();
+	}
+
+	size_t BehaviorArena::getBytesAllocated() const
+	{
+		return bytesAllocated;
+	}
+}}  // namespace fullsail_ai::fundamentals
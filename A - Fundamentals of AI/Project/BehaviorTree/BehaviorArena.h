@@ -0,0 +1,86 @@
+//! \file BehaviorArena.h
+//! \brief Defines the <code>fullsail_ai::fundamentals::BehaviorArena</code> class.
+#ifndef _FULLSAIL_AI_FUNDAMENTALS_BEHAVIOR_ARENA_H_
+#define _FULLSAIL_AI_FUNDAMENTALS_BEHAVIOR_ARENA_H_
+
+#include <new>
+#include <utility>
+#include <vector>
+#include "Behavior.h"
+
+namespace fullsail_ai { namespace fundamentals {
+
+	//! \brief Owns the nodes of one or more behavior trees, placed with their child lists
+	//! in a few large blocks.
+	//!
+	//! Building a tree with <code>new</code> costs an allocation per node and another per
+	//! child list, and tearing it down walks the tree to free each one. Nodes created here
+	//! are instead carved from blocks of \a blockSize bytes, and so are the child lists
+	//! they grow; clearing the arena runs every node's destructor, newest first, without
+	//! freeing anything, and keeps the blocks for the next trees. Destroying the arena
+	//! frees them all at once.
+	//!
+	//! \note
+	//!   - Do not <code>delete</code> a node the arena created, and do not add a node built
+	//!     with <code>new</code> under one: the arena would not free it.
+	//!   - An arena is not safe to use from several threads at once; give each thread its own.
+	class DLLEXPORT_CLASS BehaviorArena
+	{
+	private:
+		struct Block
+		{
+			char* data;
+			size_t size;
+		};
+
+		std::vector<Block> blocks;
+		std::vector<Behavior*> nodes; // In creation order
+		size_t current; // The block being carved, while cursor is not NULL
+		char* cursor; // The free space left in the current block
+		char* limit;
+		size_t blockSize;
+		size_t bytesAllocated;
+
+		void destroyNodes();
+
+		BehaviorArena(BehaviorArena const&) = delete;
+		BehaviorArena& operator=(BehaviorArena const&) = delete;
+
+	public:
+		//! \brief Creates an empty arena that allocates blocks of \a _blockSize bytes (or
+		//! larger, for a larger request).
+		DLLEXPORT explicit BehaviorArena(size_t _blockSize = 64 * 1024);
+
+		//! \brief Destroys every node the arena holds and frees its blocks.
+		DLLEXPORT ~BehaviorArena();
+
+		//! \brief Constructs a <code>T</code> in the arena from \a arguments, and adopts it.
+		template <typename T, typename... Arguments>
+		T* create(Arguments&&... arguments)
+		{
+			T* behavior = new (allocate(sizeof(T), alignof(T))) T(std::forward<Arguments>(arguments)...);
+			adopt(behavior);
+			return behavior;
+		}
+
+		//! \brief Returns \a size bytes of the arena, aligned to \a alignment (a power of
+		//! two), valid until the arena is cleared.
+		DLLEXPORT void* allocate(size_t size, size_t alignment);
+
+		//! \brief Takes charge of a node constructed in memory from <code>allocate()</code>:
+		//! moves its child list into the arena and destroys it with the arena.
+		DLLEXPORT void adopt(Behavior* behavior);
+
+		//! \brief Destroys every node the arena holds, leaving it empty. Its blocks are kept,
+		//! so building a tree of the same size again allocates nothing.
+		DLLEXPORT void clear();
+
+		//! \brief Returns the number of nodes the arena holds.
+		DLLEXPORT size_t getNodeCount() const;
+
+		//! \brief Returns the total size of the arena's blocks.
+		DLLEXPORT size_t getBytesAllocated() const;
+	};
+}}  // namespace fullsail_ai::fundamentals
+
+#endif  // _FULLSAIL_AI_FUNDAMENTALS_BEHAVIOR_ARENA_H_
@@ -3,28 +3,42 @@
 //! \author Jeremiah Blanchard with code from Cromwell D. Enage
 
 // #include <queue>   NOTE: Only use if your QueueList is not working
-#include <stack>
+#include <utility>
+#include <vector>
 #include "Behavior.h"
 
 namespace fullsail_ai { namespace fundamentals {
 
-	// DO NOT Edit or Use these two variables for any reason, it is for memory leak check purposes only.
-	unsigned Behavior::createdCount = 0;
-	unsigned Behavior::destroyedCount = 0;
+	// These two counters are for memory leak checks only. The constructor and destructor
+	// count nodes, atomically, and nothing else may change them.
+	std::atomic<unsigned> Behavior::createdCount(0);
+	std::atomic<unsigned> Behavior::destroyedCount(0);
+
+	unsigned Behavior::getAbiVersion()
+	{
+		return ABI_VERSION;
+	}
 
 	unsigned Behavior::getCreatedCount()
 	{
-		return createdCount;
+		return createdCount.load(std::memory_order_relaxed);
 	}
 
 	unsigned Behavior::getDestroyedCount()
 	{
-		return destroyedCount;
+		return destroyedCount.load(std::memory_order_relaxed);
 	}
 
 	Behavior::Behavior(char const* _description)
 	{
+		parent = NULL;
 		description = _description;
+		createdCount.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	Behavior::~Behavior()
+	{
+		destroyedCount.fetch_add(1, std::memory_order_relaxed);
 	}
 
 	char const* Behavior::toString() const
@@ -38,6 +52,11 @@ namespace fullsail_ai { namespace fundamentals {
 		return false;
 	}
 
+	Behavior::Status Behavior::step(void (*dataFunction)(Behavior const*), void* context)
+	{
+		return run(dataFunction, context) ? SUCCESS : FAILURE;
+	}
+
 	//! \TODO
 	//!   - Implement the <code>Behavior</code> methods.
 	
@@ -61,7 +80,13 @@ namespace fullsail_ai { namespace fundamentals {
 
 	//traversal methods
 	void Behavior::breadthFirstTraverse(void (*dataFunction)(Behavior const*)) const {
-		QueueList<Behavior const*> q;
+		// Keep one queue per thread so its buffer stays warm between traversals.
+		// A traversal started from inside dataFunction falls back to a local queue.
+		static thread_local RingQueue<Behavior const*> scratch;
+		static thread_local bool scratchInUse = false;
+
+		ScratchQueue lease(scratch, scratchInUse);
+		RingQueue<Behavior const*>& q = lease.get();
 		q.enqueue(this);
 
 		while (!q.isEmpty()) {
@@ -69,26 +94,59 @@ namespace fullsail_ai { namespace fundamentals {
 			q.dequeue();
 			dataFunction(node);
 
-			for (int i = 0; i < node->getChildCount(); i++) {
+			for (size_t i = 0; i < node->getChildCount(); i++) {
 				q.enqueue(node->getChild(i));
 			}
 		}
 	}
 
 	void Behavior::preOrderTraverse(void (*dataFunction)(Behavior const*)) const {
-		dataFunction(this);
+		// An explicit stack, so that the depth of the tree is not limited by the call stack.
+		// The stack is kept per thread; a traversal started from inside dataFunction works
+		// above the entries of the one that called it.
+		static thread_local std::vector<Behavior const*> pending;
+		ScratchStack<Behavior const*> mark(pending);
+		size_t base = mark.getBase();
+		pending.push_back(this);
+
+		while (pending.size() > base) {
+			Behavior const* node = pending.back();
+			pending.pop_back();
+			dataFunction(node);
 
-		for (int i = 0; i < getChildCount(); i++) {
-			getChild(i)->preOrderTraverse(dataFunction);
+			// Pushed last to first, so the first child is visited next.
+			for (size_t i = node->children.size(); i-- > 0; ) {
+				pending.push_back(node->children[i]);
+			}
 		}
 	}
 
 	void Behavior::postOrderTraverse(void (*dataFunction)(Behavior const*)) const {
-		for (int i = 0; i < getChildCount(); i++) {
-			getChild(i)->postOrderTraverse(dataFunction);
-		}
+		// The node being traversed and the index of its next child live in locals; each
+		// entry is an ancestor and the index of the child to take after this subtree.
+		static thread_local std::vector<std::pair<Behavior const*, size_t> > pending;
+		ScratchStack<std::pair<Behavior const*, size_t> > mark(pending);
+		size_t base = mark.getBase();
+		Behavior const* node = this;
+		size_t next = 0;
+
+		for (;;) {
+			if (next < node->children.size()) {
+				pending.push_back(std::make_pair(node, next + 1));
+				node = node->children[next];
+				next = 0;
+			}
+			else {
+				dataFunction(node);
+
+				if (pending.size() == base)
+					return;
 
-		dataFunction(this);
+				node = pending.back().first;
+				next = pending.back().second;
+				pending.pop_back();
+			}
+		}
 	}
 
 }}  // namespace fullsail_ai::fundamentals
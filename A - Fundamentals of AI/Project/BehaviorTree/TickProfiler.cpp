@@ -0,0 +1,311 @@
+//! \file TickProfiler.cpp
+//! \brief Implements the <code>fullsail_ai::fundamentals::TickProfiler</code> class.
+
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include "TickProfiler.h"
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+	#include <intrin.h>
+	#define FULLSAIL_HAS_TSC
+#elif defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+	#include <x86intrin.h>
+	#define FULLSAIL_HAS_TSC
+#endif
+
+namespace fullsail_ai { namespace fundamentals {
+
+	namespace {
+		typedef std::chrono::steady_clock Clock;
+
+		unsigned long long readClock()
+		{
+#if defined(FULLSAIL_HAS_TSC)
+			return __rdtsc();
+#else
+			return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+#endif
+		}
+
+		// One node on one call path. The paths a thread has seen form a tree, linked
+		// through first children and next siblings; record 0 stands above every root.
+		struct Record
+		{
+			Behavior const* node;
+			std::string name; // node->toString() when the record was made, kept past the node
+			unsigned parent;
+			unsigned firstChild;
+			unsigned lastChild;
+			unsigned nextSibling;
+			unsigned long long invocations;
+			unsigned long long successes;
+			unsigned long long failures;
+			unsigned long long inclusive; // In clock ticks
+			unsigned long long exclusive;
+		};
+
+		struct Active
+		{
+			unsigned record;
+			unsigned lastChild; // The child entered last, whose next sibling usually runs next
+			unsigned long long start;
+			unsigned long long childTime;
+			bool nested; // Entered again by the runner already running it; records nothing
+		};
+
+		struct ThreadBuffer
+		{
+			std::vector<Record> records;
+			std::vector<Active> stack;
+			unsigned long long lastExit; // When the last node finished, if its parent is still running
+			bool hasLastExit;
+
+			ThreadBuffer() { clear(); }
+
+			void clear()
+			{
+				Record top = { NULL, std::string(), 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+
+				records.assign(1, top);
+				stack.clear();
+				hasLastExit = false;
+			}
+		};
+
+		struct Registry
+		{
+			std::mutex mutex;
+			std::vector<std::unique_ptr<ThreadBuffer> > buffers; // Outlive their threads
+			Clock::time_point startTime;
+			unsigned long long startClock;
+			double clockRate; // Measured once per profile, or 0
+
+			Registry() : startTime(Clock::now()), startClock(readClock()), clockRate(0) { }
+		};
+
+		Registry& getRegistry()
+		{
+			static Registry registry;
+			return registry;
+		}
+
+		ThreadBuffer& getBuffer()
+		{
+			static thread_local ThreadBuffer* buffer = NULL;
+
+			if (!buffer)
+			{
+				Registry& registry = getRegistry();
+				std::lock_guard<std::mutex> lock(registry.mutex);
+
+				registry.buffers.push_back(std::unique_ptr<ThreadBuffer>(new ThreadBuffer));
+				buffer = registry.buffers.back().get();
+			}
+
+			return *buffer;
+		}
+
+		// Clock ticks per second, measured against steady_clock since the last reset, and
+		// then kept so that every view of one profile agrees.
+		double getClockRate(Registry& registry)
+		{
+#if defined(FULLSAIL_HAS_TSC)
+			if (registry.clockRate == 0)
+			{
+				Clock::time_point end = registry.startTime + std::chrono::milliseconds(10);
+
+				while (Clock::now() < end) {;}
+
+				double seconds = std::chrono::duration<double>(Clock::now() - registry.startTime).count();
+				registry.clockRate = (readClock() - registry.startClock) / seconds;
+			}
+
+			return registry.clockRate;
+#else
+			return 1e9;
+#endif
+		}
+
+		std::string getPath(std::vector<Record> const& records, unsigned index)
+		{
+			std::string path;
+
+			for (; index != 0; index = records[index].parent)
+			{
+				std::string name = records[index].name;
+
+				// The folded format separates frames with ';' and lines with '\n'.
+				std::replace(name.begin(), name.end(), ';', ':');
+				std::replace(name.begin(), name.end(), '\n', ' ');
+				path = path.empty() ? name : name + ';' + path;
+			}
+
+			return path;
+		}
+	}
+
+	void TickProfiler::enter(Behavior const* node)
+	{
+		ThreadBuffer& buffer = getBuffer();
+		std::vector<Record>& records = buffer.records;
+		unsigned parent = buffer.stack.empty() ? 0 : buffer.stack.back().record;
+
+		// A composite run through its run() is entered by the caller and again by the
+		// runner it calls; a tree never holds a node under itself otherwise.
+		if (parent != 0 && records[parent].node == node)
+		{
+			Active active = { parent, buffer.stack.back().lastChild, 0, 0, true };
+			buffer.stack.push_back(active);
+			return;
+		}
+
+		unsigned index = buffer.stack.empty() ? 0 : buffer.stack.back().lastChild;
+		index = index ? records[index].nextSibling : records[parent].firstChild;
+
+		if (index == 0 || records[index].node != node)
+		{
+			for (index = records[parent].firstChild; index != 0 && records[index].node != node; )
+				index = records[index].nextSibling;
+		}
+
+		if (index == 0)
+		{
+			Record record = { node, node->toString(), parent, 0, 0, 0, 0, 0, 0, 0, 0 };
+
+			index = (unsigned)records.size();
+			records.push_back(std::move(record));
+
+			if (records[parent].lastChild)
+				records[records[parent].lastChild].nextSibling = index;
+			else
+				records[parent].firstChild = index;
+
+			records[parent].lastChild = index;
+		}
+
+		if (!buffer.stack.empty())
+			buffer.stack.back().lastChild = index;
+
+		// A node entered right after its sibling finished starts when the sibling did, which
+		// halves the clock reads; the parent's work in between is charged to the node.
+		Active active = { index, 0, buffer.hasLastExit ? buffer.lastExit : readClock(), 0, false };
+
+		buffer.hasLastExit = false;
+		buffer.stack.push_back(active);
+	}
+
+	void TickProfiler::exit(Behavior::Status status)
+	{
+		unsigned long long now = readClock();
+		ThreadBuffer& buffer = getBuffer();
+		Active active = buffer.stack.back();
+
+		buffer.stack.pop_back();
+
+		if (active.nested)
+		{
+			// Its children ran inside the entry it repeats.
+			buffer.stack.back().childTime += active.childTime;
+			buffer.stack.back().lastChild = active.lastChild;
+			return;
+		}
+
+		Record& record = buffer.records[active.record];
+		unsigned long long elapsed = now - active.start;
+
+		record.invocations++;
+		record.successes += (status == Behavior::SUCCESS);
+		record.failures += (status == Behavior::FAILURE);
+		record.inclusive += elapsed;
+		record.exclusive += elapsed - active.childTime;
+
+		if (!buffer.stack.empty())
+		{
+			buffer.stack.back().childTime += elapsed;
+			buffer.lastExit = now;
+			buffer.hasLastExit = true;
+		}
+		else
+			buffer.hasLastExit = false;
+	}
+
+	std::vector<TickProfiler::NodeProfile> TickProfiler::getNodeProfiles()
+	{
+		Registry& registry = getRegistry();
+		std::lock_guard<std::mutex> lock(registry.mutex);
+		double rate = getClockRate(registry);
+		std::map<Behavior const*, NodeProfile> merged;
+		std::vector<NodeProfile> profiles;
+
+		for (size_t buffer = 0; buffer < registry.buffers.size(); buffer++)
+		{
+			std::vector<Record> const& records = registry.buffers[buffer]->records;
+
+			for (size_t index = 1; index < records.size(); index++)
+			{
+				NodeProfile& profile = merged[records[index].node];
+
+				profile.node = records[index].node;
+				profile.name = records[index].name;
+				profile.invocations += records[index].invocations;
+				profile.successes += records[index].successes;
+				profile.failures += records[index].failures;
+				profile.inclusiveSeconds += records[index].inclusive / rate;
+				profile.exclusiveSeconds += records[index].exclusive / rate;
+			}
+		}
+
+		for (std::map<Behavior const*, NodeProfile>::const_iterator entry = merged.begin(); entry != merged.end(); ++entry)
+			profiles.push_back(entry->second);
+
+		std::stable_sort(profiles.begin(), profiles.end(), [](NodeProfile const& lhs, NodeProfile const& rhs)
+		{
+			return lhs.exclusiveSeconds > rhs.exclusiveSeconds;
+		});
+
+		return profiles;
+	}
+
+	void TickProfiler::writeFoldedStacks(std::ostream& stream)
+	{
+		Registry& registry = getRegistry();
+		std::lock_guard<std::mutex> lock(registry.mutex);
+		double nanosecondsPerTick = 1e9 / getClockRate(registry);
+		std::map<std::string, double> stacks;
+
+		// Threads, and trees whose nodes share descriptions, fold into the same lines.
+		for (size_t buffer = 0; buffer < registry.buffers.size(); buffer++)
+		{
+			std::vector<Record> const& records = registry.buffers[buffer]->records;
+
+			for (unsigned index = 1; index < records.size(); index++)
+				stacks[getPath(records, index)] += records[index].exclusive * nanosecondsPerTick;
+		}
+
+		for (std::map<std::string, double>::const_iterator stack = stacks.begin(); stack != stacks.end(); ++stack)
+		{
+			unsigned long long nanoseconds = (unsigned long long)(stack->second + 0.5);
+
+			if (nanoseconds)
+				stream << stack->first << ' ' << nanoseconds << '\n';
+		}
+	}
+
+	void TickProfiler::reset()
+	{
+		Registry& registry = getRegistry();
+		std::lock_guard<std::mutex> lock(registry.mutex);
+
+		for (size_t buffer = 0; buffer < registry.buffers.size(); buffer++)
+			registry.buffers[buffer]->clear();
+
+		registry.startTime = Clock::now();
+		registry.startClock = readClock();
+		registry.clockRate = 0;
+	}
+}}  // namespace fullsail_ai::fundamentals
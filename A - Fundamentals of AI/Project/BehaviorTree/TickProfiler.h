@@ -0,0 +1,81 @@
+//! \file TickProfiler.h
+//! \brief Defines the <code>fullsail_ai::fundamentals::TickProfiler</code> class and the
+//! hooks that feed it.
+#ifndef _FULLSAIL_AI_FUNDAMENTALS_TICK_PROFILER_H_
+#define _FULLSAIL_AI_FUNDAMENTALS_TICK_PROFILER_H_
+
+#include <ostream>
+#include <string>
+#include <vector>
+#include "Behavior.h"
+
+namespace fullsail_ai { namespace fundamentals {
+
+	//! \brief Counts and times every node the composites tick, per call path.
+	//!
+	//! The tree runners call <code>enter()</code> before a node runs and <code>exit()</code>
+	//! after, through the <code>FULLSAIL_PROFILE_ENTER</code> and
+	//! <code>FULLSAIL_PROFILE_EXIT</code> hooks. Those expand to nothing unless
+	//! <code>FULLSAIL_PROFILE_TICKS</code> is defined (the FUNDAMENTALS_PROFILE option of the
+	//! CMake build), so an ordinary build pays nothing for them.
+	//!
+	//! Each thread records into its own buffer, a tree of the call paths it has seen, so
+	//! a node shared by several paths or trees is kept apart per path. Timestamps come from
+	//! the time-stamp counter where there is one, and from <code>steady_clock</code>
+	//! otherwise.
+	//!
+	//! \note
+	//!   - <code>Composite::runSubtree()</code> and <code>Composite::resume()</code> are
+	//!     instrumented, so <code>run()</code> on a sequence or selector and
+	//!     <code>Agent::update()</code> are profiled. The flat runners
+	//!     (<code>CompiledBehavior</code>, <code>BatchBehavior</code>,
+	//!     <code>BehaviorImage::run()</code>) are not.
+	//!   - A node left <code>RUNNING</code> counts an invocation, but neither a success nor
+	//!     a failure, on every tick it runs; the composites above it count one as well.
+	//!   - Read or reset the profile only while no thread is ticking a tree.
+	//!   - The profile keeps a copy of each node's name, so it may be read after the trees
+	//!     it saw are destroyed. Reset it before profiling trees built in their place.
+	class DLLEXPORT_CLASS TickProfiler
+	{
+	public:
+		//! \brief What the profile holds for one node, added up over its call paths.
+		struct NodeProfile
+		{
+			Behavior const* node; // Identifies the node; it may no longer exist
+			std::string name; // The node's toString(), copied when it was first entered
+			unsigned long long invocations;
+			unsigned long long successes;
+			unsigned long long failures;
+			double inclusiveSeconds; // Including the nodes it ran
+			double exclusiveSeconds; // Excluding them
+		};
+
+		//! \brief Records that \a node starts running on this thread.
+		DLLEXPORT static void enter(Behavior const* node);
+
+		//! \brief Records that the node last entered on this thread finished with \a status.
+		DLLEXPORT static void exit(Behavior::Status status);
+
+		//! \brief Returns the profile of every node run since the last <code>reset()</code>,
+		//! merged over all threads, most exclusive time first.
+		DLLEXPORT static std::vector<NodeProfile> getNodeProfiles();
+
+		//! \brief Writes the exclusive time of every call path, in nanoseconds, as folded
+		//! stacks: one "Root;Child;Leaf nanoseconds" line per path, named by
+		//! <code>toString()</code>, for flamegraph.pl or speedscope.
+		DLLEXPORT static void writeFoldedStacks(std::ostream& stream);
+
+		//! \brief Forgets everything recorded so far, on every thread.
+		DLLEXPORT static void reset();
+	};
+}}  // namespace fullsail_ai::fundamentals
+
+#if defined(FULLSAIL_PROFILE_TICKS)
+	#define FULLSAIL_PROFILE_ENTER(node) ::fullsail_ai::fundamentals::TickProfiler::enter(node)
+	#define FULLSAIL_PROFILE_EXIT(status) ::fullsail_ai::fundamentals::TickProfiler::exit(status)
+#else
+	#define FULLSAIL_PROFILE_ENTER(node) ((void)0)
+	#define FULLSAIL_PROFILE_EXIT(status) ((void)0)
+#endif
+
+#endif  // _FULLSAIL_AI_FUNDAMENTALS_TICK_PROFILER_H_
@@ -0,0 +1,231 @@
+//! \file TraceRecorder.cpp
+//! \brief Implements the <code>fullsail_ai::fundamentals::TraceRecorder</code> class.
+
+#include <condition_variable>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "TraceRecorder.h"
+
+namespace fullsail_ai { namespace fundamentals {
+
+	namespace {
+		struct Event
+		{
+			char const* name;
+			unsigned long long start;
+			unsigned long long end;
+		};
+
+		// Written by one thread, read by the flush thread. Each index only grows; the
+		// difference is the number of events waiting.
+		struct Ring
+		{
+			std::unique_ptr<Event[]> events;
+			size_t mask;
+			std::atomic<size_t> head; // Next to write
+			std::atomic<size_t> tail; // Next to read
+			std::atomic<unsigned long long> dropped;
+			unsigned threadId;
+			bool named; // Whether the file has the thread's name yet
+
+			Ring(unsigned _threadId, size_t capacity) : threadId(_threadId)
+			{
+				reset(capacity);
+			}
+
+			void reset(size_t capacity)
+			{
+				events.reset(new Event[capacity]);
+				mask = capacity - 1;
+				head.store(0, std::memory_order_relaxed);
+				tail.store(0, std::memory_order_relaxed);
+				dropped.store(0, std::memory_order_relaxed);
+				named = false;
+			}
+		};
+
+		struct Recorder
+		{
+			std::mutex mutex; // Guards everything below
+			std::condition_variable wake;
+			std::vector<std::unique_ptr<Ring> > rings; // Outlive their threads
+			std::thread flusher;
+			std::FILE* file;
+			size_t capacity;
+			unsigned long long origin; // now() at start(), time 0 in the file
+			unsigned long long dropped; // Counted at stop()
+			bool stopping;
+
+			Recorder() : file(NULL), capacity(1 << 16), origin(0), dropped(0), stopping(false) { }
+		};
+
+		Recorder& getRecorder()
+		{
+			static Recorder recorder;
+			return recorder;
+		}
+
+		Ring& getRing()
+		{
+			static thread_local Ring* ring = NULL;
+
+			if (!ring)
+			{
+				Recorder& recorder = getRecorder();
+				std::lock_guard<std::mutex> lock(recorder.mutex);
+
+				recorder.rings.push_back(std::unique_ptr<Ring>(new Ring((unsigned)recorder.rings.size() + 1, recorder.capacity)));
+				ring = recorder.rings.back().get();
+			}
+
+			return *ring;
+		}
+
+		// Writes what every ring holds. Called with the mutex held.
+		void drain(Recorder& recorder)
+		{
+			for (size_t index = 0; index < recorder.rings.size(); index++)
+			{
+				Ring& ring = *recorder.rings[index];
+				size_t tail = ring.tail.load(std::memory_order_relaxed);
+				size_t head = ring.head.load(std::memory_order_acquire);
+
+				if (tail == head)
+					continue;
+
+				if (!ring.named)
+				{
+					std::fprintf(recorder.file, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,"
+					             "\"args\":{\"name\":\"thread %u\"}}", ring.threadId, ring.threadId);
+					ring.named = true;
+				}
+
+				for (; tail != head; tail++)
+				{
+					Event const& event = ring.events[tail & ring.mask];
+
+					std::fprintf(recorder.file, ",\n{\"name\":\"%s\",\"cat\":\"wumpus\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,"
+					             "\"ts\":%.3f,\"dur\":%.3f}", event.name, ring.threadId,
+					             (long long)(event.start - recorder.origin) / 1e3, (event.end - event.start) / 1e3);
+				}
+
+				ring.tail.store(tail, std::memory_order_release);
+			}
+		}
+
+		void flush(Recorder& recorder)
+		{
+			std::unique_lock<std::mutex> lock(recorder.mutex);
+
+			while (!recorder.stopping)
+			{
+				recorder.wake.wait_for(lock, std::chrono::milliseconds(10));
+				drain(recorder);
+			}
+		}
+	}
+
+	std::atomic<bool> TraceRecorder::enabled(false);
+
+	bool TraceRecorder::start(char const* path, size_t capacity)
+	{
+		Recorder& recorder = getRecorder();
+		std::lock_guard<std::mutex> lock(recorder.mutex);
+
+		if (enabled.load(std::memory_order_relaxed) || capacity == 0 || (capacity & (capacity - 1)) != 0)
+			return false;
+
+		recorder.file = std::fopen(path, "w");
+
+		if (!recorder.file)
+			return false;
+
+		// The process's name comes first, so every event after it starts with a comma.
+		std::fputs("{\"traceEvents\":[", recorder.file);
+		std::fputs("\n{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"wumpus\"}}", recorder.file);
+
+		for (size_t index = 0; index < recorder.rings.size(); index++)
+			recorder.rings[index]->reset(capacity);
+
+		recorder.capacity = capacity;
+		recorder.origin = now();
+		recorder.dropped = 0;
+		recorder.stopping = false;
+		recorder.flusher = std::thread(flush, std::ref(recorder));
+		enabled.store(true, std::memory_order_relaxed);
+		return true;
+	}
+
+	void TraceRecorder::stop()
+	{
+		Recorder& recorder = getRecorder();
+
+		if (!enabled.exchange(false))
+			return;
+
+		{
+			std::lock_guard<std::mutex> lock(recorder.mutex);
+			recorder.stopping = true;
+		}
+
+		recorder.wake.notify_one();
+		recorder.flusher.join();
+
+		std::lock_guard<std::mutex> lock(recorder.mutex);
+		drain(recorder);
+
+		for (size_t index = 0; index < recorder.rings.size(); index++)
+			recorder.dropped += recorder.rings[index]->dropped.load(std::memory_order_relaxed);
+
+		std::fprintf(recorder.file, "\n],\n\"displayTimeUnit\":\"ns\",\n\"otherData\":{\"droppedEvents\":\"%llu\"}}\n",
+		             recorder.dropped);
+		std::fclose(recorder.file);
+		recorder.file = NULL;
+	}
+
+	void TraceRecorder::record(char const* name, unsigned long long start, unsigned long long end)
+	{
+		if (!enabled.load(std::memory_order_relaxed))
+			return;
+
+		Ring& ring = getRing();
+		size_t head = ring.head.load(std::memory_order_relaxed);
+		size_t waiting = head - ring.tail.load(std::memory_order_acquire);
+
+		if (waiting > ring.mask)
+		{
+			ring.dropped.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+
+		Event& event = ring.events[head & ring.mask];
+
+		event.name = name;
+		event.start = start;
+		event.end = end;
+		ring.head.store(head + 1, std::memory_order_release);
+
+		// Half full: flush now rather than at the next interval.
+		if (waiting == ring.mask / 2)
+			getRecorder().wake.notify_one();
+	}
+
+	unsigned long long TraceRecorder::getDroppedCount()
+	{
+		Recorder& recorder = getRecorder();
+		std::lock_guard<std::mutex> lock(recorder.mutex);
+		unsigned long long dropped = recorder.dropped;
+
+		// While recording, the rings hold the count so far.
+		if (enabled.load(std::memory_order_relaxed))
+		{
+			for (size_t index = 0; index < recorder.rings.size(); index++)
+				dropped += recorder.rings[index]->dropped.load(std::memory_order_relaxed);
+		}
+
+		return dropped;
+	}
+}}  // namespace fullsail_ai::fundamentals
@@ -0,0 +1,84 @@
+//! \file TraceRecorder.h
+//! \brief Defines the <code>fullsail_ai::fundamentals::TraceRecorder</code> and
+//! <code>fullsail_ai::fundamentals::TraceSpan</code> classes.
+#ifndef _FULLSAIL_AI_FUNDAMENTALS_TRACE_RECORDER_H_
+#define _FULLSAIL_AI_FUNDAMENTALS_TRACE_RECORDER_H_
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include "../platform.h"
+
+namespace fullsail_ai { namespace fundamentals {
+
+	//! \brief Writes timed spans from any number of threads to a Chrome Trace Event file,
+	//! which chrome://tracing and the Perfetto UI open without a network connection.
+	//!
+	//! Each thread records into its own ring buffer, which only it writes and only the
+	//! recorder's flush thread reads, so recording takes no lock. The flush thread drains
+	//! the rings every few milliseconds, or sooner once one is half full, and writes the
+	//! events out. A span that finds its ring full is dropped and counted rather than
+	//! waited for.
+	//!
+	//! \note
+	//!   - Span names must be string literals (they are written after the span ends) that
+	//!     need no escaping in JSON.
+	//!   - Start and stop recording while no traced thread is running; a span that ends
+	//!     after <code>stop()</code> is lost.
+	class DLLEXPORT_CLASS TraceRecorder
+	{
+		DLLEXPORT static std::atomic<bool> enabled;
+
+	public:
+		//! \brief Starts recording to the file at \a path, with rings of \a capacity events
+		//! (a power of two) per thread. Returns false if recording already is, or the file
+		//! cannot be opened.
+		DLLEXPORT static bool start(char const* path, size_t capacity = 1 << 16);
+
+		//! \brief Stops recording, writes what the rings still hold and closes the file.
+		DLLEXPORT static void stop();
+
+		//! \brief Returns true between <code>start()</code> and <code>stop()</code>.
+		static bool isEnabled() { return enabled.load(std::memory_order_relaxed); }
+
+		//! \brief Returns the current time, in nanoseconds, on the clock spans are timed by.
+		static unsigned long long now()
+		{
+			return std::chrono::duration_cast<std::chrono::nanoseconds>(
+			    std::chrono::steady_clock::now().time_since_epoch()).count();
+		}
+
+		//! \brief Records a span named \a name from \a start to \a end on this thread.
+		DLLEXPORT static void record(char const* name, unsigned long long start, unsigned long long end);
+
+		//! \brief Returns the number of spans dropped for want of room since the last
+		//! <code>start()</code>. Complete once <code>stop()</code> returns.
+		DLLEXPORT static unsigned long long getDroppedCount();
+	};
+
+	//! \brief Records the span from its construction to its destruction, if the
+	//! <code>TraceRecorder</code> was recording when it was constructed. Otherwise it
+	//! costs one relaxed load.
+	class TraceSpan
+	{
+		char const* name;
+		unsigned long long start;
+
+		TraceSpan(TraceSpan const&) = delete;
+		TraceSpan& operator=(TraceSpan const&) = delete;
+
+	public:
+		explicit TraceSpan(char const* _name)
+			: name(_name), start(TraceRecorder::isEnabled() ? TraceRecorder::now() : 0)
+		{
+		}
+
+		~TraceSpan()
+		{
+			if (start)
+				TraceRecorder::record(name, start, TraceRecorder::now());
+		}
+	};
+}}  // namespace fullsail_ai::fundamentals
+
+#endif  // _FULLSAIL_AI_FUNDAMENTALS_TRACE_RECORDER_H_
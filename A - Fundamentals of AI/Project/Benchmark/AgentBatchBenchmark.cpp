@@ -0,0 +1,89 @@
+// AgentBatchBenchmark.cpp - one agent at a time versus the batch executor, on many small worlds
+#include <cstdio>
+#include <vector>
+#include "Benchmark.h"
+#include "SyntheticTree.h"
+#include "../WumpusWorld/Agent.h"
+#include "../WumpusWorld/BatchBehavior.h"
+#include "../WumpusWorld/Behaviors.h"
+#include "../WumpusWorld/WorldGenerator.h"
+
+using namespace fullsail_ai::fundamentals;
+using namespace fullsail_ai::benchmark;
+
+namespace {
+
+	unsigned const worldSize = 8;
+
+	// Owns the worlds and agents of one crowd.
+	struct Crowd
+	{
+		std::vector<World*> worlds;
+		std::vector<Agent*> agents;
+
+		Crowd(unsigned count, Behavior& behavior)
+		{
+			WorldGenerator generator(worldSize, worldSize);
+			std::vector<char> cells(generator.getCellCount());
+
+			for (unsigned index = 0; index < count; index++)
+			{
+				generator.generate(index, &cells[0]);
+				worlds.push_back(new World(&cells[0], worldSize, worldSize));
+				agents.push_back(new Agent(*worlds.back(), behavior, ignoreBehavior));
+				agents.back()->enter(worlds.back()->getAgentX(), worlds.back()->getAgentY());
+			}
+		}
+
+		~Crowd()
+		{
+			for (size_t index = 0; index < agents.size(); index++)
+			{
+				agents[index]->exit();
+				delete agents[index];
+				delete worlds[index];
+			}
+		}
+	};
+
+	void agentBatch()
+	{
+		unsigned const agentCount = isQuick() ? 1000 : 10000;
+		unsigned const ticks = 20;
+		Behavior* behavior = createBasicBehavior();
+		CompiledBehavior compiled(behavior);
+		BatchBehavior batch(compiled);
+		Crowd sequential(agentCount, *behavior), batched(agentCount, *behavior);
+		char name[64];
+
+		Timer timer;
+
+		for (unsigned tick = 0; tick < ticks; tick++)
+			Agent::updateBatch(&sequential.agents[0], agentCount);
+
+		std::snprintf(name, sizeof(name), "agents/sequential/%u", agentCount);
+		report(name, (unsigned long long)agentCount * ticks, timer.getSeconds());
+		timer.restart();
+
+		for (unsigned tick = 0; tick < ticks; tick++)
+			Agent::updateBatch(&batched.agents[0], agentCount, &batch);
+
+		std::snprintf(name, sizeof(name), "agents/batched/%u", agentCount);
+		report(name, (unsigned long long)agentCount * ticks, timer.getSeconds());
+
+		// Both crowds must have ended up in the same place.
+		for (unsigned index = 0; index < agentCount; index++)
+		{
+			Knowledge& expected = sequential.agents[index]->getKnowledge();
+			Knowledge& actual = batched.agents[index]->getKnowledge();
+
+			if (expected.x != actual.x || expected.y != actual.y || expected.hasGold != actual.hasGold
+			    || expected.hasArrow != actual.hasArrow || expected.modelWorld != actual.modelWorld)
+				fail("Batched agent %u diverged from its sequential twin!", index);
+		}
+
+		deleteTree(behavior);
+	}
+}
+
+FULLSAIL_BENCHMARK(agentBatch);
@@ -0,0 +1,176 @@
+// AllocationBenchmark.cpp - counts heap allocations, to check what is meant to run without any
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include "Benchmark.h"
+#include "SyntheticTree.h"
+#include "../QueueList/QueueList.h"
+
+using namespace fullsail_ai::fundamentals;
+using namespace fullsail_ai::benchmark;
+
+namespace {
+
+	std::atomic<unsigned long long> allocationCount(0);
+
+	unsigned long long getAllocationCount()
+	{
+		return allocationCount.load(std::memory_order_relaxed);
+	}
+
+	void* countedAllocate(std::size_t size)
+	{
+		allocationCount.fetch_add(1, std::memory_order_relaxed);
+		return std::malloc(size ? size : 1);
+	}
+}
+
+// Replaces the global allocation functions of the whole benchmark binary, and of the shared
+// library on platforms that resolve it to them (not a Windows DLL, which keeps its own).
+// Every form is replaced, so that each allocation is freed by its own kind.
+void* operator new(std::size_t size)
+{
+	if (void* pointer = countedAllocate(size))
+		return pointer;
+
+	throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+	return ::operator new(size);
+}
+
+void* operator new(std::size_t size, std::nothrow_t const&) noexcept
+{
+	return countedAllocate(size);
+}
+
+void* operator new[](std::size_t size, std::nothrow_t const&) noexcept
+{
+	return countedAllocate(size);
+}
+
+void operator delete(void* pointer) noexcept
+{
+	std::free(pointer);
+}
+
+void operator delete[](void* pointer) noexcept
+{
+	std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept
+{
+	std::free(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t) noexcept
+{
+	std::free(pointer);
+}
+
+void operator delete(void* pointer, std::nothrow_t const&) noexcept
+{
+	std::free(pointer);
+}
+
+void operator delete[](void* pointer, std::nothrow_t const&) noexcept
+{
+	std::free(pointer);
+}
+
+namespace {
+
+	unsigned visitCount;
+
+	void countVisit(Behavior const*)
+	{
+		++visitCount;
+	}
+
+	// Throws when built from zero, so that an enqueue can fail partway.
+	struct Fragile
+	{
+		unsigned value;
+
+		explicit Fragile(unsigned _value) : value(_value)
+		{
+			if (!_value)
+				throw 0;
+		}
+	};
+
+	// Once a thread has traversed a tree, traversing it again allocates nothing: the
+	// queue of a breadth-first traversal is kept per thread.
+	void breadthFirstAllocations()
+	{
+		unsigned long long before = getAllocationCount();
+		void* probe = ::operator new(1);
+		::operator delete(probe);
+
+		if (getAllocationCount() == before)
+			fail("The counting operator new is not in use!");
+
+		Behavior* root = buildBalancedTree(5, 10, 1);
+
+		visitCount = 0;
+		root->breadthFirstTraverse(countVisit);
+		unsigned nodes = visitCount;
+
+		if (nodes < 100000)
+			fail("The allocation tree has %u nodes, not 100000!", nodes);
+
+		visitCount = 0;
+		before = getAllocationCount();
+		Timer timer;
+		root->breadthFirstTraverse(countVisit);
+		double seconds = timer.getSeconds();
+		unsigned long long allocations = getAllocationCount() - before;
+
+		if (visitCount != nodes)
+			fail("The second breadth-first traversal visited %u of %u nodes!", visitCount, nodes);
+
+		if (allocations != 0)
+			fail("The second breadth-first traversal allocated %llu times!", allocations);
+
+		report("allocations/breadth-first/warm", nodes, seconds);
+		deleteTree(root);
+	}
+
+	// A reserved QueueList allocates nothing to fill up to the reservation, even when an
+	// element throws on the way and its node is handed back.
+	void reservedQueueAllocations()
+	{
+		unsigned const size = 1000;
+		QueueList<Fragile> queue;
+		queue.reserve(size);
+		unsigned long long before = getAllocationCount();
+
+		try
+		{
+			queue.emplace(0u);
+			fail("QueueList::emplace swallowed an exception!");
+		}
+		catch (int)
+		{
+		}
+
+		for (unsigned index = 1; index <= size; ++index)
+			queue.emplace(index);
+
+		unsigned long long allocations = getAllocationCount() - before;
+
+		if (allocations != 0)
+			fail("Filling a reserved QueueList allocated %llu times!", allocations);
+	}
+
+	void allocations()
+	{
+		reservedQueueAllocations();
+		breadthFirstAllocations();
+	}
+}
+
+FULLSAIL_BENCHMARK(allocations);
@@ -0,0 +1,127 @@
+// ArenaBenchmark.cpp - building and tearing down trees with new/delete versus a BehaviorArena
+#include <cstdio>
+#include <vector>
+#include "Benchmark.h"
+#include "SyntheticTree.h"
+#include "../BehaviorTree/BehaviorArena.h"
+
+using namespace fullsail_ai::fundamentals;
+using namespace fullsail_ai::benchmark;
+
+namespace {
+
+	unsigned getLiveCount()
+	{
+		return Behavior::getCreatedCount() - Behavior::getDestroyedCount();
+	}
+
+	// Aborts unless the arena's tree runs and traverses like the heap one, and unless
+	// tearing either down destroys every node it created.
+	void verify(Behavior* (*buildHeap)(unsigned), Behavior* (*buildArena)(unsigned, BehaviorArena&), unsigned size,
+	            BehaviorArena& arena)
+	{
+		unsigned live = getLiveCount();
+		Behavior* root = buildHeap(size);
+		unsigned nodes = getLiveCount() - live;
+		std::vector<char const*> expected;
+		bool expectedResult = root->run(recordName, NULL);
+
+		root->postOrderTraverse(recordName);
+		expected.swap(recordedNames);
+		deleteTree(root);
+		root = buildArena(size, arena);
+
+		if (arena.getNodeCount() != nodes || getLiveCount() - live != nodes)
+			fail("The arena built %u nodes instead of %u!", getLiveCount() - live, nodes);
+
+		bool result = root->run(recordName, NULL);
+		root->postOrderTraverse(recordName);
+
+		if (result != expectedResult || recordedNames != expected)
+			fail("The tree built in the arena differs from the one built with new!");
+
+		recordedNames.clear();
+		arena.clear();
+
+		if (getLiveCount() != live || arena.getNodeCount() != 0)
+			fail("Clearing the arena left %u behaviors alive!", getLiveCount() - live);
+	}
+
+	unsigned balancedDepth;
+
+	Behavior* buildBalancedHeap(unsigned fanOut)
+	{
+		return buildBalancedTree(balancedDepth, fanOut, 1);
+	}
+
+	Behavior* buildBalancedArena(unsigned fanOut, BehaviorArena& arena)
+	{
+		return buildBalancedTree(balancedDepth, fanOut, 1, arena);
+	}
+
+	Behavior* buildChainHeap(unsigned depth)
+	{
+		return buildChainTree(depth);
+	}
+
+	Behavior* buildChainArena(unsigned depth, BehaviorArena& arena)
+	{
+		return buildChainTree(depth, arena);
+	}
+
+	void measure(char const* shape, Behavior* (*buildHeap)(unsigned), Behavior* (*buildArena)(unsigned, BehaviorArena&), unsigned size)
+	{
+		unsigned const repeats = isQuick() ? 1 : 3;
+		unsigned live = getLiveCount();
+		double heapBuild = 0, heapTeardown = 0, arenaBuild = 0, arenaTeardown = 0;
+		unsigned long long nodes = 0;
+		size_t bytes = 0;
+		char name[64];
+
+		// Clearing keeps the arena's blocks, so after verify() every build reuses them, the
+		// way new reuses what deleteTree freed.
+		BehaviorArena arena;
+		verify(buildHeap, buildArena, size, arena);
+
+		for (unsigned repeat = 0; repeat < repeats; repeat++)
+		{
+			Timer timer;
+			Behavior* root = buildHeap(size);
+			heapBuild += timer.getSeconds();
+			nodes += getLiveCount() - live;
+
+			timer.restart();
+			deleteTree(root);
+			heapTeardown += timer.getSeconds();
+
+			timer.restart();
+			keep(buildArena(size, arena));
+			arenaBuild += timer.getSeconds();
+			bytes = arena.getBytesAllocated();
+
+			timer.restart();
+			arena.clear();
+			arenaTeardown += timer.getSeconds();
+		}
+
+		std::printf("  %s: %llu nodes, %zu bytes of arena blocks\n", shape, nodes / repeats, bytes);
+		std::snprintf(name, sizeof(name), "arena/%s/build/new", shape);
+		report(name, nodes, heapBuild);
+		std::snprintf(name, sizeof(name), "arena/%s/build/arena", shape);
+		report(name, nodes, arenaBuild);
+		std::snprintf(name, sizeof(name), "arena/%s/teardown/deleteTree", shape);
+		report(name, nodes, heapTeardown);
+		std::snprintf(name, sizeof(name), "arena/%s/teardown/arena", shape);
+		report(name, nodes, arenaTeardown);
+	}
+
+	void arenaTeardown()
+	{
+		// About a million nodes each (a third of that for a quick pass).
+		balancedDepth = isQuick() ? 9 : 10;
+		measure(isQuick() ? "balanced/d9-f4" : "balanced/d10-f4", buildBalancedHeap, buildBalancedArena, 4);
+		measure("chain", buildChainHeap, buildChainArena, isQuick() ? 200000 : 500000);
+	}
+}
+
+FULLSAIL_BENCHMARK(arenaTeardown);
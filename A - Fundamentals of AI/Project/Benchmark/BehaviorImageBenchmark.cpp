@@ -0,0 +1,318 @@
+// BehaviorImageBenchmark.cpp - trees built from text versus loaded from binary images
+#include <cstdio>
+#include <filesystem>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "Benchmark.h"
+#include "SyntheticTree.h"
+#include "../WumpusWorld/Agent.h"
+#include "../WumpusWorld/BehaviorImage.h"
+#include "../WumpusWorld/BehaviorRegistry.h"
+#include "../WumpusWorld/Behaviors.h"
+#include "../WumpusWorld/WorldGenerator.h"
+
+using namespace fullsail_ai::fundamentals;
+using namespace fullsail_ai::benchmark;
+
+namespace {
+
+	// The same generator as buildBalancedTree(), writing text instead of nodes.
+	void writeLevel(std::string& text, unsigned depth, unsigned fanOut, bool selector, unsigned& state, unsigned indent)
+	{
+		text.append(indent, '\t');
+
+		if (depth == 0)
+		{
+			state = state * 1664525u + 1013904223u;
+			text += ((state >> 16) & 1) ? "TestBehavior \"Leaf\" true\n" : "TestBehavior \"Leaf\" false\n";
+			return;
+		}
+
+		text += selector ? "Selector \"Selector\"\n" : "Sequence \"Sequence\"\n";
+
+		for (unsigned index = 0; index < fanOut; ++index)
+			writeLevel(text, depth - 1, fanOut, !selector, state, indent + 1);
+	}
+
+	std::string writeBalancedTree(unsigned depth, unsigned fanOut, unsigned seed)
+	{
+		std::string text;
+		writeLevel(text, depth, fanOut, true, seed, 0);
+		return text;
+	}
+
+	// Runs the tree and returns the pre-order index of each node it reported.
+	std::vector<size_t> runIndexed(Behavior* root, bool& result)
+	{
+		std::map<Behavior const*, size_t> order;
+		std::vector<size_t> indices;
+
+		recordedBehaviors.clear();
+		root->preOrderTraverse(recordBehavior);
+
+		for (size_t index = 0; index < recordedBehaviors.size(); index++)
+			order[recordedBehaviors[index]] = index;
+
+		recordedBehaviors.clear();
+		result = root->run(recordBehavior, NULL);
+
+		for (size_t index = 0; index < recordedBehaviors.size(); index++)
+			indices.push_back(order[recordedBehaviors[index]]);
+
+		return indices;
+	}
+
+	std::vector<size_t> runIndexed(BehaviorImage& image, bool& result)
+	{
+		std::map<Behavior const*, size_t> order;
+		std::vector<size_t> indices;
+
+		for (size_t index = 0; index < image.getNodeCount(); index++)
+			order[image.getNode(index)] = index;
+
+		recordedBehaviors.clear();
+		result = image.run(recordBehavior, NULL);
+
+		for (size_t index = 0; index < recordedBehaviors.size(); index++)
+			indices.push_back(order[recordedBehaviors[index]]);
+
+		return indices;
+	}
+
+	// Aborts unless the image, run in place and instantiated, behaves like \a root.
+	void verify(Behavior* root, std::vector<char> const& data)
+	{
+		BehaviorImage image(&data[0], data.size());
+		Behavior* instance = image.instantiate();
+		bool expected, actual;
+		std::vector<size_t> expectedIndices = runIndexed(root, expected);
+
+		if (runIndexed(image, actual) != expectedIndices || actual != expected)
+			fail("BehaviorImage::run diverged from the pointer tree!");
+
+		if (runIndexed(instance, actual) != expectedIndices || actual != expected)
+			fail("BehaviorImage::instantiate built a different tree!");
+
+		deleteTree(instance);
+	}
+
+	void expectRejected(char const* what, char const* text)
+	{
+		try
+		{
+			BehaviorImage::compile(text);
+		}
+		catch (std::runtime_error const&)
+		{
+			return;
+		}
+
+		fail("BehaviorImage::compile accepted %s!", what);
+	}
+
+	void expectRejected(char const* what, std::vector<char> const& data)
+	{
+		try
+		{
+			BehaviorImage image(data.empty() ? NULL : &data[0], data.size());
+		}
+		catch (std::runtime_error const&)
+		{
+			return;
+		}
+
+		fail("BehaviorImage accepted %s!", what);
+	}
+
+	void checkMalformed()
+	{
+		std::vector<char> data = BehaviorImage::compile(basicBehaviorText);
+		std::vector<char> broken;
+
+		expectRejected("an empty tree", "# nothing\n");
+		expectRejected("an unknown type", "Sequence \"Root\"\n\tJump \"Jump\"\n");
+		expectRejected("a missing parameter", "ExploreDirection \"Explore\"\n");
+		expectRejected("an unknown parameter", "ExploreDirection \"Explore\" NORTH\n");
+		expectRejected("a stray parameter", "PickUpGold \"Pick Up\" UP\n");
+		expectRejected("an unterminated description", "Sequence \"Root\n");
+		expectRejected("a second root", "Sequence \"One\"\nSequence \"Two\"\n");
+		expectRejected("a leaf with children", "PickUpGold \"Pick Up\"\n\tPickUpGold \"Again\"\n");
+
+		expectRejected("an empty image", broken);
+		broken.assign(data.begin(), data.begin() + data.size() / 2);
+		expectRejected("a truncated image", broken);
+		broken = data;
+		broken[0] = 'X';
+		expectRejected("a bad magic number", broken);
+		broken = data;
+		broken.back() = 'X';
+		expectRejected("an unterminated string table", broken);
+		broken = data;
+		BehaviorImage::Header const* header = reinterpret_cast<BehaviorImage::Header const*>(&broken[0]);
+		reinterpret_cast<BehaviorImage::Node*>(&broken[sizeof(BehaviorImage::Header) + 4 * header->typeCount])[1].parent = 5;
+		expectRejected("a node whose parent follows it", broken);
+	}
+
+	Behavior* constructFailing(void*, char const*, unsigned)
+	{
+		throw std::runtime_error("cannot construct");
+	}
+
+	// A node that fails to construct takes the nodes built before it down with the image;
+	// the suite's leak check counts any left behind.
+	void checkFailedConstruction()
+	{
+		BehaviorRegistry registry = BehaviorRegistry::getDefault();
+		BehaviorRegistry::NodeType failing = { "Failing", CompiledBehavior::LEAF, NULL, 0, sizeof(TestBehavior),
+		                                       alignof(TestBehavior), constructFailing,
+		                                       BehaviorRegistry::destroy<TestBehavior> };
+
+		registry.add(failing);
+
+		std::vector<char> data = BehaviorImage::compile("Sequence \"Root\"\n\tPickUpGold \"Pick Up\"\n\tFailing \"Fail\"\n",
+		                                                registry);
+
+		try
+		{
+			BehaviorImage image(&data[0], data.size(), registry);
+		}
+		catch (std::runtime_error const&)
+		{
+			return;
+		}
+
+		fail("BehaviorImage loaded a node that failed to construct!");
+	}
+
+	// Plays the same episodes with createBasicBehavior() and with its image.
+	void checkAgents()
+	{
+		unsigned const worldSize = 8, tickLimit = 1000, episodes = isQuick() ? 50 : 200;
+		std::vector<char> data = BehaviorImage::compile(basicBehaviorText);
+		BehaviorImage image(&data[0], data.size());
+		Behavior* behavior = createBasicBehavior();
+		WorldGenerator generator(worldSize, worldSize);
+		std::vector<char> cells(generator.getCellCount());
+
+		for (unsigned seed = 0; seed < episodes; seed++)
+		{
+			unsigned ticks[2] = { 0, 0 }, x[2], y[2];
+			bool alive[2], hasGold[2];
+
+			for (int pass = 0; pass < 2; pass++)
+			{
+				generator.generate(seed, &cells[0]);
+
+				World world(&cells[0], worldSize, worldSize);
+				Agent agent(world, pass ? (Behavior&)image : *behavior, ignoreBehavior);
+
+				agent.enter(world.getAgentX(), world.getAgentY());
+
+				while (world.isAgentAlive() && world.doesAgentHaveArrow() && ticks[pass] < tickLimit)
+				{
+					agent.update();
+					ticks[pass]++;
+				}
+
+				x[pass] = agent.getKnowledge().x;
+				y[pass] = agent.getKnowledge().y;
+				alive[pass] = world.isAgentAlive();
+				hasGold[pass] = agent.getKnowledge().hasGold;
+				agent.exit();
+			}
+
+			if (ticks[0] != ticks[1] || x[0] != x[1] || y[0] != y[1] || alive[0] != alive[1] || hasGold[0] != hasGold[1])
+				fail("The agent running the basic behavior's image played episode %u differently!", seed);
+		}
+
+		deleteTree(behavior);
+	}
+
+	void behaviorImage()
+	{
+		unsigned const archetypes = isQuick() ? 50 : 400, depth = 4, fanOut = 4;
+		std::filesystem::path directory = std::filesystem::temp_directory_path() / "fullsail_behavior_images";
+		std::vector<std::string> texts, paths;
+		unsigned long long nodes = 0;
+		size_t imageBytes = 0;
+		char name[64];
+
+		checkMalformed();
+		checkFailedConstruction();
+		checkAgents();
+
+		std::filesystem::create_directories(directory);
+
+		for (unsigned index = 0; index < archetypes; index++)
+		{
+			Behavior* root = buildBalancedTree(depth, fanOut, index);
+			std::vector<char> data;
+
+			texts.push_back(writeBalancedTree(depth, fanOut, index));
+			data = BehaviorImage::compile(texts.back().c_str());
+			verify(root, data);
+			deleteTree(root);
+
+			paths.push_back((directory / ("archetype" + std::to_string(index) + ".btree")).string());
+			std::FILE* file = std::fopen(paths.back().c_str(), "wb");
+
+			if (!file || std::fwrite(&data[0], 1, data.size(), file) != data.size() || std::fclose(file) != 0)
+				fail("Could not write %s", paths.back().c_str());
+
+			imageBytes += data.size();
+		}
+
+		// Loading: parsing text into separately allocated nodes, the way a tree is built
+		// by hand, versus mapping compiled images and constructing their nodes in one block.
+		Timer timer;
+
+		for (unsigned index = 0; index < archetypes; index++)
+		{
+			std::vector<char> data = BehaviorImage::compile(texts[index].c_str());
+			deleteTree(BehaviorImage(&data[0], data.size()).instantiate());
+		}
+
+		double textSeconds = timer.getSeconds();
+		timer.restart();
+
+		for (unsigned index = 0; index < archetypes; index++)
+		{
+			BehaviorImage image(paths[index].c_str());
+			nodes += image.getNodeCount();
+		}
+
+		double mappedSeconds = timer.getSeconds();
+
+		std::printf("  %u archetypes of %llu nodes, %zu bytes of images\n", archetypes, nodes / archetypes, imageBytes);
+		report("image/load/text+instantiate", archetypes, textSeconds);
+		report("image/load/mapped", archetypes, mappedSeconds);
+
+		// Ticking: the image's flat walk versus the pointer tree it was built from.
+		unsigned const ticks = isQuick() ? 2000 : 20000;
+		std::vector<char> data = BehaviorImage::compile(texts[0].c_str());
+		BehaviorImage image(&data[0], data.size());
+		Behavior* root = image.instantiate();
+
+		timer.restart();
+
+		for (unsigned tick = 0; tick < ticks; tick++)
+			keep(root->run(ignoreBehavior, NULL));
+
+		std::snprintf(name, sizeof(name), "image/tick/pointer/d%u-f%u", depth, fanOut);
+		report(name, ticks, timer.getSeconds());
+		timer.restart();
+
+		for (unsigned tick = 0; tick < ticks; tick++)
+			keep(image.run(ignoreBehavior, NULL));
+
+		std::snprintf(name, sizeof(name), "image/tick/image/d%u-f%u", depth, fanOut);
+		report(name, ticks, timer.getSeconds());
+
+		deleteTree(root);
+		std::filesystem::remove_all(directory);
+	}
+}
+
+FULLSAIL_BENCHMARK(behaviorImage);
@@ -0,0 +1,334 @@
+// BehaviorLogBenchmark.cpp - what the behavior log writes, and what it saves over printing each update
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <map>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Benchmark.h"
+#include "SyntheticTree.h"
+#include "../WumpusWorld/Agent.h"
+#include "../WumpusWorld/BehaviorLog.h"
+#include "../WumpusWorld/Behaviors.h"
+#include "../WumpusWorld/Simulation.h"
+#include "../WumpusWorld/WorldGenerator.h"
+
+using namespace fullsail_ai::fundamentals;
+using namespace fullsail_ai::benchmark;
+
+namespace {
+
+	unsigned const worldSize = 8, tickLimit = 1000;
+
+	// What the game printed straight to the console before the log: every event on its
+	// own line, each flushed.
+	std::ofstream* printStream = NULL;
+	unsigned printAgent = 0, printTick = 0;
+
+	void printNode(Behavior const* node)
+	{
+		BehaviorLog::Event event = { node, printAgent, printTick, 0, 0, BehaviorLog::NODE, Behavior::SUCCESS };
+		std::string text;
+
+		BehaviorLog::formatEvent(event, text);
+		text.resize(text.size() - 1);
+		*printStream << text << std::endl;
+	}
+
+	void printStatus(World const& world)
+	{
+		BehaviorLog::Event event = { NULL, printAgent, printTick, (std::uint16_t)world.getAgentX(),
+		                             (std::uint16_t)world.getAgentY(), BehaviorLog::STATUS, 0 };
+		std::string text;
+
+		event.result = (world.doesAgentHaveArrow() ? BehaviorLog::HAS_ARROW : 0) |
+		               (world.isGoldRetrieved() ? BehaviorLog::HAS_GOLD : 0) |
+		               (world.isAgentAlive() ? BehaviorLog::AGENT_ALIVE : 0) |
+		               (world.isWumpusAlive() ? BehaviorLog::WUMPUS_ALIVE : 0);
+		BehaviorLog::formatEvent(event, text);
+		text.resize(text.size() - 1);
+		*printStream << text << std::endl;
+	}
+
+	// Plays the episodes seeded \a first on, logging every update to \a log, or printing
+	// it to printStream without one. Returns the number of updates.
+	unsigned long long playEpisodes(Behavior& behavior, unsigned first, unsigned episodes, BehaviorLog* log)
+	{
+		WorldGenerator generator(worldSize, worldSize);
+		std::vector<char> cells(generator.getCellCount());
+		unsigned long long ticks = 0;
+
+		for (unsigned seed = first; seed < first + episodes; seed++)
+		{
+			generator.generate(seed, &cells[0]);
+
+			World world(&cells[0], worldSize, worldSize);
+			Agent agent(world, behavior, log ? BehaviorLog::logNode : printNode);
+			unsigned tick = 0;
+
+			agent.enter(world.getAgentX(), world.getAgentY());
+
+			for (; world.isAgentAlive() && world.doesAgentHaveArrow() && tick < tickLimit; ticks++)
+			{
+				if (log)
+				{
+					log->beginTick(seed, ++tick);
+					agent.update();
+					log->logStatus(world);
+				}
+				else
+				{
+					printAgent = seed;
+					printTick = ++tick;
+					*printStream << seed << '\t' << tick << "\ttick" << std::endl;
+					agent.update();
+					printStatus(world);
+				}
+			}
+
+			agent.exit();
+		}
+
+		return ticks;
+	}
+
+	std::string readFile(std::string const& path)
+	{
+		std::ifstream file(path.c_str(), std::ios::binary);
+		std::ostringstream contents;
+
+		contents << file.rdbuf();
+		return contents.str();
+	}
+
+	// The log's text is exactly what printing every event as it happened wrote.
+	void verifyText(std::string const& printPath, std::string const& logPath)
+	{
+		unsigned const episodes = isQuick() ? 20 : 100;
+		Behavior* behavior = createBasicBehavior();
+
+		{
+			std::ofstream stream(printPath.c_str(), std::ios::binary);
+
+			printStream = &stream;
+			playEpisodes(*behavior, 0, episodes, NULL);
+			printStream = NULL;
+		}
+
+		std::FILE* file = std::fopen(logPath.c_str(), "wb");
+
+		{
+			// A small queue, so that the agent often waits on the writer.
+			BehaviorLog log(file, BehaviorLog::TEXT, BehaviorLog::formatEvent, 64);
+			playEpisodes(*behavior, 0, episodes, &log);
+		}
+
+		std::fclose(file);
+		deleteTree(behavior);
+
+		if (readFile(printPath) != readFile(logPath))
+			fail("The log's text differs from printing each event!");
+	}
+
+	// Several threads log into one binary file; only the sampled ticks of the filtered
+	// agents are in it, each node named before it is used.
+	void verifyBinary(std::string const& path)
+	{
+		unsigned const threads = 4, episodes = isQuick() ? 25 : 100, period = 3;
+		std::vector<unsigned> agents;
+		std::vector<std::thread> workers;
+		std::vector<Behavior*> behaviors;
+		std::FILE* file = std::fopen(path.c_str(), "wb");
+
+		for (unsigned agent = 1; agent < threads * episodes; agent += 7)
+			agents.push_back(agent);
+
+		// Built up front and deleted after, so that no tree takes the place of another.
+		for (unsigned thread = 0; thread < threads; thread++)
+			behaviors.push_back(createBasicBehavior());
+
+		{
+			BehaviorLog log(file, BehaviorLog::BINARY);
+
+			log.setSampling(period);
+			log.setAgentFilter(agents);
+
+			for (unsigned thread = 0; thread < threads; thread++)
+			{
+				workers.push_back(std::thread([&log, &behaviors, thread, episodes]()
+				{
+					playEpisodes(*behaviors[thread], thread * episodes, episodes, &log);
+				}));
+			}
+
+			for (unsigned thread = 0; thread < threads; thread++)
+				workers[thread].join();
+		}
+
+		std::fclose(file);
+
+		std::string contents = readFile(path);
+		std::map<std::uint32_t, std::string> names;
+		std::map<unsigned, unsigned> ticks, statuses; // By agent
+		unsigned long long nodes = 0;
+		std::uint32_t version = 0;
+
+		if (contents.size() < 8 || contents.compare(0, 4, "BLOG") != 0)
+			fail("The binary log does not start with its header!");
+
+		std::memcpy(&version, &contents[4], sizeof(version));
+
+		if (version != 1)
+			fail("The binary log has the wrong version!");
+
+		for (size_t offset = 8; offset < contents.size(); )
+		{
+			BehaviorLog::BinaryRecord record;
+
+			if (contents.size() - offset < sizeof(record))
+				fail("The binary log ends inside a record!");
+
+			std::memcpy(&record, &contents[offset], sizeof(record));
+			offset += sizeof(record);
+
+			if (record.tick % period != 0 || record.agent % 7 != 1)
+				fail("The binary log holds a tick it should have left out!");
+
+			switch (record.kind)
+			{
+			case BehaviorLog::NAME:
+				names[record.data] = contents.substr(offset, record.length);
+				offset += record.length;
+				break;
+
+			case BehaviorLog::NODE:
+				if (names.find(record.data) == names.end())
+					fail("The binary log uses a node before naming it!");
+
+				nodes++;
+				break;
+
+			case BehaviorLog::TICK:
+				ticks[record.agent]++;
+				break;
+
+			case BehaviorLog::STATUS:
+				statuses[record.agent]++;
+				break;
+			}
+		}
+
+		// Every sampled update of a filtered agent, and the world after it.
+		std::map<unsigned, unsigned> expected;
+		Simulation simulation(worldSize, tickLimit);
+
+		for (size_t index = 0; index < agents.size(); index++)
+		{
+			unsigned updates = simulation.runEpisode(agents[index], *behaviors[0]).ticks;
+
+			if (updates >= period)
+				expected[agents[index]] = updates / period;
+		}
+
+		if (ticks != expected || statuses != expected)
+			fail("The binary log is missing updates or the world after them!");
+
+		for (unsigned thread = 0; thread < threads; thread++)
+			deleteTree(behaviors[thread]);
+
+		std::printf("  %u threads, %u agents, %llu node events, %u names\n", threads, (unsigned)ticks.size(),
+		            nodes, (unsigned)names.size());
+	}
+
+	// A thread whose log was destroyed logs nothing more, not even to a log built in the
+	// old one's place, until it begins another tick.
+	void verifyDestroyed(std::string const& path)
+	{
+		std::FILE* file = std::fopen(path.c_str(), "wb");
+		Behavior* behavior = new TestBehavior("Leaf", true);
+		WorldGenerator generator(worldSize, worldSize);
+		std::vector<char> cells(generator.getCellCount());
+		std::promise<void> begun, destroyed;
+		unsigned long long written = 0;
+
+		generator.generate(0, &cells[0]);
+		World world(&cells[0], worldSize, worldSize);
+
+		BehaviorLog* log = new BehaviorLog(file, BehaviorLog::TEXT);
+		std::thread worker([&]()
+		{
+			log->beginTick(0, 0);
+			begun.set_value();
+			destroyed.get_future().wait();
+			BehaviorLog::logNode(behavior);
+			log->logStatus(world);
+		});
+
+		begun.get_future().wait();
+		delete log;
+		log = new BehaviorLog(file, BehaviorLog::TEXT);
+		destroyed.set_value();
+		worker.join();
+		log->flush();
+		written = log->getWrittenCount();
+		delete log;
+
+		std::fclose(file);
+		delete behavior;
+
+		if (written != 0)
+			fail("A thread logged through a log destroyed since its last tick!");
+	}
+
+	void behaviorLog()
+	{
+		unsigned const episodes = isQuick() ? 100 : 1000;
+		std::string printPath = (std::filesystem::temp_directory_path() / "fullsail_print.txt").string();
+		std::string logPath = (std::filesystem::temp_directory_path() / "fullsail_log.txt").string();
+		Behavior* behavior = createBasicBehavior();
+
+		verifyText(printPath, logPath);
+		verifyBinary(logPath);
+		verifyDestroyed(logPath);
+
+		{
+			std::ofstream stream(printPath.c_str(), std::ios::binary);
+
+			printStream = &stream;
+			Timer timer;
+			unsigned long long ticks = playEpisodes(*behavior, 0, episodes, NULL);
+			report("log/agent-update/print-endl", ticks, timer.getSeconds());
+			printStream = NULL;
+		}
+
+		BehaviorLog::Format const formats[] = { BehaviorLog::TEXT, BehaviorLog::BINARY };
+		char const* const names[] = { "log/agent-update/async-text", "log/agent-update/async-binary" };
+
+		for (unsigned format = 0; format < 2; format++)
+		{
+			std::FILE* file = std::fopen(logPath.c_str(), "wb");
+			Timer timer;
+			unsigned long long ticks;
+
+			{
+				// Until everything is written, to charge the writer's work as well.
+				BehaviorLog log(file, formats[format]);
+				ticks = playEpisodes(*behavior, 0, episodes, &log);
+			}
+
+			report(names[format], ticks, timer.getSeconds());
+			std::fclose(file);
+		}
+
+		deleteTree(behavior);
+		std::filesystem::remove(printPath);
+		std::filesystem::remove(logPath);
+	}
+}
+
+FULLSAIL_BENCHMARK(behaviorLog);
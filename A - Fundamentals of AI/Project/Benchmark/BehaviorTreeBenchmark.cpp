@@ -0,0 +1,406 @@
+// BehaviorTreeBenchmark.cpp - ticks of pointer behavior trees versus their compiled and resumed forms
+#include <cstdio>
+#include <vector>
+#include "Benchmark.h"
+#include "SyntheticTree.h"
+#include "../WumpusWorld/Behaviors.h"
+#include "../WumpusWorld/CompiledBehavior.h"
+
+using namespace fullsail_ai::fundamentals;
+using namespace fullsail_ai::benchmark;
+
+namespace {
+
+	void throwingVisitor(Behavior const*)
+	{
+		throw 0;
+	}
+
+	// A sequence whose result is inverted, which only its own run() knows.
+	class InvertedSequence : public Sequence
+	{
+	public:
+		InvertedSequence(char const* _description) : Sequence(_description) { }
+
+		bool run(void (*dataFunction)(Behavior const*), void* context)
+		{
+			return !Sequence::run(dataFunction, context);
+		}
+	};
+
+	// Aborts unless the compiled tree reports the same result and callbacks as the original.
+	void verify(Behavior* root, CompiledBehavior const& compiled)
+	{
+		recordedBehaviors.clear();
+		bool expected = root->run(recordBehavior, NULL);
+		std::vector<Behavior const*> expectedVisits(recordedBehaviors);
+
+		recordedBehaviors.clear();
+		bool actual = compiled.run(recordBehavior, NULL);
+
+		if (actual != expected || recordedBehaviors != expectedVisits)
+			fail("CompiledBehavior diverged from the pointer tree!");
+
+		std::vector<Behavior const*> visitorVisits;
+		int none = 0;
+		actual = compiled.run(none, [&](Behavior const* behavior) { visitorVisits.push_back(behavior); });
+
+		if (actual != expected || visitorVisits != expectedVisits)
+			fail("The templated CompiledBehavior::run diverged from the pointer tree!");
+
+		// Nothing in these trees runs for more than a tick, so resuming is running.
+		RunningState state;
+		recordedBehaviors.clear();
+		Behavior::Status status = Composite::resume(root, state, recordBehavior, NULL);
+
+		if (status != (expected ? Behavior::SUCCESS : Behavior::FAILURE) || state.isRunning() || recordedBehaviors != expectedVisits)
+			fail("Composite::resume diverged from Behavior::run!");
+	}
+
+	// Aborts unless each templated traversal recordedBehaviors the same nodes as its exported twin.
+	void verifyTraversals(Behavior const* root)
+	{
+		std::vector<Behavior const*> lambdaVisits;
+		auto record = [&](Behavior const* behavior) { lambdaVisits.push_back(behavior); };
+
+		recordedBehaviors.clear();
+		root->breadthFirstTraverse(recordBehavior);
+		root->breadthFirstTraverse(record);
+		bool same = (recordedBehaviors == lambdaVisits);
+
+		recordedBehaviors.clear();
+		lambdaVisits.clear();
+		root->preOrderTraverse(recordBehavior);
+		root->preOrderTraverse(record);
+		same = same && (recordedBehaviors == lambdaVisits);
+
+		recordedBehaviors.clear();
+		lambdaVisits.clear();
+		root->postOrderTraverse(recordBehavior);
+		root->postOrderTraverse(record);
+		same = same && (recordedBehaviors == lambdaVisits);
+
+		if (!same)
+			fail("A templated traversal diverged from the exported one!");
+
+		// A visitor that throws must not leave the thread's queue behind it in use or full,
+		// nor its stack of pending nodes behind it.
+		recordedBehaviors.clear();
+		root->breadthFirstTraverse(recordBehavior);
+		std::vector<Behavior const*> expectedVisits(recordedBehaviors);
+
+		try
+		{
+			root->breadthFirstTraverse(throwingVisitor);
+		}
+		catch (int)
+		{
+		}
+
+		try
+		{
+			root->breadthFirstTraverse([](Behavior const*) { throw 0; });
+		}
+		catch (int)
+		{
+		}
+
+		recordedBehaviors.clear();
+		lambdaVisits.clear();
+		root->breadthFirstTraverse(recordBehavior);
+		root->breadthFirstTraverse(record);
+
+		if (recordedBehaviors != expectedVisits || lambdaVisits != expectedVisits)
+			fail("A breadth-first traversal that threw broke the next one!");
+
+		recordedBehaviors.clear();
+		root->preOrderTraverse(recordBehavior);
+		expectedVisits = recordedBehaviors;
+
+		try
+		{
+			root->preOrderTraverse(throwingVisitor);
+		}
+		catch (int)
+		{
+		}
+
+		try
+		{
+			root->preOrderTraverse([](Behavior const*) { throw 0; });
+		}
+		catch (int)
+		{
+		}
+
+		recordedBehaviors.clear();
+		lambdaVisits.clear();
+		root->preOrderTraverse(recordBehavior);
+		root->preOrderTraverse(record);
+
+		if (recordedBehaviors != expectedVisits || lambdaVisits != expectedVisits)
+			fail("A pre-order traversal that threw broke the next one!");
+
+		recordedBehaviors.clear();
+		root->postOrderTraverse(recordBehavior);
+		expectedVisits = recordedBehaviors;
+
+		try
+		{
+			root->postOrderTraverse(throwingVisitor);
+		}
+		catch (int)
+		{
+		}
+
+		try
+		{
+			root->postOrderTraverse([](Behavior const*) { throw 0; });
+		}
+		catch (int)
+		{
+		}
+
+		recordedBehaviors.clear();
+		lambdaVisits.clear();
+		root->postOrderTraverse(recordBehavior);
+		root->postOrderTraverse(record);
+
+		if (recordedBehaviors != expectedVisits || lambdaVisits != expectedVisits)
+			fail("A post-order traversal that threw broke the next one!");
+	}
+
+	void tick(char const* treeName, Behavior* root)
+	{
+		CompiledBehavior compiled(root);
+		verify(root, compiled);
+
+		unsigned const ticks = isQuick() ? 200 : 2000;
+		unsigned successes = 0;
+		char name[96];
+
+		Timer timer;
+
+		for (unsigned index = 0; index < ticks; ++index)
+			successes += root->run(ignoreBehavior, NULL);
+
+		std::snprintf(name, sizeof(name), "%s/pointer", treeName);
+		report(name, ticks, timer.getSeconds());
+		timer.restart();
+
+		for (unsigned index = 0; index < ticks; ++index)
+			successes += compiled.run(ignoreBehavior, NULL);
+
+		std::snprintf(name, sizeof(name), "%s/compiled", treeName);
+		report(name, ticks, timer.getSeconds());
+		keep(successes);
+	}
+
+	void compiledTick()
+	{
+		for (unsigned seed = 1; seed <= 3; ++seed)
+		{
+			char name[64];
+			Behavior* root = buildBalancedTree(12, 3, seed);
+			std::snprintf(name, sizeof(name), "tick/balanced_d12_f3_s%u", seed);
+			tick(name, root);
+			deleteTree(root);
+		}
+
+		Behavior* root = buildChainTree(2000);
+		tick("tick/chain_d2000", root);
+		deleteTree(root);
+
+		// A subclass of Sequence runs its own run(), in the compiled form as well. (The
+		// templated run() does not take such trees.)
+		root = new Selector("Root");
+		Behavior* inverter = new InvertedSequence("Inverted");
+		root->addChild(inverter);
+		root->addChild(new TestBehavior("After", true));
+		inverter->addChild(new TestBehavior("First", true));
+		inverter->addChild(new TestBehavior("Second", false));
+
+		CompiledBehavior compiled(root);
+		recordedBehaviors.clear();
+		bool expected = root->run(recordBehavior, NULL);
+		std::vector<Behavior const*> expectedVisits(recordedBehaviors);
+
+		recordedBehaviors.clear();
+
+		if (compiled.run(recordBehavior, NULL) != expected || recordedBehaviors != expectedVisits)
+			fail("CompiledBehavior expanded a subclass of Sequence!");
+
+		deleteTree(root);
+	}
+
+	// An action that takes length ticks, counted in the context.
+	struct Action
+	{
+		unsigned steps;
+		unsigned length;
+	};
+
+	class LongAction : public Leaf<Action>
+	{
+	public:
+		using Leaf<Action>::step;
+
+		LongAction() : Leaf<Action>("Long Action") { }
+
+		// Run from the root every tick, the action reports success for each step it takes.
+		bool tick(Action& action)
+		{
+			action.steps++;
+			return true;
+		}
+
+		Status step(Action& action)
+		{
+			return (++action.steps % action.length) ? RUNNING : SUCCESS;
+		}
+	};
+
+	// A chain of the given depth with a long action at its bottom, ticked from the root
+	// every time versus resumed at the action.
+	void runningChain(unsigned depth)
+	{
+		Behavior* root = buildChainTree(depth);
+		Behavior* bottom = root;
+		Action action = { 0, 50 };
+		RunningState state;
+		char name[64];
+
+		while (bottom->getChildCount() > 1)
+			bottom = bottom->getChild(1);
+
+		bottom->addChild(new LongAction());
+
+		// Resumed over the length of the action, the callbacks add up to one run of the
+		// whole tree: the leaves before the action on the first tick, and the action and
+		// everything above it on the last.
+		recordedBehaviors.clear();
+		root->run(recordBehavior, &action);
+		std::vector<Behavior const*> expectedVisits(recordedBehaviors);
+
+		recordedBehaviors.clear();
+		action.steps = 0;
+
+		for (unsigned tick = 1; tick <= action.length; ++tick)
+		{
+			Behavior::Status status = Composite::resume(root, state, recordBehavior, &action);
+
+			if (status != (tick < action.length ? Behavior::RUNNING : Behavior::SUCCESS) || state.isRunning() != (tick < action.length))
+				fail("A resumed tick returned the wrong status!");
+		}
+
+		if (recordedBehaviors != expectedVisits || action.steps != action.length)
+			fail("Resuming the long action reported the wrong nodes!");
+
+		unsigned const ticks = (isQuick() ? 20 : 200) * action.length;
+		unsigned successes = 0;
+
+		Timer timer;
+
+		for (unsigned tick = 0; tick < ticks; ++tick)
+			successes += root->run(ignoreBehavior, &action);
+
+		std::snprintf(name, sizeof(name), "tick/running_chain_d%u/from-root", depth);
+		report(name, ticks, timer.getSeconds());
+		timer.restart();
+
+		for (unsigned tick = 0; tick < ticks; ++tick)
+			successes += Composite::resume(root, state, ignoreBehavior, &action);
+
+		std::snprintf(name, sizeof(name), "tick/running_chain_d%u/resumed", depth);
+		report(name, ticks, timer.getSeconds());
+		keep(successes);
+		deleteTree(root);
+	}
+
+	void runningTick()
+	{
+		runningChain(8);
+		runningChain(64);
+		runningChain(1024);
+	}
+
+	// A null visitor through the function-pointer API and through the templated one, so
+	// the difference is the cost of the calls themselves. The tree is small enough to stay
+	// in cache, where the calls are not hidden behind misses.
+	void visitorOverhead()
+	{
+		Behavior* root = buildBalancedTree(8, 3, 1);
+		CompiledBehavior compiled(root);
+		unsigned const passes = isQuick() ? 200 : 2000;
+		unsigned long long nodes = compiled.getEntryCount() * (unsigned long long)passes;
+		auto ignore = [](Behavior const*) {};
+		unsigned successes = 0;
+		int none = 0;
+
+		verify(root, compiled);
+		verifyTraversals(root);
+
+		Timer timer;
+
+		for (unsigned pass = 0; pass < passes; ++pass)
+			root->breadthFirstTraverse(ignoreBehavior);
+
+		report("visitor/breadth-first/function-pointer", nodes, timer.getSeconds());
+		timer.restart();
+
+		for (unsigned pass = 0; pass < passes; ++pass)
+			root->breadthFirstTraverse(ignore);
+
+		report("visitor/breadth-first/lambda", nodes, timer.getSeconds());
+		timer.restart();
+
+		for (unsigned pass = 0; pass < passes; ++pass)
+			root->preOrderTraverse(ignoreBehavior);
+
+		report("visitor/pre-order/function-pointer", nodes, timer.getSeconds());
+		timer.restart();
+
+		for (unsigned pass = 0; pass < passes; ++pass)
+			root->preOrderTraverse(ignore);
+
+		report("visitor/pre-order/lambda", nodes, timer.getSeconds());
+		timer.restart();
+
+		for (unsigned pass = 0; pass < passes; ++pass)
+			root->postOrderTraverse(ignoreBehavior);
+
+		report("visitor/post-order/function-pointer", nodes, timer.getSeconds());
+		timer.restart();
+
+		for (unsigned pass = 0; pass < passes; ++pass)
+			root->postOrderTraverse(ignore);
+
+		report("visitor/post-order/lambda", nodes, timer.getSeconds());
+		deleteTree(root);
+
+		// Every node of a chain succeeds, so each tick reports every entry.
+		root = buildChainTree(2000);
+		CompiledBehavior chain(root);
+		unsigned long long entries = chain.getEntryCount() * (unsigned long long)passes;
+
+		verify(root, chain);
+		timer.restart();
+
+		for (unsigned pass = 0; pass < passes; ++pass)
+			successes += chain.run(ignoreBehavior, NULL);
+
+		report("visitor/compiled-tick/function-pointer", entries, timer.getSeconds());
+		timer.restart();
+
+		for (unsigned pass = 0; pass < passes; ++pass)
+			successes += chain.run(none, ignore);
+
+		report("visitor/compiled-tick/lambda", entries, timer.getSeconds());
+		keep(successes);
+		deleteTree(root);
+	}
+}
+
+FULLSAIL_BENCHMARK(compiledTick);
+FULLSAIL_BENCHMARK(runningTick);
+FULLSAIL_BENCHMARK(visitorOverhead);
@@ -0,0 +1,61 @@
+//! \file Benchmark.h
+//! \brief Defines the registry and timing helpers shared by the micro-benchmarks.
+#ifndef _FULLSAIL_AI_FUNDAMENTALS_BENCHMARK_H_
+#define _FULLSAIL_AI_FUNDAMENTALS_BENCHMARK_H_
+
+#include <chrono>
+
+namespace fullsail_ai { namespace benchmark {
+
+	//! \brief Measures wall-clock time from construction (or the last <code>restart()</code>).
+	class Timer
+	{
+		std::chrono::steady_clock::time_point start;
+
+	public:
+		Timer() : start(std::chrono::steady_clock::now()) { }
+
+		void restart() { start = std::chrono::steady_clock::now(); }
+
+		//! \brief Returns the elapsed time in seconds.
+		double getSeconds() const
+		{
+			return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		}
+	};
+
+	//! \brief Keeps the compiler from optimizing away the computation that produced \a value.
+	template <typename T>
+	inline void keep(T const& value)
+	{
+#if defined(_MSC_VER)
+		static T const* volatile sink;
+		sink = &value;
+#else
+		asm volatile("" : : "g"(&value) : "memory");
+#endif
+	}
+
+	//! \brief Records one measurement. \a items is the number of operations timed.
+	void report(char const* name, unsigned long long items, double seconds);
+
+	//! \brief Prints the message formatted as by <code>printf()</code>, and a newline, and
+	//! exits with status 1. Benchmarks call it when a result they check is wrong.
+	void fail(char const* format, ...);
+
+	//! \brief Returns <code>true</code> if the runner was asked for a quick pass
+	//! (smaller sizes, for smoke testing the benchmarks themselves).
+	bool isQuick();
+
+	//! \brief Registers a benchmark function with the runner in <code>BenchmarkMain.cpp</code>.
+	struct Registration
+	{
+		Registration(char const* name, void (*function)());
+	};
+}}  // namespace fullsail_ai::benchmark
+
+//! \brief Registers \a function so the benchmark runner executes it.
+#define FULLSAIL_BENCHMARK(function) \
+	static ::fullsail_ai::benchmark::Registration function##Registration(#function, function)
+
+#endif  // _FULLSAIL_AI_FUNDAMENTALS_BENCHMARK_H_
@@ -0,0 +1,194 @@
+// BenchmarkMain.cpp - the entry point of the micro-benchmark runner
+//
+// Usage: Benchmark [--quick] [--json file] [filter]
+// Runs every registered benchmark whose name contains the filter. With --json, also writes
+// the measurements to file in Google Benchmark's JSON layout, so its compare.py can diff
+// two runs. Only wall-clock time is measured; cpu_time repeats real_time.
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Benchmark.h"
+#include "../BehaviorTree/Behavior.h"
+
+namespace fullsail_ai { namespace benchmark {
+
+	namespace {
+		struct Entry
+		{
+			char const* name;
+			void (*function)();
+		};
+
+		// Function-local so registrations from other translation units never see it unbuilt.
+		std::vector<Entry>& getEntries()
+		{
+			static std::vector<Entry> entries;
+			return entries;
+		}
+
+		struct Result
+		{
+			std::string name;
+			char const* group; // The registered benchmark that reported it
+			unsigned long long items;
+			double seconds;
+		};
+
+		std::vector<Result> results;
+		char const* currentGroup = "";
+		bool quick = false;
+
+		void writeString(std::FILE* file, char const* text)
+		{
+			std::fputc('"', file);
+
+			for (; *text; ++text)
+			{
+				if (*text == '"' || *text == '\\')
+					std::fputc('\\', file);
+
+				if ((unsigned char)*text < 0x20)
+					std::fprintf(file, "\\u%04x", (unsigned char)*text);
+				else
+					std::fputc(*text, file);
+			}
+
+			std::fputc('"', file);
+		}
+
+		bool writeJson(char const* path, char const* executable)
+		{
+			std::FILE* file = std::fopen(path, "w");
+
+			if (!file)
+				return false;
+
+			char date[32];
+			std::time_t now = std::time(NULL);
+			std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+			std::fprintf(file, "{\n  \"context\": {\n    \"date\": \"%s\",\n    \"executable\": ", date);
+			writeString(file, executable);
+			std::fprintf(file, ",\n    \"num_cpus\": %u,\n", std::thread::hardware_concurrency());
+#ifdef NDEBUG
+			std::fprintf(file, "    \"library_build_type\": \"release\",\n");
+#else
+			std::fprintf(file, "    \"library_build_type\": \"debug\",\n");
+#endif
+			std::fprintf(file, "    \"quick\": %s\n  },\n  \"benchmarks\": [", quick ? "true" : "false");
+
+			for (size_t index = 0; index < results.size(); ++index)
+			{
+				Result const& result = results[index];
+				double nanoseconds = result.items ? result.seconds * 1e9 / result.items : 0.0;
+
+				std::fprintf(file, index ? ",\n    {\n      \"name\": " : "\n    {\n      \"name\": ");
+				writeString(file, result.name.c_str());
+				std::fprintf(file, ",\n      \"run_name\": ");
+				writeString(file, result.name.c_str());
+				std::fprintf(file, ",\n      \"family\": ");
+				writeString(file, result.group);
+				std::fprintf(file, ",\n      \"run_type\": \"iteration\",\n      \"repetitions\": 1,\n"
+				                   "      \"iterations\": %llu,\n      \"real_time\": %.6e,\n      \"cpu_time\": %.6e,\n"
+				                   "      \"time_unit\": \"ns\",\n      \"items_per_second\": %.6e\n    }",
+				             result.items, nanoseconds, nanoseconds, result.seconds > 0 ? result.items / result.seconds : 0.0);
+			}
+
+			std::fprintf(file, "\n  ]\n}\n");
+			return std::fclose(file) == 0;
+		}
+	}
+
+	Registration::Registration(char const* name, void (*function)())
+	{
+		Entry entry = { name, function };
+		getEntries().push_back(entry);
+	}
+
+	void report(char const* name, unsigned long long items, double seconds)
+	{
+		double nanoseconds = items ? seconds * 1e9 / items : 0.0;
+		Result result = { name, currentGroup, items, seconds };
+
+		std::printf("%-48s %12llu items %12.3f ms %10.2f ns/item\n", name, items, seconds * 1e3, nanoseconds);
+		results.push_back(result);
+	}
+
+	void fail(char const* format, ...)
+	{
+		std::va_list arguments;
+
+		va_start(arguments, format);
+		std::vprintf(format, arguments);
+		va_end(arguments);
+		std::printf("\n");
+		std::exit(1);
+	}
+
+	bool isQuick()
+	{
+		return quick;
+	}
+}}  // namespace fullsail_ai::benchmark
+
+int main(int argc, char** argv)
+{
+	using namespace fullsail_ai::benchmark;
+	using fullsail_ai::fundamentals::Behavior;
+
+	char const* filter = "";
+	char const* json = NULL;
+
+	for (int index = 1; index < argc; ++index)
+	{
+		if (std::strcmp(argv[index], "--quick") == 0)
+			quick = true;
+		else if (std::strcmp(argv[index], "--json") == 0 && index + 1 < argc)
+			json = argv[++index];
+		else
+			filter = argv[index];
+	}
+
+	// A library built from other headers would be called through the wrong vtable slots.
+	if (Behavior::getAbiVersion() != Behavior::ABI_VERSION)
+	{
+		std::printf("The behavior tree library has ABI version %u, not %u!\n",
+		            Behavior::getAbiVersion(), (unsigned)Behavior::ABI_VERSION);
+		return 1;
+	}
+
+	std::vector<Entry> const& entries = getEntries();
+
+	for (size_t index = 0; index < entries.size(); ++index)
+	{
+		if (std::strstr(entries[index].name, filter) != 0)
+		{
+			unsigned live = Behavior::getCreatedCount() - Behavior::getDestroyedCount();
+
+			std::printf("== %s\n", entries[index].name);
+			currentGroup = entries[index].name;
+			entries[index].function();
+
+			// Every benchmark tears down the trees it builds.
+			if (Behavior::getCreatedCount() - Behavior::getDestroyedCount() != live)
+			{
+				std::printf("%s leaked %u behaviors!\n", entries[index].name,
+				            Behavior::getCreatedCount() - Behavior::getDestroyedCount() - live);
+				return 1;
+			}
+		}
+	}
+
+	if (json && !writeJson(json, argv[0]))
+	{
+		std::printf("Could not write %s\n", json);
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,180 @@
+// BitPlaneBenchmark.cpp - bit-plane worlds against the per-cell char loops on large maps
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include "Benchmark.h"
+#include "../WumpusWorld/Agent.h"
+#include "../WumpusWorld/BitWorld.h"
+#include "../WumpusWorld/Grid2D.h"
+#include "../WumpusWorld/WorldGenerator.h"
+
+using namespace fullsail_ai::fundamentals;
+using namespace fullsail_ai::benchmark;
+
+namespace {
+
+	// The per-cell char loop: derives BREEZE and STENCH from the PIT and WUMPUS flags.
+	void deriveStimulus(char* cells, unsigned width, unsigned height)
+	{
+		for (unsigned x = 0; x < width; x++)
+			for (unsigned y = 0; y < height; y++)
+			{
+				char neighbors = 0;
+
+				if (x > 0)
+					neighbors |= cells[(size_t)(x - 1) * height + y];
+				if (x + 1 < width)
+					neighbors |= cells[(size_t)(x + 1) * height + y];
+				if (y > 0)
+					neighbors |= cells[(size_t)x * height + y - 1];
+				if (y + 1 < height)
+					neighbors |= cells[(size_t)x * height + y + 1];
+
+				char& cell = cells[(size_t)x * height + y];
+				cell &= ~(BREEZE | STENCH);
+				cell |= ((neighbors & PIT) ? BREEZE : NONE) | ((neighbors & WUMPUS) ? STENCH : NONE);
+			}
+	}
+
+	// Checks both directions of the conversion, and the bit-plane derivation against the
+	// char one, on a map whose height is not a multiple of 64 and one whose height is.
+	void verify(unsigned width, unsigned height)
+	{
+		WorldGenerator generator(width, height);
+		BitWorld world(width, height);
+		std::vector<char> cells(generator.getCellCount()), copy(generator.getCellCount());
+
+		generator.generate(7, &cells[0]);
+		world.loadCells(&cells[0]);
+		world.breeze.clear();
+		world.stench.clear();
+		world.deriveStimulus();
+		world.storeCells(&copy[0]);
+
+		if (std::memcmp(&cells[0], &copy[0], cells.size()) != 0)
+			fail("The bit-plane stimulus differs from WorldGenerator's!");
+
+		world.generate(7);
+		world.storeCells(&cells[0]);
+		std::memcpy(&copy[0], &cells[0], cells.size());
+		deriveStimulus(&copy[0], width, height);
+
+		if (std::memcmp(&cells[0], &copy[0], cells.size()) != 0)
+			fail("A generated bit-plane world has the wrong stimulus!");
+
+		if (world.start.count() != 1 || world.wumpus.count() != 1 || world.gold.count() != 1)
+			fail("A generated bit-plane world does not have exactly one start, wumpus and gold!");
+
+		world.start &= world.pit;
+
+		if (world.start.count() != 0)
+			fail("A generated bit-plane world has a pit in the start cell!");
+	}
+
+	void bitPlaneSetup()
+	{
+		unsigned const size = isQuick() ? 1024 : 4096;
+		WorldGenerator generator(size, size);
+		BitWorld world(size, size);
+		std::vector<char> cells(generator.getCellCount());
+		unsigned long long cellCount = generator.getCellCount();
+		char name[64];
+
+		verify(257, 129);
+		verify(130, 192);
+
+		// A one-cell map has nowhere to put the wumpus and the gold but the start.
+		BitWorld single(1, 1);
+		single.generate(7);
+
+		if (!single.start.test(0, 0) || !single.wumpus.test(0, 0) || !single.gold.test(0, 0) || single.pit.test(0, 0))
+			fail("A one-cell bit-plane world is not the start, wumpus and gold in one cell!");
+
+		Timer timer;
+		generator.generate(3, &cells[0]);
+		std::snprintf(name, sizeof(name), "bitplane/setup/char/%ux%u", size, size);
+		report(name, cellCount, timer.getSeconds());
+		keep(cells[cellCount / 2]);
+
+		timer.restart();
+		world.generate(3);
+		std::snprintf(name, sizeof(name), "bitplane/setup/bits/%ux%u", size, size);
+		report(name, cellCount, timer.getSeconds());
+		keep(world.breeze.count());
+
+		timer.restart();
+		deriveStimulus(&cells[0], size, size);
+		std::snprintf(name, sizeof(name), "bitplane/derive/char/%ux%u", size, size);
+		report(name, cellCount, timer.getSeconds());
+		keep(cells[cellCount / 2]);
+
+		timer.restart();
+		world.deriveStimulus();
+		std::snprintf(name, sizeof(name), "bitplane/derive/bits/%ux%u", size, size);
+		report(name, cellCount, timer.getSeconds());
+		keep(world.breeze.count());
+	}
+
+	// Finds every cell next to a safe, unexplored cell: the question ProcessPercepts asks
+	// about the agent's own cell, asked of the whole map at once.
+	void bitPlaneInference()
+	{
+		unsigned const size = isQuick() ? 1024 : 4096;
+		Grid2D<char> modelWorld(size, size), stimulus(size, size), answer(size, size);
+		BitPlane clear(size, size), unexplored(size, size), candidates(size, size), bitAnswer(size, size);
+		unsigned long long cellCount = (unsigned long long)size * size;
+		unsigned state = 12345;
+		char name[64];
+
+		for (unsigned x = 0; x < size; x++)
+			for (unsigned y = 0; y < size; y++)
+			{
+				state = state * 1664525u + 1013904223u;
+				modelWorld(x, y) = (state >> 31) ? Knowledge::CLEAR : Knowledge::UNKNOWN;
+				stimulus(x, y) = ((state >> 30) & 1) ? UNEXPLORED : NONE;
+
+				if (modelWorld(x, y) == Knowledge::CLEAR)
+					clear.set(x, y);
+				if (stimulus(x, y) & UNEXPLORED)
+					unexplored.set(x, y);
+			}
+
+		int offset[4][2] = { {-1, 0}, {1, 0}, {0, -1}, {0, 1} };
+		Timer timer;
+
+		for (unsigned x = 0; x < size; x++)
+			for (unsigned y = 0; y < size; y++)
+			{
+				bool found = false;
+
+				for (int index = 0; index < 4 && !found; index++)
+				{
+					unsigned newX = x + offset[index][0], newY = y + offset[index][1];
+
+					if (modelWorld.contains(newX, newY))
+						found = (stimulus(newX, newY) & UNEXPLORED) && modelWorld(newX, newY) == Knowledge::CLEAR;
+				}
+
+				answer(x, y) = found;
+			}
+
+		std::snprintf(name, sizeof(name), "bitplane/safe-unexplored/char/%ux%u", size, size);
+		report(name, cellCount, timer.getSeconds());
+		timer.restart();
+
+		candidates = clear;
+		candidates &= unexplored;
+		bitAnswer.setNeighborsOf(candidates);
+
+		std::snprintf(name, sizeof(name), "bitplane/safe-unexplored/bits/%ux%u", size, size);
+		report(name, cellCount, timer.getSeconds());
+
+		for (unsigned x = 0; x < size; x++)
+			for (unsigned y = 0; y < size; y++)
+				if ((answer(x, y) != 0) != bitAnswer.test(x, y))
+					fail("The bit-plane safe-unexplored sweep disagrees with the char one!");
+	}
+}
+
+FULLSAIL_BENCHMARK(bitPlaneSetup);
+FULLSAIL_BENCHMARK(bitPlaneInference);
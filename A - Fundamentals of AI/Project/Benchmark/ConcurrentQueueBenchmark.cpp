@@ -0,0 +1,114 @@
+// ConcurrentQueueBenchmark.cpp - compares the lock-free ConcurrentQueue with a mutex-guarded QueueList
+#include <atomic>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "Benchmark.h"
+#include "../QueueList/QueueList.h"
+#include "../QueueList/ConcurrentQueue.h"
+
+using namespace fullsail_ai::fundamentals;
+using namespace fullsail_ai::benchmark;
+
+namespace {
+
+	// A QueueList behind one lock, with the ConcurrentQueue interface.
+	class LockedQueueList
+	{
+		std::mutex mutex;
+		QueueList<unsigned> list;
+
+	public:
+		explicit LockedQueueList(std::size_t) { }
+
+		bool enqueue(unsigned element)
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			list.enqueue(element);
+			return true;
+		}
+
+		bool dequeue(unsigned& element)
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+
+			if (list.isEmpty())
+				return false;
+
+			element = list.popFront();
+			return true;
+		}
+	};
+
+	template <typename Queue>
+	void transfer(char const* queueName, unsigned producerCount, unsigned consumerCount)
+	{
+		unsigned const itemsPerProducer = isQuick() ? 100000 : 2000000;
+		Queue queue(4096);
+		std::atomic<unsigned> remaining(itemsPerProducer * producerCount);
+		std::atomic<unsigned long long> sum(0);
+		std::vector<std::thread> threads;
+
+		Timer timer;
+
+		for (unsigned producer = 0; producer < producerCount; ++producer)
+		{
+			threads.push_back(std::thread([&queue, itemsPerProducer]()
+			{
+				for (unsigned item = 0; item < itemsPerProducer; ++item)
+					while (!queue.enqueue(item))
+						std::this_thread::yield();
+			}));
+		}
+
+		for (unsigned consumer = 0; consumer < consumerCount; ++consumer)
+		{
+			threads.push_back(std::thread([&queue, &remaining, &sum]()
+			{
+				unsigned long long localSum = 0;
+				unsigned item;
+
+				while (remaining.load(std::memory_order_relaxed) > 0)
+				{
+					if (queue.dequeue(item))
+					{
+						localSum += item;
+						remaining.fetch_sub(1, std::memory_order_relaxed);
+					}
+					else
+						std::this_thread::yield();
+				}
+
+				sum.fetch_add(localSum);
+			}));
+		}
+
+		for (size_t index = 0; index < threads.size(); ++index)
+			threads[index].join();
+
+		double seconds = timer.getSeconds();
+		keep(sum);
+
+		char name[64];
+		std::snprintf(name, sizeof(name), "%s/%up%uc", queueName, producerCount, consumerCount);
+		report(name, (unsigned long long)itemsPerProducer * producerCount, seconds);
+	}
+
+	unsigned const threadCounts[][2] = { { 1, 1 }, { 2, 2 }, { 4, 4 }, { 1, 4 }, { 4, 1 } };
+
+	void concurrentQueue()
+	{
+		for (size_t index = 0; index < sizeof(threadCounts) / sizeof(threadCounts[0]); ++index)
+			transfer<ConcurrentQueue<unsigned> >("ConcurrentQueue", threadCounts[index][0], threadCounts[index][1]);
+	}
+
+	void lockedQueueList()
+	{
+		for (size_t index = 0; index < sizeof(threadCounts) / sizeof(threadCounts[0]); ++index)
+			transfer<LockedQueueList>("LockedQueueList", threadCounts[index][0], threadCounts[index][1]);
+	}
+}
+
+FULLSAIL_BENCHMARK(concurrentQueue);
+FULLSAIL_BENCHMARK(lockedQueueList);
@@ -0,0 +1,311 @@
+// DeepTreeBenchmark.cpp - iterative traversals and execution against the recursive definitions
+#include <cstdio>
+#include <map>
+#include <typeinfo>
+#include <vector>
+#include "Benchmark.h"
+#include "SyntheticTree.h"
+#include "../WumpusWorld/Behaviors.h"
+#include "../WumpusWorld/CompiledBehavior.h"
+
+using namespace fullsail_ai::fundamentals;
+using namespace fullsail_ai::benchmark;
+
+namespace {
+
+	// The recursive definitions the iterative versions replace.
+	void preOrderRecursively(Behavior const* node, void (*dataFunction)(Behavior const*))
+	{
+		dataFunction(node);
+
+		for (size_t index = 0; index < node->getChildCount(); index++)
+			preOrderRecursively(node->getChild(index), dataFunction);
+	}
+
+	void postOrderRecursively(Behavior const* node, void (*dataFunction)(Behavior const*))
+	{
+		for (size_t index = 0; index < node->getChildCount(); index++)
+			postOrderRecursively(node->getChild(index), dataFunction);
+
+		dataFunction(node);
+	}
+
+	class RecursiveSequence : public Behavior
+	{
+	public:
+		RecursiveSequence(char const* _description) : Behavior(_description) {}
+
+		bool run(void (*dataFunction)(Behavior const*), void* context)
+		{
+			for (size_t index = 0; index < children.size(); index++)
+				if (!children[index]->run(dataFunction, context))
+					return false;
+
+			dataFunction(this);
+			return true;
+		}
+	};
+
+	class RecursiveSelector : public Behavior
+	{
+	public:
+		RecursiveSelector(char const* _description) : Behavior(_description) {}
+
+		bool run(void (*dataFunction)(Behavior const*), void* context)
+		{
+			for (size_t index = 0; index < children.size(); index++)
+				if (children[index]->run(dataFunction, context))
+				{
+					dataFunction(this);
+					return true;
+				}
+
+			return false;
+		}
+	};
+
+	// Copies the sequences and selectors of a tree into recursive ones; the leaves are
+	// shared with the original.
+	Behavior* cloneRecursively(Behavior* node)
+	{
+		Behavior* clone;
+
+		if (typeid(*node) == typeid(Sequence))
+			clone = new RecursiveSequence(node->toString());
+		else if (typeid(*node) == typeid(Selector))
+			clone = new RecursiveSelector(node->toString());
+		else
+			return node;
+
+		for (size_t index = 0; index < node->getChildCount(); index++)
+			clone->addChild(cloneRecursively(node->getChild(index)));
+
+		return clone;
+	}
+
+	void deleteClone(Behavior* clone)
+	{
+		if (clone->isLeaf())
+			return;
+
+		for (size_t index = 0; index < clone->getChildCount(); index++)
+			deleteClone(clone->getChild(index));
+
+		delete clone;
+	}
+
+	// Checks every traversal and both executions of a chain of the given depth against
+	// the order the chain dictates, without recursing anywhere.
+	void chain(unsigned depth)
+	{
+		Timer timer;
+		Behavior* root = buildChainTree(depth);
+		std::vector<Behavior const*> preOrder, postOrder, breadthFirst;
+
+		std::printf("  built a chain of %u sequences in %.1f ms\n", depth, timer.getSeconds() * 1e3);
+
+		// Each level is a sequence holding a leaf and the next level.
+		for (Behavior const* node = root; node != NULL; node = (node->getChildCount() > 1) ? node->getChild(1) : NULL)
+		{
+			preOrder.push_back(node);
+			preOrder.push_back(node->getChild(0));
+		}
+
+		for (size_t index = 1; index < preOrder.size(); index += 2)
+			postOrder.push_back(preOrder[index]);
+
+		for (size_t index = preOrder.size(); index > 0; index -= 2)
+			postOrder.push_back(preOrder[index - 2]);
+
+		// Breadth-first takes each level's leaf before the next level's sequence.
+		breadthFirst.push_back(root);
+
+		for (size_t index = 1; index < preOrder.size(); index += 2)
+		{
+			breadthFirst.push_back(preOrder[index]);
+
+			if (index + 1 < preOrder.size())
+				breadthFirst.push_back(preOrder[index + 1]);
+		}
+
+		recordedBehaviors.clear();
+		timer.restart();
+		root->preOrderTraverse(recordBehavior);
+		report("deep/chain/pre-order", recordedBehaviors.size(), timer.getSeconds());
+
+		if (recordedBehaviors != preOrder)
+			fail("The pre-order traversal of the chain is out of order!");
+
+		recordedBehaviors.clear();
+		timer.restart();
+		root->postOrderTraverse(recordBehavior);
+		report("deep/chain/post-order", recordedBehaviors.size(), timer.getSeconds());
+
+		if (recordedBehaviors != postOrder)
+			fail("The post-order traversal of the chain is out of order!");
+
+		recordedBehaviors.clear();
+		timer.restart();
+		root->breadthFirstTraverse(recordBehavior);
+		report("deep/chain/breadth-first", recordedBehaviors.size(), timer.getSeconds());
+
+		if (recordedBehaviors != breadthFirst)
+			fail("The breadth-first traversal of the chain is out of order!");
+
+		std::vector<Behavior const*> lambdaVisits;
+		root->preOrderTraverse([&](Behavior const* behavior) { lambdaVisits.push_back(behavior); });
+		bool lambdaInOrder = (lambdaVisits == preOrder);
+		lambdaVisits.clear();
+		root->postOrderTraverse([&](Behavior const* behavior) { lambdaVisits.push_back(behavior); });
+
+		if (!lambdaInOrder || lambdaVisits != postOrder)
+			fail("A templated traversal of the chain is out of order!");
+
+		// Every node succeeds, and each reports after everything below it.
+		recordedBehaviors.clear();
+		timer.restart();
+		bool result = root->run(recordBehavior, NULL);
+		report("deep/chain/run", recordedBehaviors.size(), timer.getSeconds());
+
+		if (!result || recordedBehaviors != postOrder)
+			fail("Running the chain reported the wrong nodes!");
+
+		timer.restart();
+		CompiledBehavior compiled(root);
+		report("deep/chain/compile", compiled.getEntryCount(), timer.getSeconds());
+
+		recordedBehaviors.clear();
+		timer.restart();
+		result = compiled.run(recordBehavior, NULL);
+		report("deep/chain/compiled-run", recordedBehaviors.size(), timer.getSeconds());
+
+		if (!result || recordedBehaviors != postOrder)
+			fail("Running the compiled chain reported the wrong nodes!");
+
+		timer.restart();
+		deleteTree(root);
+		report("deep/chain/delete", preOrder.size(), timer.getSeconds());
+	}
+
+	void deepChain()
+	{
+		chain(1000000);
+	}
+
+	// Recursive and iterative traversals and runs of balanced trees, checked against each
+	// other and timed.
+	void balanced(unsigned depth, unsigned fanOut)
+	{
+		Behavior* root = buildBalancedTree(depth, fanOut, 1);
+		Behavior* recursive = cloneRecursively(root);
+		unsigned const passes = isQuick() ? 2 : 20;
+		unsigned long long nodes = 0;
+		unsigned successes = 0;
+		char name[96];
+
+		root->preOrderTraverse([&](Behavior const*) { nodes++; });
+
+		recordedBehaviors.clear();
+		preOrderRecursively(root, recordBehavior);
+		std::vector<Behavior const*> expected(recordedBehaviors);
+		recordedBehaviors.clear();
+		root->preOrderTraverse(recordBehavior);
+
+		if (recordedBehaviors != expected)
+			fail("The iterative pre-order traversal diverged from the recursive one!");
+
+		recordedBehaviors.clear();
+		postOrderRecursively(root, recordBehavior);
+		expected = recordedBehaviors;
+		recordedBehaviors.clear();
+		root->postOrderTraverse(recordBehavior);
+
+		if (recordedBehaviors != expected)
+			fail("The iterative post-order traversal diverged from the recursive one!");
+
+		// The clone has the same shape, so the two pre-orders pair each of its nodes with
+		// the original; the recursive run's callbacks are mapped back through that.
+		std::map<Behavior const*, Behavior const*> original;
+		std::vector<Behavior const*> clonePreOrder;
+		recursive->preOrderTraverse([&](Behavior const* behavior) { clonePreOrder.push_back(behavior); });
+
+		recordedBehaviors.clear();
+		root->preOrderTraverse(recordBehavior);
+
+		for (size_t index = 0; index < clonePreOrder.size(); index++)
+			original[clonePreOrder[index]] = recordedBehaviors[index];
+
+		recordedBehaviors.clear();
+		bool expectedResult = recursive->run(recordBehavior, NULL);
+		expected.clear();
+
+		for (size_t index = 0; index < recordedBehaviors.size(); index++)
+			expected.push_back(original[recordedBehaviors[index]]);
+
+		recordedBehaviors.clear();
+
+		if (root->run(recordBehavior, NULL) != expectedResult || recordedBehaviors != expected)
+			fail("The iterative run diverged from the recursive one!");
+
+		Timer timer;
+
+		for (unsigned pass = 0; pass < passes; ++pass)
+			preOrderRecursively(root, ignoreBehavior);
+
+		std::snprintf(name, sizeof(name), "deep/balanced_d%u_f%u/pre-order/recursive", depth, fanOut);
+		report(name, nodes * passes, timer.getSeconds());
+		timer.restart();
+
+		for (unsigned pass = 0; pass < passes; ++pass)
+			root->preOrderTraverse(ignoreBehavior);
+
+		std::snprintf(name, sizeof(name), "deep/balanced_d%u_f%u/pre-order/iterative", depth, fanOut);
+		report(name, nodes * passes, timer.getSeconds());
+		timer.restart();
+
+		for (unsigned pass = 0; pass < passes; ++pass)
+			postOrderRecursively(root, ignoreBehavior);
+
+		std::snprintf(name, sizeof(name), "deep/balanced_d%u_f%u/post-order/recursive", depth, fanOut);
+		report(name, nodes * passes, timer.getSeconds());
+		timer.restart();
+
+		for (unsigned pass = 0; pass < passes; ++pass)
+			root->postOrderTraverse(ignoreBehavior);
+
+		std::snprintf(name, sizeof(name), "deep/balanced_d%u_f%u/post-order/iterative", depth, fanOut);
+		report(name, nodes * passes, timer.getSeconds());
+
+		// Ticks are reported per tick; how much of the tree one reaches depends on the leaves.
+		unsigned const ticks = passes * 20;
+
+		timer.restart();
+
+		for (unsigned tick = 0; tick < ticks; ++tick)
+			successes += recursive->run(ignoreBehavior, NULL);
+
+		std::snprintf(name, sizeof(name), "deep/balanced_d%u_f%u/run/recursive", depth, fanOut);
+		report(name, ticks, timer.getSeconds());
+		timer.restart();
+
+		for (unsigned tick = 0; tick < ticks; ++tick)
+			successes += root->run(ignoreBehavior, NULL);
+
+		std::snprintf(name, sizeof(name), "deep/balanced_d%u_f%u/run/iterative", depth, fanOut);
+		report(name, ticks, timer.getSeconds());
+		keep(successes);
+
+		deleteClone(recursive);
+		deleteTree(root);
+	}
+
+	void deepBalanced()
+	{
+		balanced(12, 3);
+		balanced(8, 6);
+		balanced(20, 2);
+	}
+}
+
+FULLSAIL_BENCHMARK(deepChain);
+FULLSAIL_BENCHMARK(deepBalanced);
@@ -0,0 +1,89 @@
+// FrontierBenchmark.cpp - open-set workload for QueueList versus IndexedQueueList
+#include <cstdio>
+#include <vector>
+#include "Benchmark.h"
+#include "../QueueList/QueueList.h"
+#include "../QueueList/IndexedQueueList.h"
+
+using namespace fullsail_ai::fundamentals;
+using namespace fullsail_ai::benchmark;
+
+namespace {
+
+	// Flood-fills a square grid with the queue as the open set. Every expansion asks the
+	// queue whether a neighbor is already open, and every eighth expansion withdraws the
+	// newest open cell (as a planner does when a cell turns out to be blocked).
+	template <typename Queue>
+	void floodFill(char const* queueName)
+	{
+		unsigned const side = isQuick() ? 128 : 500;
+		std::vector<bool> closed(side * side, false);
+		Queue open;
+		unsigned long long operations = 0;
+		unsigned lastEnqueued = 0;
+
+		Timer timer;
+
+		open.enqueue(0);
+		++operations;
+
+		for (unsigned step = 0; !open.isEmpty(); ++step)
+		{
+			unsigned cell = open.popFront();
+			unsigned x = cell % side, y = cell / side;
+			closed[cell] = true;
+			++operations;
+
+			unsigned neighbors[4];
+			unsigned neighborCount = 0;
+
+			if (x > 0) neighbors[neighborCount++] = cell - 1;
+			if (x + 1 < side) neighbors[neighborCount++] = cell + 1;
+			if (y > 0) neighbors[neighborCount++] = cell - side;
+			if (y + 1 < side) neighbors[neighborCount++] = cell + side;
+
+			for (unsigned index = 0; index < neighborCount; ++index)
+			{
+				unsigned neighbor = neighbors[index];
+
+				if (closed[neighbor])
+					continue;
+
+				++operations;
+
+				if (!open.contains(neighbor))
+				{
+					open.enqueue(neighbor);
+					lastEnqueued = neighbor;
+					++operations;
+				}
+			}
+
+			if (step % 8 == 7 && open.contains(lastEnqueued))
+			{
+				open.remove(lastEnqueued);
+				closed[lastEnqueued] = true;
+				operations += 2;
+			}
+		}
+
+		double seconds = timer.getSeconds();
+
+		char name[64];
+		std::snprintf(name, sizeof(name), "%s/flood_fill/%ux%u", queueName, side, side);
+		report(name, operations, seconds);
+	}
+
+	void frontierQueueList()
+	{
+		floodFill<QueueList<unsigned> >("QueueList");
+	}
+
+	void frontierIndexedQueueList()
+	{
+		floodFill<IndexedQueueList<unsigned> >("IndexedQueueList");
+	}
+}
+
+FULLSAIL_BENCHMARK(frontierQueueList);
+FULLSAIL_BENCHMARK(frontierIndexedQueueList);
@@ -0,0 +1,124 @@
+// GridBenchmark.cpp - cost of an agent step on large maps, and of the grid storage underneath it
+#include <cstdio>
+#include <vector>
+#include "Benchmark.h"
+#include "SyntheticTree.h"
+#include "../WumpusWorld/Agent.h"
+#include "../WumpusWorld/Behaviors.h"
+#include "../WumpusWorld/Grid2D.h"
+#include "../WumpusWorld/WorldGenerator.h"
+
+using namespace fullsail_ai::fundamentals;
+using namespace fullsail_ai::benchmark;
+
+namespace {
+
+	// Times agent.update() alone; building each world and agent is left out.
+	void gridAgentStep()
+	{
+		unsigned const size = 1024;
+		unsigned const stepTarget = isQuick() ? 2000 : 20000;
+		unsigned const stepLimit = 2000;
+		WorldGenerator generator(size, size, 0.05);
+		std::vector<char> cells(generator.getCellCount());
+		Behavior* behavior = createBasicBehavior();
+		unsigned long long steps = 0;
+		double seconds = 0.0;
+		char name[64];
+
+		for (unsigned seed = 0; steps < stepTarget; seed++)
+		{
+			generator.generate(seed, &cells[0]);
+
+			World world(&cells[0], size, size);
+			Agent agent(world, *behavior, ignoreBehavior);
+			unsigned episodeSteps = 0;
+
+			agent.enter(world.getAgentX(), world.getAgentY());
+
+			Timer timer;
+
+			while (world.isAgentAlive() && world.doesAgentHaveArrow() && episodeSteps < stepLimit)
+			{
+				agent.update();
+				episodeSteps++;
+			}
+
+			seconds += timer.getSeconds();
+			steps += episodeSteps;
+			agent.exit();
+		}
+
+		std::snprintf(name, sizeof(name), "grid/agent-step/%ux%u", size, size);
+		report(name, steps, seconds);
+		deleteTree(behavior);
+	}
+
+	// Reads every cell's four neighbors, the access pattern of ProcessPercepts, from the
+	// nested vectors World and Knowledge used to store and from a Grid2D.
+	void gridNeighborhood()
+	{
+		unsigned const size = 1024;
+		unsigned const passes = isQuick() ? 2 : 20;
+		WorldGenerator generator(size, size);
+		Grid2D<char> grid(size, size);
+		std::vector<std::vector<char> > nested(size, std::vector<char>(size));
+		unsigned long long cellCount = (unsigned long long)(size - 2) * (size - 2) * passes;
+		unsigned sum = 0;
+
+		generator.generate(1, grid.getData());
+
+		for (unsigned x = 0; x < size; x++)
+			for (unsigned y = 0; y < size; y++)
+				nested[x][y] = grid(x, y);
+
+		Timer timer;
+
+		for (unsigned pass = 0; pass < passes; pass++)
+			for (unsigned x = 1; x + 1 < size; x++)
+				for (unsigned y = 1; y + 1 < size; y++)
+					sum += nested[x - 1][y] | nested[x + 1][y] | nested[x][y - 1] | nested[x][y + 1];
+
+		report("grid/neighborhood/nested-vector/1024x1024", cellCount, timer.getSeconds());
+		keep(sum);
+		timer.restart();
+
+		for (unsigned pass = 0; pass < passes; pass++)
+			for (unsigned x = 1; x + 1 < size; x++)
+				for (unsigned y = 1; y + 1 < size; y++)
+					sum += grid(x - 1, y) | grid(x + 1, y) | grid(x, y - 1) | grid(x, y + 1);
+
+		report("grid/neighborhood/grid2d/1024x1024", cellCount, timer.getSeconds());
+		keep(sum);
+	}
+
+	// Builds a World and an Agent's Knowledge, which allocated one vector per column before.
+	void gridSetup()
+	{
+		unsigned const size = 1024;
+		unsigned const rounds = isQuick() ? 5 : 50;
+		WorldGenerator generator(size, size);
+		std::vector<char> cells(generator.getCellCount());
+		Behavior* behavior = createBasicBehavior();
+
+		generator.generate(1, &cells[0]);
+
+		Timer timer;
+
+		for (unsigned round = 0; round < rounds; round++)
+		{
+			World world(&cells[0], size, size);
+			Agent agent(world, *behavior, ignoreBehavior);
+			agent.enter(world.getAgentX(), world.getAgentY());
+			keep(agent.getKnowledge().x);
+			agent.exit();
+		}
+
+		report("grid/setup/1024x1024", rounds, timer.getSeconds());
+		deleteTree(behavior);
+	}
+}
+
+FULLSAIL_BENCHMARK(gridAgentStep);
+FULLSAIL_BENCHMARK(gridNeighborhood);
+FULLSAIL_BENCHMARK(gridSetup);
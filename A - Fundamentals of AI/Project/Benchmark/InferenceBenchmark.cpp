@@ -0,0 +1,371 @@
+// InferenceBenchmark.cpp - incremental ProcessPercepts against the full-map sweep it replaced
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include "Benchmark.h"
+#include "SyntheticTree.h"
+#include "../WumpusWorld/Agent.h"
+#include "../WumpusWorld/Behaviors.h"
+#include "../WumpusWorld/WorldGenerator.h"
+
+using namespace fullsail_ai::fundamentals;
+using namespace fullsail_ai::benchmark;
+
+namespace {
+
+	int const offset[4][2] = { {-1, 0}, {1, 0}, {0, -1}, {0, 1} };
+
+	// ProcessPercepts as it was before the cell sets: writes modelWorld directly, and
+	// sweeps the whole map once the wumpus is found.
+	void processPerceptsLegacy(Knowledge& knowledge)
+	{
+		unsigned x = knowledge.x, y = knowledge.y;
+		Grid2D<char>& stimulus = knowledge.stimulus;
+		Grid2D<char>& modelWorld = knowledge.modelWorld;
+		bool breeze = ((stimulus(x, y) & BREEZE) != 0);
+		bool stench = ((stimulus(x, y) & STENCH) != 0);
+
+		if (!breeze && !stench)
+		{
+			for (int index = 0; index < 4; index++)
+			{
+				unsigned newX = x + offset[index][0], newY = y + offset[index][1];
+
+				if (modelWorld.contains(newX, newY))
+					modelWorld(newX, newY) = Knowledge::CLEAR;
+			}
+		}
+
+		if (breeze)
+		{
+			int nonPitSpaces = 0;
+
+			for (int index = 0; index < 4; index++)
+			{
+				unsigned newX = x + offset[index][0], newY = y + offset[index][1];
+
+				if (modelWorld.contains(newX, newY))
+				{
+					if (modelWorld(newX, newY) == Knowledge::CLEAR || modelWorld(newX, newY) == Knowledge::DEFINITE_WUMPUS)
+						nonPitSpaces++;
+				}
+				else
+					nonPitSpaces++;
+			}
+
+			for (int index = 0; index < 4; index++)
+			{
+				unsigned newX = x + offset[index][0], newY = y + offset[index][1];
+
+				if (modelWorld.contains(newX, newY))
+				{
+					if (nonPitSpaces == 3 && modelWorld(newX, newY) != Knowledge::CLEAR && modelWorld(newX, newY) != Knowledge::DEFINITE_WUMPUS)
+						modelWorld(newX, newY) = Knowledge::DEFINITE_PIT;
+					else if (modelWorld(newX, newY) == Knowledge::POSSIBLE_WUMPUS)
+						modelWorld(newX, newY) = Knowledge::POSSIBLE_W_P;
+					else if (modelWorld(newX, newY) == Knowledge::UNKNOWN)
+						modelWorld(newX, newY) = Knowledge::POSSIBLE_PIT;
+				}
+			}
+		}
+
+		if (stench && (knowledge.wumpusX == (unsigned)-1 || knowledge.wumpusY == (unsigned)-1))
+		{
+			int nonWumpusSpaces = 0;
+
+			for (int index = 0; index < 4; index++)
+			{
+				unsigned newX = x + offset[index][0], newY = y + offset[index][1];
+
+				if (modelWorld.contains(newX, newY))
+				{
+					if (modelWorld(newX, newY) == Knowledge::CLEAR || modelWorld(newX, newY) == Knowledge::DEFINITE_PIT)
+						nonWumpusSpaces++;
+				}
+				else
+					nonWumpusSpaces++;
+			}
+
+			for (int index = 0; index < 4; index++)
+			{
+				unsigned newX = x + offset[index][0], newY = y + offset[index][1];
+
+				if (modelWorld.contains(newX, newY))
+				{
+					if (nonWumpusSpaces == 3 && modelWorld(newX, newY) != Knowledge::CLEAR && modelWorld(newX, newY) != Knowledge::DEFINITE_PIT)
+					{
+						modelWorld(newX, newY) = Knowledge::DEFINITE_WUMPUS;
+						knowledge.wumpusX = newX;
+						knowledge.wumpusY = newY;
+
+						for (unsigned xIndex = 0; xIndex < modelWorld.getWidth(); xIndex++)
+							for (unsigned yIndex = 0; yIndex < modelWorld.getHeight(); yIndex++)
+							{
+								if (modelWorld(xIndex, yIndex) == Knowledge::POSSIBLE_WUMPUS)
+									modelWorld(xIndex, yIndex) = Knowledge::UNKNOWN;
+								else if (modelWorld(xIndex, yIndex) == Knowledge::POSSIBLE_W_P)
+									modelWorld(xIndex, yIndex) = Knowledge::POSSIBLE_PIT;
+							}
+					}
+					else if (modelWorld(newX, newY) == Knowledge::POSSIBLE_PIT)
+						modelWorld(newX, newY) = Knowledge::POSSIBLE_W_P;
+					else if (modelWorld(newX, newY) == Knowledge::UNKNOWN)
+						modelWorld(newX, newY) = Knowledge::POSSIBLE_WUMPUS;
+				}
+			}
+		}
+
+		knowledge.safeUnexploredLocationPresent = false;
+
+		for (int index = 0; index < 4; index++)
+		{
+			unsigned newX = x + offset[index][0], newY = y + offset[index][1];
+
+			if (modelWorld.contains(newX, newY) && (stimulus(newX, newY) & UNEXPLORED) && modelWorld(newX, newY) == Knowledge::CLEAR)
+			{
+				knowledge.safeUnexploredLocationPresent = true;
+				break;
+			}
+		}
+	}
+
+	// A leaf running processPerceptsLegacy(), so both versions can be timed through an agent.
+	class LegacyProcessPercepts : public Leaf<Agent>
+	{
+	public:
+		LegacyProcessPercepts(char const* _description) : Leaf<Agent>(_description) {}
+
+		bool tick(Agent& agent)
+		{
+			processPerceptsLegacy(agent.getKnowledge());
+			return true;
+		}
+	};
+
+	// Checks the cell sets against a recount of the whole map.
+	void verifyCellSets(Knowledge const& knowledge)
+	{
+		Grid2D<char> const& modelWorld = knowledge.modelWorld;
+		std::size_t possibleWumpus = 0, frontier = 0;
+
+		for (unsigned x = 0; x < modelWorld.getWidth(); x++)
+			for (unsigned y = 0; y < modelWorld.getHeight(); y++)
+			{
+				unsigned cell = x * modelWorld.getHeight() + y;
+				bool isPossibleWumpus = modelWorld(x, y) == Knowledge::POSSIBLE_WUMPUS || modelWorld(x, y) == Knowledge::POSSIBLE_W_P;
+				bool isFrontier = modelWorld(x, y) == Knowledge::CLEAR && (knowledge.stimulus(x, y) & UNEXPLORED);
+
+				if (knowledge.possibleWumpusCells.contains(cell) != isPossibleWumpus)
+					fail("The possible-wumpus set disagrees with modelWorld!");
+				if (knowledge.frontier.contains(cell) != isFrontier)
+					fail("The frontier disagrees with modelWorld!");
+
+				possibleWumpus += isPossibleWumpus ? 1 : 0;
+				frontier += isFrontier ? 1 : 0;
+			}
+
+		if (knowledge.possibleWumpusCells.size() != possibleWumpus || knowledge.frontier.size() != frontier)
+			fail("A cell set holds cells twice!");
+	}
+
+	// Walks the agent around the cells of a world that hold neither pit nor wumpus, so it
+	// lives long enough to smell the wumpus from several sides.
+	class RandomWalk
+	{
+		std::vector<char> const& cells;
+		unsigned width, height;
+		unsigned state;
+
+	public:
+		RandomWalk(std::vector<char> const& _cells, unsigned _width, unsigned _height, unsigned seed)
+			: cells(_cells), width(_width), height(_height), state(seed * 2654435761u + 1)
+		{
+		}
+
+		bool choose(unsigned x, unsigned y, Direction& direction)
+		{
+			for (int attempt = 0; attempt < 8; attempt++)
+			{
+				state = state * 1664525u + 1013904223u;
+
+				int index = (state >> 28) & 3;
+				unsigned newX = x + offset[index][0], newY = y + offset[index][1];
+
+				if (newX < width && newY < height && !(cells[newX * height + newY] & (PIT | WUMPUS)))
+				{
+					Direction const directions[4] = { LEFT, RIGHT, UP, DOWN };
+					direction = directions[index];
+					return true;
+				}
+			}
+
+			return false;
+		}
+	};
+
+	// Runs the incremental ProcessPercepts and the legacy one side by side on random
+	// worlds, comparing everything ProcessPercepts produces after every tick.
+	void verify(unsigned worldCount, unsigned size, unsigned ticks, unsigned& wumpusFound)
+	{
+		WorldGenerator generator(size, size);
+		std::vector<char> cells(generator.getCellCount());
+		ProcessPercepts processPercepts("Process Percepts");
+
+		for (unsigned seed = 0; seed < worldCount; seed++)
+		{
+			generator.generate(seed, &cells[0]);
+
+			World world(&cells[0], size, size);
+			Agent agent(world, processPercepts, ignoreBehavior);
+			Knowledge reference;
+			RandomWalk walk(cells, size, size, seed);
+
+			agent.enter(world.getAgentX(), world.getAgentY());
+			reference.init(world.getAgentX(), world.getAgentY(), size, size);
+
+			for (unsigned tick = 0; tick < ticks; tick++)
+			{
+				Knowledge& knowledge = agent.getKnowledge();
+				Direction direction;
+
+				agent.update();
+				reference.stimulus(reference.x, reference.y) = knowledge.stimulus(knowledge.x, knowledge.y);
+				processPerceptsLegacy(reference);
+
+				if (knowledge.modelWorld != reference.modelWorld || knowledge.wumpusX != reference.wumpusX
+				    || knowledge.wumpusY != reference.wumpusY
+				    || knowledge.safeUnexploredLocationPresent != reference.safeUnexploredLocationPresent)
+					fail("Incremental inference diverged from the full-map sweep!");
+
+				if (tick % 16 == 0)
+					verifyCellSets(knowledge);
+
+				if (!walk.choose(knowledge.x, knowledge.y, direction))
+					break;
+
+				agent.move(direction);
+				reference.x = knowledge.x;
+				reference.y = knowledge.y;
+			}
+
+			verifyCellSets(agent.getKnowledge());
+			wumpusFound += (agent.getKnowledge().wumpusX != (unsigned)-1) ? 1 : 0;
+			agent.exit();
+		}
+	}
+
+	// Times \a ticks ticks of an agent that runs only \a processPercepts while walking.
+	void walkLatency(Behavior& processPercepts, char const* variant, std::vector<char> const& cells, unsigned size, unsigned ticks)
+	{
+		World world(&cells[0], size, size);
+		Agent agent(world, processPercepts, ignoreBehavior);
+		RandomWalk walk(cells, size, size, 1);
+		Direction direction;
+		char name[64];
+
+		agent.enter(world.getAgentX(), world.getAgentY());
+
+		Timer timer;
+
+		for (unsigned tick = 0; tick < ticks; tick++)
+		{
+			agent.update();
+
+			if (walk.choose(agent.getKnowledge().x, agent.getKnowledge().y, direction))
+				agent.move(direction);
+		}
+
+		std::snprintf(name, sizeof(name), "inference/walk/%s/%ux%u", variant, size, size);
+		report(name, ticks, timer.getSeconds());
+		keep(agent.getKnowledge().modelWorld(0, 0));
+		agent.exit();
+	}
+
+	// Builds the knowledge of an agent standing at (1, 1) with the wumpus at (1, 2) and
+	// three clear neighbors, so its next tick pins the wumpus down, with \a marks other
+	// cells marked as possible wumpus or possible wumpus-or-pit.
+	void prepareWumpusTick(Knowledge& knowledge, unsigned size, unsigned marks)
+	{
+		knowledge.init(1, 1, size, size);
+		knowledge.mark(0, 1, Knowledge::CLEAR);
+		knowledge.mark(1, 0, Knowledge::CLEAR);
+		knowledge.mark(2, 1, Knowledge::CLEAR);
+
+		for (unsigned index = 0; index < marks; index++)
+		{
+			unsigned cell = (unsigned)(((unsigned long long)index * 2654435761u) % ((unsigned long long)size * (size - 4)));
+
+			knowledge.mark(cell / (size - 4), cell % (size - 4) + 4, (index & 1) ? Knowledge::POSSIBLE_W_P : Knowledge::POSSIBLE_WUMPUS);
+		}
+
+		knowledge.perceive(1, 1, STENCH);
+	}
+
+	void inferenceVerify()
+	{
+		unsigned wumpusFound = 0;
+
+		verify(isQuick() ? 100 : 1000, 8, 200, wumpusFound);
+		verify(isQuick() ? 20 : 200, 24, 2000, wumpusFound);
+
+		// The comparison means little unless the walks actually found some wumpuses.
+		if (wumpusFound == 0)
+			fail("No walk pinned down the wumpus!");
+
+		std::printf("  %u walks found the wumpus; every tick matched the full-map sweep\n", wumpusFound);
+	}
+
+	// Per-tick latency of a random walk on a large map, and of the tick that pins the
+	// wumpus down, which is the one that used to sweep the whole map.
+	void inferenceLatency()
+	{
+		unsigned const size = isQuick() ? 512 : 2048;
+		unsigned const ticks = 100000, repetitions = 10, marks = 64;
+		WorldGenerator generator(size, size);
+		std::vector<char> cells(generator.getCellCount());
+		ProcessPercepts processPercepts("Process Percepts");
+		LegacyProcessPercepts legacyProcessPercepts("Legacy Process Percepts");
+		char name[64];
+
+		generator.generate(1, &cells[0]);
+
+		walkLatency(processPercepts, "incremental", cells, size, ticks);
+		walkLatency(legacyProcessPercepts, "legacy", cells, size, ticks);
+
+		// The agent's own cell is the only one of this world that is ever perceived. Sized
+		// from size itself, so the compiler can see that cell (1, 1) is in range.
+		std::vector<char> stenchCells((size_t)size * size, NONE);
+		stenchCells[1 * size + 1] = START | STENCH;
+
+		World world(&stenchCells[0], size, size);
+		Agent agent(world, processPercepts, ignoreBehavior);
+		Knowledge legacy;
+		double incrementalSeconds = 0, legacySeconds = 0;
+
+		for (unsigned repetition = 0; repetition < repetitions; repetition++)
+		{
+			prepareWumpusTick(agent.getKnowledge(), size, marks);
+			prepareWumpusTick(legacy, size, marks);
+
+			Timer timer;
+			agent.update();
+			incrementalSeconds += timer.getSeconds();
+
+			timer.restart();
+			processPerceptsLegacy(legacy);
+			legacySeconds += timer.getSeconds();
+
+			if (agent.getKnowledge().modelWorld != legacy.modelWorld || agent.getKnowledge().wumpusX != 1
+			    || agent.getKnowledge().wumpusY != 2 || !agent.getKnowledge().possibleWumpusCells.isEmpty())
+				fail("The wumpus tick did not pin the wumpus down as the full-map sweep does!");
+		}
+
+		std::snprintf(name, sizeof(name), "inference/wumpus-tick/incremental/%ux%u", size, size);
+		report(name, repetitions, incrementalSeconds);
+		std::snprintf(name, sizeof(name), "inference/wumpus-tick/legacy/%ux%u", size, size);
+		report(name, repetitions, legacySeconds);
+	}
+}
+
+FULLSAIL_BENCHMARK(inferenceVerify);
+FULLSAIL_BENCHMARK(inferenceLatency);
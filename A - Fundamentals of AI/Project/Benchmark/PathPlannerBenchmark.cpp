@@ -0,0 +1,169 @@
+// PathPlannerBenchmark.cpp - A* and Jump Point Search over an agent's knowledge of a large map
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include "Benchmark.h"
+#include "../WumpusWorld/Agent.h"
+#include "../WumpusWorld/PathPlanner.h"
+
+using namespace fullsail_ai::fundamentals;
+using namespace fullsail_ai::benchmark;
+
+namespace {
+
+	bool isSafe(Knowledge const& knowledge, unsigned x, unsigned y)
+	{
+		return knowledge.modelWorld.contains(x, y) && knowledge.modelWorld(x, y) == Knowledge::CLEAR;
+	}
+
+	// Checks that path leads from the start to the goal in single steps over safe cells.
+	void verifyPath(Knowledge const& knowledge, unsigned startX, unsigned startY, unsigned goal,
+	                std::vector<unsigned> const& path)
+	{
+		unsigned height = knowledge.modelWorld.getHeight(), x = startX, y = startY;
+
+		if (path.empty() || path.front() != goal)
+			fail("A planned path does not end at its goal!");
+
+		for (std::size_t index = path.size(); index-- > 0; )
+		{
+			unsigned nextX = path[index] / height, nextY = path[index] % height;
+
+			if ((nextX > x ? nextX - x : x - nextX) + (nextY > y ? nextY - y : y - nextY) != 1 || !isSafe(knowledge, nextX, nextY))
+				fail("A planned path leaves the safe cells or skips a cell!");
+
+			x = nextX;
+			y = nextY;
+		}
+	}
+
+	// Knowledge of a size x size map in which every cell is CLEAR but a random fraction.
+	void prepareKnowledge(Knowledge& knowledge, unsigned size, unsigned blockedPercent, unsigned seed)
+	{
+		unsigned state = seed * 2654435761u + 1;
+
+		knowledge.init(0, 0, size, size);
+
+		for (unsigned x = 0; x < size; x++)
+			for (unsigned y = 0; y < size; y++)
+			{
+				state = state * 1664525u + 1013904223u;
+
+				if ((state >> 8) % 100 >= blockedPercent)
+					knowledge.modelWorld(x, y) = Knowledge::CLEAR;
+			}
+	}
+
+	// Returns a safe cell near (x, y), searching along the diagonal toward the center.
+	unsigned safeCellNear(Knowledge const& knowledge, unsigned x, unsigned y)
+	{
+		unsigned size = knowledge.modelWorld.getWidth();
+
+		while (!isSafe(knowledge, x, y))
+		{
+			x += (x < size / 2) ? 1 : -1;
+			y += (y < size / 2) ? 1 : -1;
+		}
+
+		return x * size + y;
+	}
+
+	void plannerLatency(unsigned blockedPercent)
+	{
+		unsigned const size = isQuick() ? 512 : 2048;
+		unsigned const pairs = 4;
+		Knowledge knowledge;
+		PathPlanner jumpPoint(true), plain(false);
+		std::vector<unsigned> jumpPath, plainPath;
+		double jumpSeconds = 0, plainSeconds = 0, repairSeconds = 0;
+		std::size_t jumpExpanded = 0, plainExpanded = 0, repairExpanded = 0;
+		unsigned repairs = 0;
+		char name[64];
+
+		prepareKnowledge(knowledge, size, blockedPercent, 1);
+
+		unsigned corners[4][2] = { {0, 0}, {size - 1, size - 1}, {0, size - 1}, {size - 1, 0} };
+
+		// The first searches size the arenas; the timed ones reuse them.
+		unsigned warmStart = safeCellNear(knowledge, 0, 0), warmGoal = safeCellNear(knowledge, 8, 8);
+		jumpPoint.findPath(knowledge, warmStart / size, warmStart % size, warmGoal / size, warmGoal % size, jumpPath);
+		plain.findPath(knowledge, warmStart / size, warmStart % size, warmGoal / size, warmGoal % size, plainPath);
+
+		for (unsigned pair = 0; pair < pairs; pair++)
+		{
+			unsigned start = safeCellNear(knowledge, corners[pair][0], corners[pair][1]);
+			unsigned goal = safeCellNear(knowledge, corners[pair ^ 1][0], corners[pair ^ 1][1]);
+			unsigned startX = start / size, startY = start % size;
+
+			Timer timer;
+			bool jumpFound = jumpPoint.findPath(knowledge, startX, startY, goal / size, goal % size, jumpPath);
+			jumpSeconds += timer.getSeconds();
+			jumpExpanded += jumpPoint.getExpandedCount();
+
+			timer.restart();
+			bool plainFound = plain.findPath(knowledge, startX, startY, goal / size, goal % size, plainPath);
+			plainSeconds += timer.getSeconds();
+			plainExpanded += plain.getExpandedCount();
+
+			if (jumpFound != plainFound || jumpPath.size() != plainPath.size())
+				fail("Jump Point Search and A* disagree on the shortest path!");
+
+			if (!jumpFound)
+				continue;
+
+			verifyPath(knowledge, startX, startY, goal, jumpPath);
+			verifyPath(knowledge, startX, startY, goal, plainPath);
+
+			// Knock the agent off its path, a third of the way along, and reconnect it.
+			unsigned onPath = jumpPath[jumpPath.size() * 2 / 3];
+			unsigned offX = onPath / size, offY = onPath % size;
+			int const offset[4][2] = { {-1, 0}, {1, 0}, {0, -1}, {0, 1} };
+
+			for (int index = 0; index < 4; index++)
+			{
+				unsigned x = onPath / size + offset[index][0], y = onPath % size + offset[index][1];
+				bool used = false;
+
+				for (std::size_t member = 0; member < jumpPath.size() && !used; member++)
+					used = (jumpPath[member] == x * size + y);
+
+				if (isSafe(knowledge, x, y) && !used)
+				{
+					offX = x;
+					offY = y;
+					break;
+				}
+			}
+
+			timer.restart();
+			bool repaired = jumpPoint.repairPath(knowledge, offX, offY, jumpPath);
+			repairSeconds += timer.getSeconds();
+			repairExpanded += jumpPoint.getExpandedCount();
+			repairs++;
+
+			if (!repaired)
+				fail("A path could not be repaired!");
+
+			verifyPath(knowledge, offX, offY, goal, jumpPath);
+		}
+
+		std::printf("  %u%% blocked: %u of %u goals reachable; cells closed per search: jump points %u, A* %u, repair %u\n",
+		            blockedPercent, repairs, pairs, (unsigned)(jumpExpanded / pairs), (unsigned)(plainExpanded / pairs),
+		            (unsigned)(repairExpanded / (repairs ? repairs : 1)));
+		std::snprintf(name, sizeof(name), "planner/jps/%ux%u/%u%%", size, size, blockedPercent);
+		report(name, pairs, jumpSeconds);
+		std::snprintf(name, sizeof(name), "planner/astar/%ux%u/%u%%", size, size, blockedPercent);
+		report(name, pairs, plainSeconds);
+		std::snprintf(name, sizeof(name), "planner/repair/%ux%u/%u%%", size, size, blockedPercent);
+		report(name, repairs, repairSeconds);
+	}
+
+	void pathPlanner()
+	{
+		plannerLatency(0);
+		plannerLatency(10);
+		plannerLatency(30);
+	}
+}
+
+FULLSAIL_BENCHMARK(pathPlanner);
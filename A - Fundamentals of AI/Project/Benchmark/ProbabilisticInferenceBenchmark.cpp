@@ -0,0 +1,257 @@
+// ProbabilisticInferenceBenchmark.cpp - exact pit/wumpus probabilities over explored regions of generated maps
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <queue>
+#include <vector>
+#include "Benchmark.h"
+#include "../WumpusWorld/Agent.h"
+#include "../WumpusWorld/WorldGenerator.h"
+
+using namespace fullsail_ai::fundamentals;
+using namespace fullsail_ai::benchmark;
+
+namespace {
+
+	int const offset[4][2] = { {-1, 0}, {1, 0}, {0, -1}, {0, 1} };
+
+	// Perceives up to cellLimit cells reachable from the start without entering a pit or
+	// the wumpus, breadth first; stops at the breezes and stenches unless enterDanger is
+	// set, so the explored region grows a ragged frontier like an agent's.
+	void explore(Knowledge& knowledge, std::vector<char> const& cells, unsigned width, unsigned height,
+	             std::size_t cellLimit, bool enterDanger)
+	{
+		std::vector<bool> queued(cells.size(), false);
+		std::queue<unsigned> open;
+		std::size_t explored = 0;
+
+		for (unsigned cell = 0; cell < cells.size(); cell++)
+			if (cells[cell] & START)
+			{
+				knowledge.init(cell / height, cell % height, width, height);
+				open.push(cell);
+				queued[cell] = true;
+			}
+
+		while (!open.empty() && explored < cellLimit)
+		{
+			unsigned cell = open.front(), x = cell / height, y = cell % height;
+
+			open.pop();
+			knowledge.perceive(x, y, cells[cell]);
+			explored++;
+
+			if ((cells[cell] & (BREEZE | STENCH)) && !enterDanger)
+				continue;
+
+			for (int direction = 0; direction < 4; direction++)
+			{
+				unsigned newX = x + offset[direction][0], newY = y + offset[direction][1];
+				unsigned newCell = newX * height + newY;
+
+				if (newX < width && newY < height && !queued[newCell] && !(cells[newCell] & (PIT | WUMPUS)))
+				{
+					queued[newCell] = true;
+					open.push(newCell);
+				}
+			}
+		}
+	}
+
+	// Brute force over every pit assignment of the frontier and every wumpus position.
+	void verifyAgainstEnumeration(Knowledge const& knowledge, ProbabilisticInference const& inference,
+	                              unsigned width, unsigned height, double pitProbability)
+	{
+		std::vector<unsigned> frontier;
+		std::vector<double> pitWeight, wumpusWeight(width * height, 0.0);
+		double pitTotal = 0, wumpusTotal = 0;
+
+		for (unsigned x = 0; x < width; x++)
+			for (unsigned y = 0; y < height; y++)
+			{
+				if (knowledge.explored.contains(x * height + y))
+					continue;
+
+				for (int direction = 0; direction < 4; direction++)
+				{
+					unsigned newX = x + offset[direction][0], newY = y + offset[direction][1];
+
+					if (newX < width && newY < height && knowledge.explored.contains(newX * height + newY))
+					{
+						frontier.push_back(x * height + y);
+						break;
+					}
+				}
+			}
+
+		if (frontier.size() != inference.getFrontierSize())
+			fail("The inference engine miscounted the frontier!");
+
+		pitWeight.assign(frontier.size(), 0.0);
+
+		for (unsigned long long assignment = 0; assignment < (1ull << frontier.size()); assignment++)
+		{
+			bool consistent = true;
+			double weight = 1;
+
+			for (std::size_t index = 0; index < frontier.size(); index++)
+				weight *= ((assignment >> index) & 1) ? pitProbability : 1 - pitProbability;
+
+			for (std::size_t index = 0; index < knowledge.explored.size() && consistent; index++)
+			{
+				unsigned cell = knowledge.explored[index], x = cell / height, y = cell % height;
+				bool pitNearby = false;
+
+				for (std::size_t member = 0; member < frontier.size(); member++)
+				{
+					unsigned frontierX = frontier[member] / height, frontierY = frontier[member] % height;
+
+					if (((assignment >> member) & 1) && std::abs((int)frontierX - (int)x) + std::abs((int)frontierY - (int)y) == 1)
+						pitNearby = true;
+				}
+
+				consistent = (pitNearby == ((knowledge.stimulus(x, y) & BREEZE) != 0));
+			}
+
+			if (!consistent)
+				continue;
+
+			pitTotal += weight;
+
+			for (std::size_t index = 0; index < frontier.size(); index++)
+				if ((assignment >> index) & 1)
+					pitWeight[index] += weight;
+		}
+
+		for (std::size_t index = 0; index < frontier.size(); index++)
+		{
+			unsigned x = frontier[index] / height, y = frontier[index] % height;
+
+			if (std::fabs(pitWeight[index] / pitTotal - inference.getPitProbability(x, y)) > 1e-9)
+				fail("A pit probability differs from brute-force enumeration!");
+		}
+
+		for (unsigned cell = 0; cell < width * height; cell++)
+		{
+			unsigned x = cell / height, y = cell % height;
+			bool consistent = !knowledge.explored.contains(cell);
+
+			for (std::size_t index = 0; index < knowledge.explored.size() && consistent; index++)
+			{
+				unsigned explored = knowledge.explored[index], exploredX = explored / height, exploredY = explored % height;
+				bool adjacent = std::abs((int)exploredX - (int)x) + std::abs((int)exploredY - (int)y) == 1;
+
+				consistent = (adjacent == ((knowledge.stimulus(exploredX, exploredY) & STENCH) != 0));
+			}
+
+			wumpusWeight[cell] = consistent ? 1 : 0;
+			wumpusTotal += wumpusWeight[cell];
+		}
+
+		for (unsigned cell = 0; cell < width * height; cell++)
+			if (std::fabs(wumpusWeight[cell] / wumpusTotal - inference.getWumpusProbability(cell / height, cell % height)) > 1e-9)
+				fail("A wumpus probability differs from brute-force enumeration!");
+	}
+
+	void probabilisticInferenceVerify()
+	{
+		unsigned const size = 7;
+		unsigned const worlds = isQuick() ? 100 : 1000;
+		WorldGenerator generator(size, size);
+		std::vector<char> cells(generator.getCellCount());
+		ProbabilisticInference inference;
+		unsigned checked = 0;
+
+		for (unsigned seed = 0; seed < worlds; seed++)
+		{
+			Knowledge knowledge;
+
+			generator.generate(seed, &cells[0]);
+			explore(knowledge, cells, size, size, 1 + seed % 12, seed % 3 == 0);
+			inference.update(knowledge);
+
+			// Enumeration is exponential in the frontier.
+			if (inference.getFrontierSize() > 14)
+				continue;
+
+			verifyAgainstEnumeration(knowledge, inference, size, size, 0.2);
+			checked++;
+		}
+
+		std::printf("  %u explored regions matched brute-force enumeration; memo hits %u, misses %u\n", checked,
+		            (unsigned)inference.getCacheHits(), (unsigned)inference.getCacheMisses());
+	}
+
+	// Cold updates enumerate every component; warm ones follow a single newly explored cell.
+	void probabilisticInferenceLatency()
+	{
+		unsigned const sizes[] = { 64, 256 };
+		std::size_t const cellLimits[] = { 1000, 20000 };
+		unsigned const maps = isQuick() ? 2 : 10;
+		char name[64];
+
+		for (int sizeIndex = 0; sizeIndex < 2; sizeIndex++)
+		{
+			unsigned const size = sizes[sizeIndex];
+			WorldGenerator generator(size, size, 0.1);
+			std::vector<char> cells(generator.getCellCount());
+			ProbabilisticInference inference(0.1);
+			double coldSeconds = 0, warmSeconds = 0;
+			std::size_t frontier = 0, components = 0, largest = 0;
+
+			for (unsigned seed = 0; seed < maps; seed++)
+			{
+				Knowledge knowledge;
+
+				generator.generate(seed, &cells[0]);
+				explore(knowledge, cells, size, size, cellLimits[sizeIndex], false);
+				inference.clearCache();
+
+				Timer timer;
+				inference.update(knowledge);
+				coldSeconds += timer.getSeconds();
+
+				frontier += inference.getFrontierSize();
+				components += inference.getComponentCount();
+				largest = std::max(largest, inference.getLargestComponent());
+
+				// Step onto the least risky unexplored cell next to the explored region.
+				unsigned best = 0;
+				double bestRisk = 2;
+
+				for (std::size_t index = 0; index < knowledge.explored.size(); index++)
+				{
+					unsigned cell = knowledge.explored[index], x = cell / size, y = cell % size;
+
+					for (int direction = 0; direction < 4; direction++)
+					{
+						unsigned newX = x + offset[direction][0], newY = y + offset[direction][1];
+
+						if (newX < size && newY < size && !knowledge.explored.contains(newX * size + newY)
+						    && inference.getRisk(newX, newY) < bestRisk)
+						{
+							best = newX * size + newY;
+							bestRisk = inference.getRisk(newX, newY);
+						}
+					}
+				}
+
+				knowledge.perceive(best / size, best % size, cells[best]);
+				timer.restart();
+				inference.update(knowledge);
+				warmSeconds += timer.getSeconds();
+			}
+
+			std::printf("  %ux%u: %u frontier cells and %u components per map on average, largest component %u cells\n",
+			            size, size, (unsigned)(frontier / maps), (unsigned)(components / maps), (unsigned)largest);
+			std::snprintf(name, sizeof(name), "inference/probabilities/cold/%ux%u", size, size);
+			report(name, maps, coldSeconds);
+			std::snprintf(name, sizeof(name), "inference/probabilities/warm/%ux%u", size, size);
+			report(name, maps, warmSeconds);
+		}
+	}
+}
+
+FULLSAIL_BENCHMARK(probabilisticInferenceVerify);
+FULLSAIL_BENCHMARK(probabilisticInferenceLatency);
@@ -0,0 +1,203 @@
+// QueueBenchmark.cpp - compares the linked QueueList with the contiguous RingQueue
+#include <cstdio>
+#include "Benchmark.h"
+#include "../QueueList/QueueList.h"
+#include "../QueueList/RingQueue.h"
+
+using namespace fullsail_ai::fundamentals;
+using namespace fullsail_ai::benchmark;
+
+namespace {
+
+	unsigned const sizes[] = { 1000, 100000, 10000000 };
+
+	// Fills the queue to the requested size, then drains it.
+	template <template <typename> class Queue>
+	void fillAndDrain(char const* queueName, unsigned size)
+	{
+		unsigned long long total = 10000000ULL;
+		unsigned repeat = (unsigned)(total / size);
+		Queue<unsigned> queue;
+		unsigned long long sum = 0;
+
+		// Warm-up pass, so the pool or buffer is already sized.
+		for (unsigned index = 0; index < size; ++index)
+			queue.enqueue(index);
+		queue.removeAll();
+
+		Timer timer;
+
+		for (unsigned pass = 0; pass < repeat; ++pass)
+		{
+			for (unsigned index = 0; index < size; ++index)
+				queue.enqueue(index);
+
+			while (!queue.isEmpty())
+			{
+				sum += queue.getFront();
+				queue.dequeue();
+			}
+		}
+
+		double seconds = timer.getSeconds();
+		keep(sum);
+
+		char name[64];
+		std::snprintf(name, sizeof(name), "%s/fill_drain/%u", queueName, size);
+		report(name, 2ULL * size * repeat, seconds);
+	}
+
+	// Breadth-first style: every dequeued element enqueues its successor,
+	// so the queue stays at the requested width while the contents rotate.
+	template <template <typename> class Queue>
+	void rotate(char const* queueName, unsigned size)
+	{
+		unsigned long long operations = 10000000ULL;
+		Queue<unsigned> queue;
+		unsigned long long sum = 0;
+
+		for (unsigned index = 0; index < size; ++index)
+			queue.enqueue(index);
+
+		Timer timer;
+
+		for (unsigned long long step = 0; step < operations; ++step)
+		{
+			unsigned front = queue.getFront();
+			queue.dequeue();
+			queue.enqueue(front + 1);
+			sum += front;
+		}
+
+		double seconds = timer.getSeconds();
+		keep(sum);
+
+		char name[64];
+		std::snprintf(name, sizeof(name), "%s/rotate/%u", queueName, size);
+		report(name, operations, seconds);
+	}
+
+	// Both searches are linear, so these sizes stay small.
+	unsigned const searchSizes[] = { 100, 1000, 10000 };
+
+	// Looks up elements spread over the whole queue, then removes every element in a
+	// scattered order (each step searches what is left).
+	template <template <typename> class Queue>
+	void containsAndRemove(char const* queueName, unsigned size)
+	{
+		unsigned long long lookups = 10000000ULL / size;
+		Queue<unsigned> queue;
+		unsigned long long found = 0;
+		char name[64];
+
+		// Odd elements only. 7919 is odd, so odd lookups hit and even ones miss, scanning
+		// the whole queue.
+		for (unsigned index = 0; index < size; ++index)
+			queue.enqueue(2 * index + 1);
+
+		Timer timer;
+
+		for (unsigned long long lookup = 0; lookup < lookups; ++lookup)
+			found += queue.contains((unsigned)(lookup * 7919 % (2 * size))) ? 1 : 0;
+
+		double seconds = timer.getSeconds();
+
+		if (found != lookups / 2)
+			fail("%s::contains found %llu of %llu elements!", queueName, found, lookups);
+
+		std::snprintf(name, sizeof(name), "%s/contains/%u", queueName, size);
+		report(name, lookups, seconds);
+
+		// 7919 is prime, so stepping by it modulo a smaller size visits every element once.
+		timer.restart();
+
+		for (unsigned index = 0; index < size; ++index)
+			queue.remove(2 * (unsigned)((index * 7919ULL) % size) + 1);
+
+		seconds = timer.getSeconds();
+
+		if (!queue.isEmpty())
+			fail("%s::remove left elements behind!", queueName);
+
+		std::snprintf(name, sizeof(name), "%s/remove/%u", queueName, size);
+		report(name, size, seconds);
+	}
+
+	template <template <typename> class Queue>
+	void runAll(char const* queueName)
+	{
+		unsigned count = isQuick() ? 2 : sizeof(sizes) / sizeof(sizes[0]);
+
+		for (unsigned index = 0; index < count; ++index)
+		{
+			fillAndDrain<Queue>(queueName, sizes[index]);
+			rotate<Queue>(queueName, sizes[index]);
+		}
+
+		count = isQuick() ? 2 : sizeof(searchSizes) / sizeof(searchSizes[0]);
+
+		for (unsigned index = 0; index < count; ++index)
+			containsAndRemove<Queue>(queueName, searchSizes[index]);
+	}
+
+	void queueList()
+	{
+		runAll<QueueList>("QueueList");
+	}
+
+	// Throws when built from zero, so that an enqueue can fail partway.
+	struct Fragile
+	{
+		unsigned value;
+
+		explicit Fragile(unsigned _value) : value(_value)
+		{
+			if (!_value)
+				throw 0;
+		}
+	};
+
+	// An element that throws while the buffer grows must leave the queue as it was, and
+	// the new buffer freed (which the sanitizer build checks).
+	void verifyThrowingGrowth()
+	{
+		unsigned const size = 16;
+		RingQueue<Fragile> queue;
+		queue.reserve(size);
+
+		for (unsigned index = 1; index <= size; ++index)
+			queue.emplace(index);
+
+		try
+		{
+			queue.emplace(0u);
+			fail("RingQueue::emplace swallowed an exception!");
+		}
+		catch (int)
+		{
+		}
+
+		queue.emplace(size + 1);
+		unsigned expected = 1;
+
+		for (; !queue.isEmpty(); ++expected)
+		{
+			if (queue.getFront().value != expected)
+				fail("A throwing RingQueue::emplace changed the queue!");
+
+			queue.dequeue();
+		}
+
+		if (expected != size + 2)
+			fail("A throwing RingQueue::emplace changed the queue!");
+	}
+
+	void ringQueue()
+	{
+		verifyThrowingGrowth();
+		runAll<RingQueue>("RingQueue");
+	}
+}
+
+FULLSAIL_BENCHMARK(queueList);
+FULLSAIL_BENCHMARK(ringQueue);
@@ -0,0 +1,111 @@
+// SimulationBenchmark.cpp - Agent::update episodes by world size, and how the headless episode
+// runner scales with the number of threads
+#include <cstdio>
+#include <thread>
+#include <vector>
+#include "Benchmark.h"
+#include "SyntheticTree.h"
+#include "../BehaviorTree/BehaviorArena.h"
+#include "../WumpusWorld/Agent.h"
+#include "../WumpusWorld/Behaviors.h"
+#include "../WumpusWorld/Simulation.h"
+#include "../WumpusWorld/WorldGenerator.h"
+
+using namespace fullsail_ai::fundamentals;
+using namespace fullsail_ai::benchmark;
+
+namespace {
+
+	void simulationScaling()
+	{
+		unsigned const episodes = isQuick() ? 500 : 5000;
+		unsigned const maximumThreads = 64;
+		Simulation simulation(16, 1000);
+		std::vector<unsigned> seeds(episodes);
+		SimulationStatistics expected;
+		char name[64];
+
+		for (unsigned index = 0; index < episodes; index++)
+			seeds[index] = index;
+
+		std::printf("hardware threads: %u\n", std::thread::hardware_concurrency());
+
+		for (unsigned threads = 1; threads <= maximumThreads; threads *= 2)
+		{
+			WorkStealingPool pool(threads);
+			Timer timer;
+			SimulationStatistics statistics = simulation.run(seeds, pool);
+			double seconds = timer.getSeconds();
+
+			std::snprintf(name, sizeof(name), "simulation/episodes/%u-threads", threads);
+			report(name, episodes, seconds);
+
+			// Scheduling must not change the totals.
+			if (threads == 1)
+				expected = statistics;
+			else if (statistics.wins != expected.wins || statistics.deaths != expected.deaths
+			         || statistics.ticks != expected.ticks)
+				fail("The totals with %u threads differ from the single-threaded run!", threads);
+		}
+
+		std::printf("wins %u, deaths %u, gold %u, wumpus killed %u, timeouts %u of %u\n", expected.wins,
+		            expected.deaths, expected.goldRetrieved, expected.wumpusKilled, expected.timeouts, expected.episodes);
+	}
+
+	// Times only the agent's updates: the worlds are generated before the clock starts.
+	void agentEpisodes(unsigned worldSize)
+	{
+		unsigned const tickLimit = 1000, episodes = isQuick() ? 100 : 1000;
+		WorldGenerator generator(worldSize, worldSize);
+		std::vector<char> cells(generator.getCellCount() * episodes);
+		Simulation simulation(worldSize, tickLimit);
+		BehaviorArena arena;
+		Behavior* behavior = createBasicBehavior(arena);
+		unsigned long long ticks = 0, expectedTicks = 0;
+		double seconds = 0;
+		char name[64];
+
+		for (unsigned seed = 0; seed < episodes; seed++)
+			generator.generate(seed, &cells[seed * generator.getCellCount()]);
+
+		for (unsigned seed = 0; seed < episodes; seed++)
+		{
+			World world(&cells[seed * generator.getCellCount()], worldSize, worldSize);
+			Agent agent(world, *behavior, ignoreBehavior);
+			unsigned episodeTicks = 0;
+
+			agent.enter(world.getAgentX(), world.getAgentY());
+			Timer timer;
+
+			while (world.isAgentAlive() && world.doesAgentHaveArrow() && episodeTicks < tickLimit)
+			{
+				agent.update();
+				episodeTicks++;
+			}
+
+			seconds += timer.getSeconds();
+			agent.exit();
+			ticks += episodeTicks;
+			expectedTicks += simulation.runEpisode(seed, *behavior).ticks;
+		}
+
+		if (ticks != expectedTicks)
+			fail("The %ux%u episodes took %llu ticks instead of the simulation's %llu!", worldSize,
+			     worldSize, ticks, expectedTicks);
+
+		std::printf("  %ux%u: %u episodes, %llu ticks\n", worldSize, worldSize, episodes, ticks);
+		std::snprintf(name, sizeof(name), "agent/update/%ux%u", worldSize, worldSize);
+		report(name, ticks, seconds);
+	}
+
+	void agentUpdate()
+	{
+		unsigned const sizes[] = { 4, 8, 16, 32 };
+
+		for (size_t index = 0; index < sizeof(sizes) / sizeof(sizes[0]); index++)
+			agentEpisodes(sizes[index]);
+	}
+}
+
+FULLSAIL_BENCHMARK(agentUpdate);
+FULLSAIL_BENCHMARK(simulationScaling);
@@ -0,0 +1,117 @@
+// SyntheticTree.cpp - generators of synthetic behavior trees for the benchmarks
+#include <utility>
+#include <vector>
+#include "SyntheticTree.h"
+#include "../BehaviorTree/BehaviorArena.h"
+#include "../WumpusWorld/Behaviors.h"
+
+using namespace fullsail_ai::fundamentals;
+
+namespace fullsail_ai { namespace benchmark {
+
+	namespace {
+		unsigned nextRandom(unsigned& state)
+		{
+			state = state * 1664525u + 1013904223u;
+			return state >> 16;
+		}
+
+		// Builds nodes with new; BehaviorArena builds them in place.
+		struct HeapBuilder
+		{
+			template <typename T, typename... Arguments>
+			T* create(Arguments&&... arguments)
+			{
+				return new T(std::forward<Arguments>(arguments)...);
+			}
+		};
+
+		template <typename Builder>
+		Behavior* buildLevel(unsigned depth, unsigned fanOut, bool selector, unsigned& state, Builder& builder)
+		{
+			if (depth == 0)
+				return builder.template create<TestBehavior>("Leaf", (nextRandom(state) & 1) != 0);
+
+			Behavior* node = selector ? (Behavior*)builder.template create<Selector>("Selector")
+			                          : (Behavior*)builder.template create<Sequence>("Sequence");
+
+			for (unsigned index = 0; index < fanOut; ++index)
+				node->addChild(buildLevel(depth - 1, fanOut, !selector, state, builder));
+
+			return node;
+		}
+
+		template <typename Builder>
+		Behavior* buildChain(unsigned depth, Builder& builder)
+		{
+			Behavior* root = builder.template create<Sequence>("Chain");
+			Behavior* current = root;
+
+			for (unsigned level = 1; level < depth; ++level)
+			{
+				Behavior* next = builder.template create<Sequence>("Chain");
+				current->addChild(builder.template create<TestBehavior>("Step", true));
+				current->addChild(next);
+				current = next;
+			}
+
+			current->addChild(builder.template create<TestBehavior>("Step", true));
+			return root;
+		}
+	}
+
+	Behavior* buildBalancedTree(unsigned depth, unsigned fanOut, unsigned seed)
+	{
+		HeapBuilder builder;
+		return buildLevel(depth, fanOut, true, seed, builder);
+	}
+
+	Behavior* buildBalancedTree(unsigned depth, unsigned fanOut, unsigned seed, BehaviorArena& arena)
+	{
+		return buildLevel(depth, fanOut, true, seed, arena);
+	}
+
+	Behavior* buildChainTree(unsigned depth)
+	{
+		HeapBuilder builder;
+		return buildChain(depth, builder);
+	}
+
+	Behavior* buildChainTree(unsigned depth, BehaviorArena& arena)
+	{
+		return buildChain(depth, arena);
+	}
+
+	void deleteTree(Behavior* root)
+	{
+		std::vector<Behavior*> pending(1, root);
+
+		while (!pending.empty())
+		{
+			Behavior* current = pending.back();
+			pending.pop_back();
+
+			for (size_t index = 0; index < current->getChildCount(); index++)
+				pending.push_back(current->getChild(index));
+
+			delete current;
+		}
+	}
+
+	void ignoreBehavior(Behavior const*)
+	{
+	}
+
+	std::vector<Behavior const*> recordedBehaviors;
+	std::vector<char const*> recordedNames;
+
+	void recordBehavior(Behavior const* behavior)
+	{
+		recordedBehaviors.push_back(behavior);
+	}
+
+	void recordName(Behavior const* behavior)
+	{
+		recordedNames.push_back(behavior->toString());
+	}
+}}  // namespace fullsail_ai::benchmark
@@ -0,0 +1,54 @@
+//! \file SyntheticTree.h
+//! \brief Declares generators of synthetic behavior trees for the benchmarks.
+#ifndef _FULLSAIL_AI_FUNDAMENTALS_SYNTHETIC_TREE_H_
+#define _FULLSAIL_AI_FUNDAMENTALS_SYNTHETIC_TREE_H_
+
+#include <vector>
+#include "../BehaviorTree/Behavior.h"
+
+namespace fullsail_ai { namespace fundamentals {
+
+	class BehaviorArena;
+}}  // namespace fullsail_ai::fundamentals
+
+namespace fullsail_ai { namespace benchmark {
+
+	//! \brief Builds a complete tree with the given depth and fan-out. Levels alternate
+	//! between selectors and sequences, and every leaf is a <code>TestBehavior</code>
+	//! that succeeds with probability one half (drawn from \a seed).
+	fundamentals::Behavior* buildBalancedTree(unsigned depth, unsigned fanOut, unsigned seed);
+
+	//! \brief Builds the same tree in \a arena, which owns its nodes.
+	fundamentals::Behavior* buildBalancedTree(unsigned depth, unsigned fanOut, unsigned seed, fundamentals::BehaviorArena& arena);
+
+	//! \brief Builds a chain of \a depth sequences, each holding a succeeding leaf followed
+	//! by the next sequence, so a tick walks the whole chain.
+	fundamentals::Behavior* buildChainTree(unsigned depth);
+
+	//! \brief Builds the same chain in \a arena, which owns its nodes.
+	fundamentals::Behavior* buildChainTree(unsigned depth, fundamentals::BehaviorArena& arena);
+
+	//! \brief Deletes a tree built with <code>new</code> by one of the functions above.
+	void deleteTree(fundamentals::Behavior* root);
+
+	//! \brief A <code>dataFunction</code> that does nothing.
+	void ignoreBehavior(fundamentals::Behavior const* behavior);
+
+	//! \brief The nodes <code>recordBehavior()</code> was given, in order. Clear it
+	//! before each run that records.
+	extern std::vector<fundamentals::Behavior const*> recordedBehaviors;
+
+	//! \brief A <code>dataFunction</code> that appends \a behavior to
+	//! <code>recordedBehaviors</code>.
+	void recordBehavior(fundamentals::Behavior const* behavior);
+
+	//! \brief The names of the nodes <code>recordName()</code> was given, in order, for
+	//! comparing trees made of different nodes.
+	extern std::vector<char const*> recordedNames;
+
+	//! \brief A <code>dataFunction</code> that appends the name of \a behavior to
+	//! <code>recordedNames</code>.
+	void recordName(fundamentals::Behavior const* behavior);
+}}  // namespace fullsail_ai::benchmark
+
+#endif  // _FULLSAIL_AI_FUNDAMENTALS_SYNTHETIC_TREE_H_
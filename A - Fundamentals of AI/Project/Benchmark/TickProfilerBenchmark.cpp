@@ -0,0 +1,250 @@
+// TickProfilerBenchmark.cpp - what the per-node tick profiler records, and what it costs a tick
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Benchmark.h"
+#include "SyntheticTree.h"
+#include "../BehaviorTree/TickProfiler.h"
+#include "../WumpusWorld/Agent.h"
+#include "../WumpusWorld/Behaviors.h"
+#include "../WumpusWorld/WorldGenerator.h"
+
+using namespace fullsail_ai::fundamentals;
+using namespace fullsail_ai::benchmark;
+
+namespace {
+
+#if defined(FULLSAIL_PROFILE_TICKS)
+	std::map<Behavior const*, unsigned long long> reports;
+
+	void countBehavior(Behavior const* behavior)
+	{
+		reports[behavior]++;
+	}
+
+	std::map<Behavior const*, TickProfiler::NodeProfile> getProfiles()
+	{
+		std::vector<TickProfiler::NodeProfile> profiles = TickProfiler::getNodeProfiles();
+		std::map<Behavior const*, TickProfiler::NodeProfile> byNode;
+
+		for (size_t index = 0; index < profiles.size(); index++)
+			byNode[profiles[index].node] = profiles[index];
+
+		return byNode;
+	}
+
+	// Aborts unless the profile of \a ticks runs of \a root (on each of \a threads threads)
+	// matches what the tree reported, and its times add up.
+	void verify(Behavior* root, unsigned ticks, unsigned threads)
+	{
+		std::map<Behavior const*, TickProfiler::NodeProfile> profiles;
+		std::vector<Behavior const*> nodes;
+		double exclusiveSeconds = 0;
+
+		TickProfiler::reset();
+		reports.clear();
+
+		for (unsigned tick = 0; tick < ticks; tick++)
+			root->run(countBehavior, NULL);
+
+		std::vector<std::thread> workers;
+
+		for (unsigned thread = 1; thread < threads; thread++)
+		{
+			workers.push_back(std::thread([root, ticks]()
+			{
+				for (unsigned tick = 0; tick < ticks; tick++)
+					root->run(ignoreBehavior, NULL);
+			}));
+		}
+
+		for (size_t thread = 0; thread < workers.size(); thread++)
+			workers[thread].join();
+
+		profiles = getProfiles();
+		root->preOrderTraverse([&nodes](Behavior const* node) { nodes.push_back(node); });
+
+		if (profiles[root].invocations != (unsigned long long)ticks * threads)
+			fail("The profiler counted the wrong number of ticks of the root!");
+
+		for (size_t index = 0; index < nodes.size(); index++)
+		{
+			TickProfiler::NodeProfile const& profile = profiles[nodes[index]];
+
+			if (profile.invocations == 0)
+				continue;
+
+			if (profile.successes != reports[nodes[index]] * threads)
+				fail("The profiler's success count differs from the node's reports!");
+
+			if (profile.successes + profile.failures != profile.invocations)
+				fail("A node that never runs for long finished neither way!");
+
+			if (profile.exclusiveSeconds > profile.inclusiveSeconds * (1 + 1e-9))
+				fail("A node's exclusive time exceeds its inclusive time!");
+
+			exclusiveSeconds += profile.exclusiveSeconds;
+		}
+
+		if (std::fabs(exclusiveSeconds - profiles[root].inclusiveSeconds) > 1e-9 * profiles[root].inclusiveSeconds + 1e-12)
+			fail("The nodes' exclusive times do not add up to the root's inclusive time!");
+
+		// One path per node of a tree, each a line of the folded file.
+		std::ostringstream folded;
+		std::istringstream lines;
+		std::string line;
+		double nanoseconds = 0;
+		size_t count = 0;
+
+		TickProfiler::writeFoldedStacks(folded);
+		lines.str(folded.str());
+
+		while (std::getline(lines, line))
+		{
+			size_t space = line.rfind(' ');
+
+			if (space == std::string::npos || line.compare(0, std::string(root->toString()).size(), root->toString()) != 0)
+				fail("The folded stacks hold a line that does not start at the root!");
+
+			nanoseconds += std::strtod(line.c_str() + space + 1, NULL);
+			count++;
+		}
+
+		if (count == 0 || count > nodes.size()
+		    || std::fabs(nanoseconds - profiles[root].inclusiveSeconds * 1e9) > count)
+			fail("The folded stacks do not add up to the root's inclusive time!");
+	}
+
+	// The profile outlives the tree it saw: it is written from the names the nodes had,
+	// even once the nodes are gone and the strings they pointed at are overwritten.
+	void verifyDeletedTree()
+	{
+		std::vector<std::string> labels;
+
+		labels.push_back("Deleted Root");
+
+		for (unsigned index = 0; index < 4; index++)
+			labels.push_back("Deleted Leaf " + std::to_string(index));
+
+		Behavior* root = new Sequence(labels[0].c_str());
+
+		for (size_t index = 1; index < labels.size(); index++)
+			root->addChild(new TestBehavior(labels[index].c_str(), true));
+
+		TickProfiler::reset();
+
+		for (unsigned tick = 0; tick < 100; tick++)
+			root->run(ignoreBehavior, NULL);
+
+		std::ostringstream before, after;
+		std::vector<TickProfiler::NodeProfile> profiles;
+
+		TickProfiler::writeFoldedStacks(before);
+		deleteTree(root);
+
+		for (size_t index = 0; index < labels.size(); index++)
+			labels[index].assign(labels[index].size(), '?');
+
+		TickProfiler::writeFoldedStacks(after);
+		profiles = TickProfiler::getNodeProfiles();
+
+		if (after.str() != before.str() || after.str().find("Deleted Root;Deleted Leaf 3") == std::string::npos)
+			fail("The folded stacks changed once the tree was deleted!");
+
+		for (size_t index = 0; index < profiles.size(); index++)
+		{
+			if (profiles[index].name.compare(0, 8, "Deleted ") != 0)
+				fail("A node profile lost its node's name once the tree was deleted!");
+		}
+
+		TickProfiler::reset();
+	}
+
+	// Plays episodes through Agent::update(), which resumes long actions, and checks that
+	// every node the profile saw ran its own way.
+	void verifyAgents()
+	{
+		unsigned const worldSize = 8, tickLimit = 1000, episodes = 50;
+		WorldGenerator generator(worldSize, worldSize);
+		std::vector<char> cells(generator.getCellCount());
+		Behavior* behavior = createBasicBehavior();
+		unsigned long long ticks = 0;
+
+		TickProfiler::reset();
+
+		for (unsigned seed = 0; seed < episodes; seed++)
+		{
+			generator.generate(seed, &cells[0]);
+
+			World world(&cells[0], worldSize, worldSize);
+			Agent agent(world, *behavior, ignoreBehavior);
+
+			agent.enter(world.getAgentX(), world.getAgentY());
+
+			for (unsigned tick = 0; world.isAgentAlive() && world.doesAgentHaveArrow() && tick < tickLimit; tick++, ticks++)
+				agent.update();
+
+			agent.exit();
+		}
+
+		std::map<Behavior const*, TickProfiler::NodeProfile> profiles = getProfiles();
+
+		if (profiles[behavior].invocations != ticks)
+			fail("The profiler counted the wrong number of agent updates!");
+
+		for (std::map<Behavior const*, TickProfiler::NodeProfile>::const_iterator entry = profiles.begin();
+		     entry != profiles.end(); ++entry)
+		{
+			if (entry->second.successes + entry->second.failures > entry->second.invocations)
+				fail("A node finished more often than it ran!");
+		}
+
+		deleteTree(behavior);
+	}
+#endif
+
+	void tickProfiler()
+	{
+		unsigned const ticks = isQuick() ? 2000 : 20000, depth = 6, fanOut = 3;
+		Behavior* root = buildBalancedTree(depth, fanOut, 1);
+		char name[64];
+
+#if defined(FULLSAIL_PROFILE_TICKS)
+		bool const profiled = true;
+
+		verify(root, 100, 1);
+		verify(root, 100, 4);
+		verifyAgents();
+		verifyDeletedTree();
+#else
+		bool const profiled = false;
+#endif
+
+		TickProfiler::reset();
+		Timer timer;
+
+		for (unsigned tick = 0; tick < ticks; tick++)
+			keep(root->run(ignoreBehavior, NULL));
+
+		double seconds = timer.getSeconds();
+
+#if !defined(FULLSAIL_PROFILE_TICKS)
+		// Compiled out, the hooks record nothing at all.
+		if (!TickProfiler::getNodeProfiles().empty())
+			fail("The profiler recorded ticks in a build without it!");
+#endif
+
+		std::printf("  hooks %s (FUNDAMENTALS_PROFILE=%s)\n", profiled ? "compiled in" : "compiled out", profiled ? "ON" : "OFF");
+		std::snprintf(name, sizeof(name), "profiler/tick/%s/d%u-f%u", profiled ? "profiled" : "unprofiled", depth, fanOut);
+		report(name, ticks, seconds);
+
+		deleteTree(root);
+	}
+}
+
+FULLSAIL_BENCHMARK(tickProfiler);
@@ -0,0 +1,174 @@
+// TraceBenchmark.cpp - what recording a Chrome trace of agent updates writes, and what it costs
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Benchmark.h"
+#include "SyntheticTree.h"
+#include "../BehaviorTree/TraceRecorder.h"
+#include "../WumpusWorld/Agent.h"
+#include "../WumpusWorld/Behaviors.h"
+#include "../WumpusWorld/WorldGenerator.h"
+
+using namespace fullsail_ai::fundamentals;
+using namespace fullsail_ai::benchmark;
+
+namespace {
+
+	// Plays \a episodes episodes from seed \a first and returns the number of updates.
+	unsigned long long playEpisodes(Behavior& behavior, unsigned first, unsigned episodes)
+	{
+		unsigned const worldSize = 8, tickLimit = 1000;
+		WorldGenerator generator(worldSize, worldSize);
+		std::vector<char> cells(generator.getCellCount());
+		unsigned long long ticks = 0;
+
+		for (unsigned seed = first; seed < first + episodes; seed++)
+		{
+			generator.generate(seed, &cells[0]);
+
+			World world(&cells[0], worldSize, worldSize);
+			Agent agent(world, behavior, ignoreBehavior);
+
+			agent.enter(world.getAgentX(), world.getAgentY());
+
+			for (unsigned tick = 0; world.isAgentAlive() && world.doesAgentHaveArrow() && tick < tickLimit; tick++, ticks++)
+				agent.update();
+
+			agent.exit();
+		}
+
+		return ticks;
+	}
+
+	// Counts the complete events in the trace at \a path by name, and aborts unless the
+	// file is laid out as TraceRecorder writes it.
+	std::map<std::string, unsigned long long> readTrace(std::string const& path)
+	{
+		std::map<std::string, unsigned long long> counts;
+		std::ifstream file(path.c_str());
+		std::string line, last;
+
+		if (!std::getline(file, line) || line != "{\"traceEvents\":[")
+			fail("The trace does not start with its event array!");
+
+		while (std::getline(file, line))
+		{
+			if (line.find("\"ph\":\"X\"") != std::string::npos)
+			{
+				size_t begin = line.find("\"name\":\"") + 8;
+				counts[line.substr(begin, line.find('"', begin) - begin)]++;
+
+				// One object a line, each but the last followed by a comma.
+				size_t end = line.size() - (line[line.size() - 1] == ',' ? 1 : 0);
+
+				if (line[0] != '{' || line[end - 1] != '}')
+					fail("A trace event is not an element of the array!");
+			}
+
+			if (!line.empty())
+				last = line;
+		}
+
+		if (last.find("\"otherData\"") == std::string::npos || last[last.size() - 1] != '}')
+			fail("The trace was not closed!");
+
+		return counts;
+	}
+
+	// Every update, and the perceive and tree tick inside it, from several threads at once.
+	void verifyAgents(std::string const& path)
+	{
+		unsigned const threads = 4, episodes = isQuick() ? 25 : 100;
+		std::vector<std::thread> workers;
+		std::vector<unsigned long long> ticks(threads);
+		unsigned long long total = 0;
+		Behavior* behavior = createBasicBehavior();
+
+		if (!TraceRecorder::start(path.c_str(), 1 << 18))
+			fail("Could not start recording a trace!");
+
+		for (unsigned thread = 0; thread < threads; thread++)
+		{
+			workers.push_back(std::thread([&ticks, behavior, thread, episodes]()
+			{
+				ticks[thread] = playEpisodes(*behavior, thread * episodes, episodes);
+			}));
+		}
+
+		for (unsigned thread = 0; thread < threads; thread++)
+		{
+			workers[thread].join();
+			total += ticks[thread];
+		}
+
+		TraceRecorder::stop();
+		deleteTree(behavior);
+
+		std::map<std::string, unsigned long long> counts = readTrace(path);
+
+		if (TraceRecorder::getDroppedCount() != 0)
+			fail("Spans were dropped with rings large enough to hold them all!");
+
+		if (counts["Agent::update"] != total || counts["Agent::perceive"] != total || counts["Composite::resume"] != total)
+			fail("The trace does not hold a span for every update!");
+
+		if (counts["ProcessPercepts::run"] == 0 || counts["Agent::move"] == 0)
+			fail("The trace is missing the leaves' spans!");
+
+		std::printf("  %u threads, %llu updates, %llu moves, %llu shots, %llu pick-ups\n", threads, total,
+		            counts["Agent::move"], counts["Agent::shoot"], counts["Agent::pickUpGold"]);
+	}
+
+	// A ring too small to keep up drops spans, but counts every one it drops.
+	void verifyDrops(std::string const& path)
+	{
+		unsigned const spans = 100000;
+
+		if (!TraceRecorder::start(path.c_str(), 16))
+			fail("Could not start recording a trace!");
+
+		for (unsigned index = 0; index < spans; index++)
+			TraceSpan span("Dropped");
+
+		TraceRecorder::stop();
+
+		std::map<std::string, unsigned long long> counts = readTrace(path);
+
+		if (counts["Dropped"] + TraceRecorder::getDroppedCount() != spans)
+			fail("The trace lost spans without counting them as dropped!");
+	}
+
+	void traceRecorder()
+	{
+		unsigned const episodes = isQuick() ? 100 : 1000;
+		std::string path = (std::filesystem::temp_directory_path() / "fullsail_trace.json").string();
+		Behavior* behavior = createBasicBehavior();
+
+		verifyAgents(path);
+		verifyDrops(path);
+
+		Timer timer;
+		unsigned long long ticks = playEpisodes(*behavior, 0, episodes);
+		report("trace/agent-update/off", ticks, timer.getSeconds());
+
+		TraceRecorder::start(path.c_str());
+		timer.restart();
+		ticks = playEpisodes(*behavior, 0, episodes);
+		double seconds = timer.getSeconds();
+		TraceRecorder::stop();
+
+		std::printf("  %llu spans dropped, %ju bytes of trace\n", TraceRecorder::getDroppedCount(),
+		            (uintmax_t)std::filesystem::file_size(path));
+		report("trace/agent-update/on", ticks, seconds);
+
+		deleteTree(behavior);
+		std::filesystem::remove(path);
+	}
+}
+
+FULLSAIL_BENCHMARK(traceRecorder);
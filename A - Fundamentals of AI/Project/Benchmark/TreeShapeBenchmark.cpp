@@ -0,0 +1,155 @@
+// TreeShapeBenchmark.cpp - traversal and composite throughput across tree fan-outs and depths
+#include <cstdio>
+#include "Benchmark.h"
+#include "SyntheticTree.h"
+#include "../WumpusWorld/Behaviors.h"
+
+using namespace fullsail_ai::fundamentals;
+using namespace fullsail_ai::benchmark;
+
+namespace {
+
+	struct Shape
+	{
+		unsigned fanOut;
+		unsigned depth;
+	};
+
+	// A shallow and a deep tree for each fan-out; a quick pass keeps the shallow ones.
+	Shape const shapes[] = { { 2, 8 }, { 2, 16 }, { 4, 4 }, { 4, 8 }, { 8, 3 }, { 8, 6 }, { 16, 2 }, { 16, 4 } };
+
+	unsigned long long visitCount;
+
+	void countBehavior(Behavior const*)
+	{
+		visitCount++;
+	}
+
+	unsigned long long getNodeCount(Shape const& shape)
+	{
+		unsigned long long nodes = 0, level = 1;
+
+		for (unsigned depth = 0; depth <= shape.depth; depth++, level *= shape.fanOut)
+			nodes += level;
+
+		return nodes;
+	}
+
+	void traverse(char const* order, Shape const& shape, Behavior const* root,
+	              void (Behavior::*traversal)(void (*)(Behavior const*)) const)
+	{
+		unsigned long long nodes = getNodeCount(shape);
+		unsigned long long passes = ((isQuick() ? 1000000ULL : 10000000ULL) + nodes - 1) / nodes;
+		char name[64];
+
+		visitCount = 0;
+		Timer timer;
+
+		for (unsigned long long pass = 0; pass < passes; pass++)
+			(root->*traversal)(countBehavior);
+
+		double seconds = timer.getSeconds();
+
+		if (visitCount != nodes * passes)
+			fail("The %s traversal of a %u-way tree of depth %u visited %llu nodes instead of %llu!", order,
+			     shape.fanOut, shape.depth, visitCount, nodes * passes);
+
+		std::snprintf(name, sizeof(name), "traversal/%s/f%u-d%u", order, shape.fanOut, shape.depth);
+		report(name, visitCount, seconds);
+	}
+
+	void traversalShapes()
+	{
+		for (size_t index = 0; index < sizeof(shapes) / sizeof(shapes[0]); index++)
+		{
+			if (isQuick() && index % 2)
+				continue;
+
+			Behavior* root = buildBalancedTree(shapes[index].depth, shapes[index].fanOut, 1);
+
+			traverse("breadth-first", shapes[index], root, &Behavior::breadthFirstTraverse);
+			traverse("pre-order", shapes[index], root, &Behavior::preOrderTraverse);
+			traverse("post-order", shapes[index], root, &Behavior::postOrderTraverse);
+			deleteTree(root);
+		}
+	}
+
+	// A sequence of succeeding leaves and a selector of failing ones both run every child
+	// on every tick, so the time per child is the cost of the composite's loop and one call.
+	template <typename Composite>
+	void tickComposite(char const* compositeName, unsigned fanOut, bool leafValue)
+	{
+		unsigned const ticks = (isQuick() ? 200000 : 2000000) / fanOut;
+		Behavior* root = new Composite(compositeName);
+		unsigned long long children = 0;
+		bool expected = leafValue;
+		char name[64];
+
+		for (unsigned index = 0; index < fanOut; index++)
+			root->addChild(new TestBehavior("Leaf", leafValue));
+
+		Timer timer;
+
+		for (unsigned tick = 0; tick < ticks; tick++)
+		{
+			if (root->run(ignoreBehavior, NULL) != expected)
+				fail("A %s of %u leaves returned the wrong result!", compositeName, fanOut);
+
+			children += fanOut;
+		}
+
+		double seconds = timer.getSeconds();
+
+		std::snprintf(name, sizeof(name), "composite/%s/f%u", compositeName, fanOut);
+		report(name, children, seconds);
+		deleteTree(root);
+	}
+
+	// Mixed trees: levels alternate between selectors and sequences, with random leaves,
+	// so a tick stops early in some composites and reaches only part of the tree. Reported
+	// per tick.
+	void tickBalanced(Shape const& shape)
+	{
+		unsigned long long nodes = getNodeCount(shape);
+		unsigned long long ticks = ((isQuick() ? 10000000ULL : 100000000ULL) + nodes - 1) / nodes;
+		Behavior* root = buildBalancedTree(shape.depth, shape.fanOut, 1);
+		bool first = root->run(ignoreBehavior, NULL);
+		char name[64];
+
+		Timer timer;
+
+		for (unsigned long long tick = 0; tick < ticks; tick++)
+		{
+			if (root->run(ignoreBehavior, NULL) != first)
+				fail("A %u-way tree of depth %u changed its result between ticks!", shape.fanOut, shape.depth);
+		}
+
+		double seconds = timer.getSeconds();
+
+		std::snprintf(name, sizeof(name), "composite/mixed/f%u-d%u", shape.fanOut, shape.depth);
+		report(name, ticks, seconds);
+		deleteTree(root);
+	}
+
+	void compositeThroughput()
+	{
+		unsigned const fanOuts[] = { 2, 8, 32, 128 };
+
+		for (size_t index = 0; index < sizeof(fanOuts) / sizeof(fanOuts[0]); index++)
+		{
+			tickComposite<Sequence>("Sequence", fanOuts[index], true);
+			tickComposite<Selector>("Selector", fanOuts[index], false);
+		}
+
+		for (size_t index = 0; index < sizeof(shapes) / sizeof(shapes[0]); index++)
+		{
+			if (isQuick() && index % 2)
+				continue;
+
+			tickBalanced(shapes[index]);
+		}
+	}
+}
+
+FULLSAIL_BENCHMARK(traversalShapes);
+FULLSAIL_BENCHMARK(compositeThroughput);
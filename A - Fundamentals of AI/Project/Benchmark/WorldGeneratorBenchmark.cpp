@@ -0,0 +1,95 @@
+// WorldGeneratorBenchmark.cpp - world generation rate for many small maps and one large map
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include "Benchmark.h"
+#include "../WumpusWorld/WorldGenerator.h"
+
+using namespace fullsail_ai::fundamentals;
+using namespace fullsail_ai::benchmark;
+
+namespace {
+
+	// Re-derives every cell's stimulus the slow way and checks the generator's output.
+	void verify(WorldGenerator const& generator, unsigned long long seed)
+	{
+		unsigned width = generator.getWidth(), height = generator.getHeight();
+		std::vector<char> cells(generator.getCellCount()), again(generator.getCellCount());
+		unsigned starts = 0, wumpuses = 0, golds = 0;
+
+		generator.generate(seed, &cells[0]);
+		generator.generate(seed, &again[0]);
+
+		if (std::memcmp(&cells[0], &again[0], cells.size()) != 0)
+			fail("The same seed produced two different worlds!");
+
+		for (unsigned x = 0; x < width; x++)
+			for (unsigned y = 0; y < height; y++)
+			{
+				char cell = cells[(size_t)x * height + y];
+				char neighbors = 0;
+
+				if (x > 0)
+					neighbors |= cells[(size_t)(x - 1) * height + y];
+				if (x + 1 < width)
+					neighbors |= cells[(size_t)(x + 1) * height + y];
+				if (y > 0)
+					neighbors |= cells[(size_t)x * height + y - 1];
+				if (y + 1 < height)
+					neighbors |= cells[(size_t)x * height + y + 1];
+
+				if (((cell & BREEZE) != 0) != ((neighbors & PIT) != 0) || ((cell & STENCH) != 0) != ((neighbors & WUMPUS) != 0))
+					fail("A generated world has the wrong stimulus!");
+
+				if ((cell & START) && (cell & (PIT | WUMPUS | GOLD)))
+					fail("A generated world has a hazard or the gold in the start cell!");
+
+				starts += (cell & START) ? 1 : 0;
+				wumpuses += (cell & WUMPUS) ? 1 : 0;
+				golds += (cell & GOLD) ? 1 : 0;
+			}
+
+		if (starts != 1 || wumpuses != 1 || golds != 1)
+			fail("A generated world does not have exactly one start, wumpus and gold!");
+	}
+
+	void smallWorlds()
+	{
+		unsigned const worldCount = isQuick() ? 200000 : 5000000;
+		WorldGenerator generator(8, 8);
+		std::vector<char> cells(generator.getCellCount());
+
+		for (unsigned seed = 0; seed < 1000; seed++)
+			verify(generator, seed);
+
+		Timer timer;
+
+		for (unsigned seed = 0; seed < worldCount; seed++)
+		{
+			generator.generate(seed, &cells[0]);
+			keep(cells[seed & 63]);
+		}
+
+		report("worlds/generate/8x8", worldCount, timer.getSeconds());
+	}
+
+	void largeWorld()
+	{
+		unsigned const size = isQuick() ? 2048 : 8192;
+		WorldGenerator generator(size, size);
+		std::vector<char> cells(generator.getCellCount());
+		char name[64];
+
+		verify(WorldGenerator(257, 129), 42);
+
+		Timer timer;
+		generator.generate(42, &cells[0]);
+		keep(cells[cells.size() / 2]);
+
+		std::snprintf(name, sizeof(name), "worlds/generate/%ux%u-cells", size, size);
+		report(name, generator.getCellCount(), timer.getSeconds());
+	}
+}
+
+FULLSAIL_BENCHMARK(smallWorlds);
+FULLSAIL_BENCHMARK(largeWorld);
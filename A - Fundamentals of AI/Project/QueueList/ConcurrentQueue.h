@@ -0,0 +1,219 @@
+//! \file ConcurrentQueue.h
+//! \brief Defines the <code>fullsail_ai::fundamentals::ConcurrentQueue</code> class template.
+#ifndef _FULLSAIL_AI_FUNDAMENTALS_CONCURRENTQUEUE_H_
+#define _FULLSAIL_AI_FUNDAMENTALS_CONCURRENTQUEUE_H_
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <utility>
+
+namespace fullsail_ai { namespace fundamentals {
+
+	//! \brief Bounded, lock-free queue that any number of threads may enqueue to and
+	//! dequeue from at the same time (after Dmitry Vyukov's bounded MPMC queue).
+	//!
+	//! \note
+	//!   - Every slot carries a sequence number that tells producers and consumers
+	//!     whose turn it is, so a slot is only reused once its previous element has
+	//!     been moved out. Nothing is allocated or freed after construction, which
+	//!     sidesteps the memory reclamation problem of linked lock-free queues.
+	//!   - <code>enqueue()</code> and <code>dequeue()</code> never block; they return
+	//!     <code>false</code> when the queue is full or empty, respectively.
+	//!   - \a T must be an object type, not a reference.
+	template <typename T>
+	class ConcurrentQueue
+	{
+		struct Cell
+		{
+			std::atomic<std::size_t> sequence;
+			alignas(T) unsigned char storage[sizeof(T)];
+
+			T* getData() { return reinterpret_cast<T*>(storage); }
+		};
+
+		// Keeps the two positions on separate cache lines so producers and consumers
+		// do not invalidate each other's line on every operation.
+		static const std::size_t cacheLineSize = 64;
+
+		Cell* cells;
+		std::size_t mask;
+		alignas(cacheLineSize) std::atomic<std::size_t> enqueuePosition;
+		alignas(cacheLineSize) std::atomic<std::size_t> dequeuePosition;
+
+		// Claims the next free cell for a producer, or returns null when the queue is full.
+		Cell* claimForEnqueue(std::size_t& position);
+
+	public:
+		//! \brief Creates a queue that holds at least \a minimumCapacity elements.
+		//! The capacity is rounded up to a power of two.
+		explicit ConcurrentQueue(std::size_t minimumCapacity);
+
+		//! \brief Destroys the remaining elements and frees the cells.
+		//!
+		//! \pre
+		//!   - No other thread is using this <code>%ConcurrentQueue</code>.
+		~ConcurrentQueue();
+
+	private:
+		// Do not implement.
+		ConcurrentQueue(ConcurrentQueue const&);
+		ConcurrentQueue& operator=(ConcurrentQueue const&);
+
+	public:
+		//! \brief Returns the number of elements this <code>%ConcurrentQueue</code> can hold.
+		std::size_t getCapacity() const;
+
+		//! \brief Returns <code>true</code> if this <code>%ConcurrentQueue</code> did not contain
+		//! any elements at the moment of the call, <code>false</code> otherwise.
+		//!
+		//! \note  Other threads may change the answer before the caller acts on it.
+		bool isEmpty() const;
+
+		//! \brief Adds a copy of the specified element to this <code>%ConcurrentQueue</code>.
+		//!
+		//! \return  <code>false</code> if the queue is full, <code>true</code> otherwise.
+		bool enqueue(T const& element);
+
+		//! \brief Moves the specified element into this <code>%ConcurrentQueue</code>.
+		//!
+		//! \return  <code>false</code> if the queue is full (\a element is left untouched),
+		//!          <code>true</code> otherwise.
+		bool enqueue(T&& element);
+
+		//! \brief Moves the first element of this <code>%ConcurrentQueue</code> into \a element
+		//! and removes it.
+		//!
+		//! \return  <code>false</code> if the queue is empty, <code>true</code> otherwise.
+		bool dequeue(T& element);
+	};
+
+	template <typename T>
+	ConcurrentQueue<T>::ConcurrentQueue(std::size_t minimumCapacity)
+		: enqueuePosition(0), dequeuePosition(0)
+	{
+		std::size_t capacity = 2;
+
+		while (capacity < minimumCapacity)
+			capacity *= 2;
+
+		cells = static_cast<Cell*>(::operator new(sizeof(Cell) * capacity));
+		mask = capacity - 1;
+
+		for (std::size_t index = 0; index < capacity; ++index)
+			new (&cells[index].sequence) std::atomic<std::size_t>(index);
+	}
+
+	template <typename T>
+	ConcurrentQueue<T>::~ConcurrentQueue()
+	{
+		std::size_t end = enqueuePosition.load(std::memory_order_relaxed);
+
+		for (std::size_t position = dequeuePosition.load(std::memory_order_relaxed); position != end; ++position)
+			cells[position & mask].getData()->~T();
+
+		::operator delete(cells);
+	}
+
+	template <typename T>
+	std::size_t ConcurrentQueue<T>::getCapacity() const
+	{
+		return mask + 1;
+	}
+
+	template <typename T>
+	bool ConcurrentQueue<T>::isEmpty() const
+	{
+		return dequeuePosition.load(std::memory_order_acquire) >= enqueuePosition.load(std::memory_order_acquire);
+	}
+
+	template <typename T>
+	typename ConcurrentQueue<T>::Cell* ConcurrentQueue<T>::claimForEnqueue(std::size_t& position)
+	{
+		position = enqueuePosition.load(std::memory_order_relaxed);
+
+		for (;;)
+		{
+			Cell* cell = &cells[position & mask];
+			std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+			std::ptrdiff_t difference = (std::ptrdiff_t)sequence - (std::ptrdiff_t)position;
+
+			// The cell is free for this lap; try to claim it.
+			if (difference == 0)
+			{
+				if (enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+					return cell;
+			}
+			// The cell still holds the element from the previous lap: the queue is full.
+			else if (difference < 0)
+				return 0;
+			// Another producer claimed the cell first.
+			else
+				position = enqueuePosition.load(std::memory_order_relaxed);
+		}
+	}
+
+	template <typename T>
+	bool ConcurrentQueue<T>::enqueue(T const& element)
+	{
+		std::size_t position;
+		Cell* cell = claimForEnqueue(position);
+
+		if (cell == 0)
+			return false;
+
+		new (cell->storage) T(element);
+		cell->sequence.store(position + 1, std::memory_order_release);
+		return true;
+	}
+
+	template <typename T>
+	bool ConcurrentQueue<T>::enqueue(T&& element)
+	{
+		std::size_t position;
+		Cell* cell = claimForEnqueue(position);
+
+		if (cell == 0)
+			return false;
+
+		new (cell->storage) T(std::move(element));
+		cell->sequence.store(position + 1, std::memory_order_release);
+		return true;
+	}
+
+	template <typename T>
+	bool ConcurrentQueue<T>::dequeue(T& element)
+	{
+		std::size_t position = dequeuePosition.load(std::memory_order_relaxed);
+		Cell* cell;
+
+		for (;;)
+		{
+			cell = &cells[position & mask];
+			std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+			std::ptrdiff_t difference = (std::ptrdiff_t)sequence - (std::ptrdiff_t)(position + 1);
+
+			// The cell holds a published element; try to claim it.
+			if (difference == 0)
+			{
+				if (dequeuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+					break;
+			}
+			// No producer has published to this cell yet: the queue is empty.
+			else if (difference < 0)
+				return false;
+			// Another consumer claimed the cell first.
+			else
+				position = dequeuePosition.load(std::memory_order_relaxed);
+		}
+
+		element = std::move(*cell->getData());
+		cell->getData()->~T();
+
+		// Hand the cell to the producer of the next lap.
+		cell->sequence.store(position + mask + 1, std::memory_order_release);
+		return true;
+	}
+}}  // namespace fullsail_ai::fundamentals
+
+#endif  // _FULLSAIL_AI_FUNDAMENTALS_CONCURRENTQUEUE_H_
@@ -0,0 +1,328 @@
+//! \file IndexedQueueList.h
+//! \brief Defines the <code>fullsail_ai::fundamentals::IndexedQueueList</code> class template.
+#ifndef _FULLSAIL_AI_FUNDAMENTALS_INDEXEDQUEUELIST_H_
+#define _FULLSAIL_AI_FUNDAMENTALS_INDEXEDQUEUELIST_H_
+
+#include <cstddef>
+#include <functional>
+#include <unordered_map>
+#include <utility>
+#include "NodePool.h"
+
+namespace fullsail_ai { namespace fundamentals {
+
+	//! \brief C++ implementation of a doubly-linked queue with a hashed membership index,
+	//! for queues that double as open or frontier sets.
+	//!
+	//! Exposes the same interface as <code>QueueList</code>.
+	//!
+	//! \note
+	//!   - <code>contains()</code> runs in expected constant time, and <code>remove()</code>
+	//!     in amortized constant time, instead of linear time.
+	//!   - The index maps each distinct element to its first and last occurrence, and the
+	//!     occurrences of one element are chained in queue order, so duplicates are allowed.
+	//!   - The iteration order contract is the same as <code>QueueList</code>'s: iterators
+	//!     visit the elements in the order they were enqueued, and <code>remove()</code>
+	//!     unlinks the first (oldest) occurrence without reordering anything else.
+	//!   - \a Hash must hash \a T consistently with <code>operator==</code>.
+	//!   - Unlike <code>QueueList</code>, \a T must be an object type, not a reference.
+	template <typename T, typename Hash = std::hash<T> >
+	class IndexedQueueList
+	{
+		struct Node
+		{
+			T data;
+			Node* previous;
+			Node* next;
+			Node* nextSame; // The next occurrence of an equal element, in queue order.
+
+			template <typename... Arguments>
+			explicit Node(Arguments&&... arguments)
+				: data(std::forward<Arguments>(arguments)...), previous(0), next(0), nextSame(0)
+			{
+			}
+		};
+
+		// The first and last occurrences of one distinct element.
+		struct Occurrences
+		{
+			Node* first;
+			Node* last;
+		};
+
+		typedef std::unordered_map<T, Occurrences, Hash> Index;
+
+	public:
+		//! \brief Type definition of an iterator through an <code>IndexedQueueList</code>.
+		class Iterator
+		{
+			Node const* currentNode;
+
+			// The IndexedQueueList needs access to the single-argument constructor.
+			friend class IndexedQueueList;
+
+			// Used by the IndexedQueueList::begin() and IndexedQueueList::end() methods.
+			explicit Iterator(Node const* node) : currentNode(node) { }
+
+		public:
+			//! \brief Default constructor.
+			Iterator() : currentNode(0) { }
+
+			//! \brief Pre-increment operator.
+			Iterator& operator++()
+			{
+				currentNode = currentNode->next;
+				return *this;
+			}
+
+			//! \brief Post-increment operator.
+			Iterator operator++(int)
+			{
+				Iterator itr(*this);
+				++(*this);
+				return itr;
+			}
+
+			//! \brief Dereference operator.
+			T const& operator*() const
+			{
+				return currentNode->data;
+			}
+
+			inline friend bool operator==(Iterator const& lhs, Iterator const& rhs)
+			{
+				return lhs.currentNode == rhs.currentNode;
+			}
+
+			inline friend bool operator!=(Iterator const& lhs, Iterator const& rhs)
+			{
+				return lhs.currentNode != rhs.currentNode;
+			}
+		};
+
+		//! \brief Parameter type of the copying <code>enqueue()</code>,
+		//! <code>contains()</code> and <code>remove()</code>.
+		typedef T const& Parameter;
+
+		//! \brief Parameter type of the moving <code>enqueue()</code>.
+		typedef T&& RvalueParameter;
+
+	private:
+		Node* frontNode;
+		Node* backNode;
+		NodePool<Node> pool;
+		Index index;
+
+		// Links a newly created node in at the back and records it in the index.
+		void linkBack(Node* node);
+
+		// Unlinks the node from the queue and the index, then destroys it.
+		//
+		// Precondition: node is the first occurrence of its element, described by entry.
+		void unlink(Node* node, typename Index::iterator entry);
+
+	public:
+		//! \brief Creates an empty <code>%IndexedQueueList</code> that uses the specified hash.
+		explicit IndexedQueueList(Hash const& hash = Hash());
+
+		//! \brief Cleans up all internal memory.
+		~IndexedQueueList();
+
+	private:
+		// Do not implement.
+		IndexedQueueList(IndexedQueueList const&);
+		IndexedQueueList& operator=(IndexedQueueList const&);
+
+	public:
+		//! \brief Returns an iterator pointing to the beginning of this <code>%IndexedQueueList</code>.
+		Iterator begin() const { return Iterator(frontNode); }
+
+		//! \brief Returns an iterator pointing past the end of this <code>%IndexedQueueList</code>.
+		Iterator end() const { return Iterator(0); }
+
+		//! \brief Returns <code>true</code> if this <code>%IndexedQueueList</code> does not contain
+		//! any elements, <code>false</code> otherwise.
+		bool isEmpty() const { return frontNode == 0; }
+
+		//! \brief Makes sure at least \a count elements can be enqueued without allocating nodes.
+		//! (The index may still allocate for elements it has not seen.)
+		void reserve(unsigned int count);
+
+		//! \brief Adds a copy of the specified element to this <code>%IndexedQueueList</code>.
+		void enqueue(Parameter element);
+
+		//! \brief Moves the specified element into this <code>%IndexedQueueList</code>.
+		void enqueue(RvalueParameter element);
+
+		//! \brief Constructs a new element at the back of this <code>%IndexedQueueList</code>.
+		template <typename... Arguments>
+		void emplace(Arguments&&... arguments);
+
+		//! \brief Returns the first element in this <code>%IndexedQueueList</code>.
+		//!
+		//! \pre
+		//!   - <code>isEmpty()</code> returns <code>false</code>.
+		T const& getFront() const { return frontNode->data; }
+
+		//! \brief Returns a reference to the first element in this <code>%IndexedQueueList</code>.
+		//! (Elements are keys of the index, so they cannot be modified in place.)
+		//!
+		//! \pre
+		//!   - <code>isEmpty()</code> returns <code>false</code>.
+		T const& front() const { return frontNode->data; }
+
+		//! \brief Removes the first element from this <code>%IndexedQueueList</code> and returns it.
+		//!
+		//! \pre
+		//!   - <code>isEmpty()</code> returns <code>false</code>.
+		T popFront();
+
+		//! \brief Removes the first element from this <code>%IndexedQueueList</code>.
+		//!
+		//! \pre
+		//!   - <code>isEmpty()</code> returns <code>false</code>.
+		void dequeue();
+
+		//! \brief Removes all elements from this <code>%IndexedQueueList</code>.
+		void removeAll();
+
+		//! \brief Returns <code>true</code> if this <code>%IndexedQueueList</code>
+		//! possesses the specified element, <code>false</code> otherwise.
+		bool contains(Parameter element) const;
+
+		//! \brief Finds the first occurrence of the specified element and
+		//! removes it from the <code>%IndexedQueueList</code>.
+		void remove(Parameter element);
+	};
+
+	template <typename T, typename Hash>
+	IndexedQueueList<T, Hash>::IndexedQueueList(Hash const& hash)
+		: frontNode(0), backNode(0), index(16, hash)
+	{
+	}
+
+	template <typename T, typename Hash>
+	IndexedQueueList<T, Hash>::~IndexedQueueList()
+	{
+		removeAll();
+	}
+
+	template <typename T, typename Hash>
+	void IndexedQueueList<T, Hash>::reserve(unsigned int count)
+	{
+		pool.reserve(count);
+		index.reserve(count);
+	}
+
+	template <typename T, typename Hash>
+	void IndexedQueueList<T, Hash>::linkBack(Node* node)
+	{
+		Occurrences newEntry = { node, node };
+		std::pair<typename Index::iterator, bool> result = index.insert(std::make_pair(node->data, newEntry));
+
+		// Equal elements are already queued: chain this one after the last of them.
+		if (!result.second)
+		{
+			result.first->second.last->nextSame = node;
+			result.first->second.last = node;
+		}
+
+		node->previous = backNode;
+
+		if (backNode == 0)
+			frontNode = node;
+		else
+			backNode->next = node;
+
+		backNode = node;
+	}
+
+	template <typename T, typename Hash>
+	void IndexedQueueList<T, Hash>::unlink(Node* node, typename Index::iterator entry)
+	{
+		if (node->nextSame == 0)
+			index.erase(entry);
+		else
+			entry->second.first = node->nextSame;
+
+		if (node->previous == 0)
+			frontNode = node->next;
+		else
+			node->previous->next = node->next;
+
+		if (node->next == 0)
+			backNode = node->previous;
+		else
+			node->next->previous = node->previous;
+
+		pool.destroy(node);
+	}
+
+	template <typename T, typename Hash>
+	void IndexedQueueList<T, Hash>::enqueue(Parameter element)
+	{
+		linkBack(pool.create(element));
+	}
+
+	template <typename T, typename Hash>
+	void IndexedQueueList<T, Hash>::enqueue(RvalueParameter element)
+	{
+		linkBack(pool.create(std::move(element)));
+	}
+
+	template <typename T, typename Hash>
+	template <typename... Arguments>
+	void IndexedQueueList<T, Hash>::emplace(Arguments&&... arguments)
+	{
+		linkBack(pool.create(std::forward<Arguments>(arguments)...));
+	}
+
+	template <typename T, typename Hash>
+	T IndexedQueueList<T, Hash>::popFront()
+	{
+		// Look the element up before moving it out of the node, which leaves it unhashable.
+		typename Index::iterator entry = index.find(frontNode->data);
+		T element(std::move(frontNode->data));
+
+		unlink(frontNode, entry);
+		return element;
+	}
+
+	template <typename T, typename Hash>
+	void IndexedQueueList<T, Hash>::dequeue()
+	{
+		// The front node is always the first occurrence of its element.
+		unlink(frontNode, index.find(frontNode->data));
+	}
+
+	template <typename T, typename Hash>
+	void IndexedQueueList<T, Hash>::removeAll()
+	{
+		while (frontNode != 0)
+		{
+			Node* node = frontNode;
+			frontNode = node->next;
+			pool.destroy(node);
+		}
+
+		backNode = 0;
+		index.clear();
+	}
+
+	template <typename T, typename Hash>
+	bool IndexedQueueList<T, Hash>::contains(Parameter element) const
+	{
+		return index.find(element) != index.end();
+	}
+
+	template <typename T, typename Hash>
+	void IndexedQueueList<T, Hash>::remove(Parameter element)
+	{
+		typename Index::iterator entry = index.find(element);
+
+		if (entry != index.end())
+			unlink(entry->second.first, entry);
+	}
+}}  // namespace fullsail_ai::fundamentals
+
+#endif  // _FULLSAIL_AI_FUNDAMENTALS_INDEXEDQUEUELIST_H_
@@ -0,0 +1,154 @@
+//! \file NodePool.h
+//! \brief Defines the <code>fullsail_ai::fundamentals::NodePool</code> class template.
+#ifndef _FULLSAIL_AI_FUNDAMENTALS_NODEPOOL_H_
+#define _FULLSAIL_AI_FUNDAMENTALS_NODEPOOL_H_
+
+#include <cstddef>
+#include <new>
+#include <utility>
+
+namespace fullsail_ai { namespace fundamentals {
+
+	//! \brief Slab allocator for the nodes of one linked container.
+	//!
+	//! \note
+	//!   - Nodes are carved out of slabs and recycled through a free list, so a container
+	//!     stops touching the global heap once it has grown to its working size.
+	//!   - Slabs are only handed back to the global heap when the pool is destroyed.
+	template <typename Node>
+	class NodePool
+	{
+		// Raw storage for one node. While the slot is free, it links to the next free slot.
+		// The first slot of every slab links to the previously allocated slab instead.
+		union Slot
+		{
+			Slot* next;
+			alignas(Node) unsigned char storage[sizeof(Node)];
+		};
+
+		// Slab sizes start small and double until they reach the cap.
+		static const unsigned int initialSlabSize = 16;
+		static const unsigned int maximumSlabSize = 4096;
+
+		Slot* freeSlots;
+		Slot* slabs;
+		unsigned int nextSlabSize;
+
+		// Allocates a slab with room for the specified number of nodes.
+		void allocateSlab(unsigned int nodeCount);
+
+	public:
+		//! \brief Default constructor. Does not allocate until the first node is created.
+		NodePool();
+
+		//! \brief Hands every slab back to the global heap.
+		//!
+		//! \pre
+		//!   - Every node created by this <code>%NodePool</code> has been destroyed.
+		~NodePool();
+
+	private:
+		// Do not implement.
+		NodePool(NodePool const&);
+		NodePool& operator=(NodePool const&);
+
+	public:
+		//! \brief Constructs a node from \a arguments in a recycled slot, allocating a new
+		//! slab if none are free. If the constructor throws, the slot stays free.
+		template <typename... Arguments>
+		Node* create(Arguments&&... arguments);
+
+		//! \brief Destroys the node and returns its slot to the free list.
+		//!
+		//! \pre
+		//!   - \a node was created by this <code>%NodePool</code>.
+		void destroy(Node* node);
+
+		//! \brief Makes sure at least \a count nodes can be created without allocating.
+		void reserve(unsigned int count);
+	};
+
+	template <typename Node>
+	NodePool<Node>::NodePool() : freeSlots(0), slabs(0), nextSlabSize(initialSlabSize)
+	{
+	}
+
+	template <typename Node>
+	NodePool<Node>::~NodePool()
+	{
+		while (slabs != 0)
+		{
+			Slot* slab = slabs;
+			slabs = slab[0].next;
+			::operator delete(slab);
+		}
+	}
+
+	template <typename Node>
+	void NodePool<Node>::allocateSlab(unsigned int nodeCount)
+	{
+		Slot* slab = static_cast<Slot*>(::operator new(sizeof(Slot) * (nodeCount + 1)));
+
+		slab[0].next = slabs;
+		slabs = slab;
+
+		for (unsigned int index = nodeCount; index > 0; --index)
+		{
+			slab[index].next = freeSlots;
+			freeSlots = &slab[index];
+		}
+	}
+
+	template <typename Node>
+	template <typename... Arguments>
+	Node* NodePool<Node>::create(Arguments&&... arguments)
+	{
+		if (freeSlots == 0)
+		{
+			allocateSlab(nextSlabSize);
+
+			if (nextSlabSize < maximumSlabSize)
+				nextSlabSize *= 2;
+		}
+
+		Slot* slot = freeSlots;
+		freeSlots = slot->next;
+
+		// The node is built over the link, so if building it throws, the slot is linked
+		// back in rather than lost.
+		try
+		{
+			return new (slot->storage) Node(std::forward<Arguments>(arguments)...);
+		}
+		catch (...)
+		{
+			slot->next = freeSlots;
+			freeSlots = slot;
+			throw;
+		}
+	}
+
+	template <typename Node>
+	void NodePool<Node>::destroy(Node* node)
+	{
+		node->~Node();
+
+		Slot* slot = reinterpret_cast<Slot*>(node);
+		slot->next = freeSlots;
+		freeSlots = slot;
+	}
+
+	template <typename Node>
+	void NodePool<Node>::reserve(unsigned int count)
+	{
+		unsigned int available = 0;
+
+		for (Slot const* slot = freeSlots; slot != 0 && available < count; slot = slot->next)
+			++available;
+
+		if (available < count)
+			allocateSlab(count - available);
+	}
+}}  // namespace fullsail_ai::fundamentals
+
+#endif  // _FULLSAIL_AI_FUNDAMENTALS_NODEPOOL_H_
@@ -5,6 +5,12 @@
 #ifndef _FULLSAIL_AI_FUNDAMENTALS_QUEUELIST_H_
 #define _FULLSAIL_AI_FUNDAMENTALS_QUEUELIST_H_
 
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include "NodePool.h"
+
 namespace fullsail_ai { namespace fundamentals {
 
 	//! \brief C++ implementation of a singly-linked list that can be treated as a queue.
@@ -14,6 +20,9 @@ namespace fullsail_ai { namespace fundamentals {
 	//!     in constant time.
 	//!   - Elements are accessed or removed from anywhere else in linear time
 	//!     with respect to the number of elements.
+	//!   - Nodes come from a <code>NodePool</code> owned by the <code>%QueueList</code>,
+	//!     so enqueue/dequeue cycles stop touching the global heap once the list has
+	//!     grown to its working size.
 	template <typename T>
 	class QueueList
 	{
@@ -22,15 +31,17 @@ namespace fullsail_ai { namespace fundamentals {
 			T data;
 			Node* next;
 
-			explicit Node(T);
+			template <typename... Arguments>
+			explicit Node(Arguments&&... arguments);
 			~Node();
 
 			static unsigned int getCreatedNodeCount();
 			static unsigned int getDestroyedNodeCount();
 
 		private:
-			static unsigned int createdNodeCount;
-			static unsigned int destroyedNodeCount;
+			// Shared by every list of this type, so lists on different threads must not race.
+			static std::atomic<unsigned int> createdNodeCount;
+			static std::atomic<unsigned int> destroyedNodeCount;
 		};
 
 	public:
@@ -74,11 +85,11 @@ namespace fullsail_ai { namespace fundamentals {
 
 			//! \brief Dereference operator.
 			//!
-			//! \return  The element to which this iterator refers.
+			//! \return  A reference to the element to which this iterator refers.
 			//!
 			//! \pre
 			//!   - This iterator does not point past the end of the <code>QueueList</code>.
-			T operator*() const;
+			T const& operator*() const;
 
 			//! \brief Equality operator.
 			//!
@@ -101,10 +112,26 @@ namespace fullsail_ai { namespace fundamentals {
 		};
 
 	private:
-		Node* front;
-		Node* back;
+		Node* frontNode;
+		Node* backNode;
+
+		NodePool<Node> pool;
+
+		// Links a newly created node in at the back.
+		void linkBack(Node* node);
+
+		// A queue of references stores exactly what it is given, so it only accepts lvalues;
+		// its rvalue overload of enqueue() takes a type no caller can produce.
+		struct NoRvalue { };
 
 	public:
+		//! \brief Parameter type of the copying <code>enqueue()</code>,
+		//! <code>contains()</code> and <code>remove()</code>.
+		typedef typename std::conditional<std::is_reference<T>::value, T, T const&>::type Parameter;
+
+		//! \brief Parameter type of the moving <code>enqueue()</code>.
+		typedef typename std::conditional<std::is_reference<T>::value, NoRvalue, T&&>::type RvalueParameter;
+
 		//! \brief Default constructor.
 		QueueList();
 
@@ -130,19 +157,49 @@ namespace fullsail_ai { namespace fundamentals {
 		//! elements, <code>false</code> otherwise.
 		bool isEmpty() const;
 
-		//! \brief Adds the specified element to this <code>%QueueList</code>.
+		//! \brief Makes sure at least \a count elements can be enqueued without allocating.
+		//!
+		//! \post
+		//!   - The next \a count calls to <code>enqueue()</code> will reuse pooled nodes.
+		void reserve(unsigned int count);
+
+		//! \brief Adds a copy of the specified element to this <code>%QueueList</code>.
 		//!
 		//! \param   element  the specified element.
 		//!
 		//! \post
 		//!   - <code>contains()</code> will return <code>true</code> if \a element is passed in.
-		void enqueue(T element);
+		void enqueue(Parameter element);
+
+		//! \brief Moves the specified element into this <code>%QueueList</code>.
+		//!
+		//! \param   element  the specified element.
+		void enqueue(RvalueParameter element);
+
+		//! \brief Constructs a new element at the back of this <code>%QueueList</code>
+		//! directly from \a arguments, without any intermediate copy.
+		template <typename... Arguments>
+		void emplace(Arguments&&... arguments);
 
 		//! \brief Returns the first element in this <code>%QueueList</code>.
 		//!
 		//! \pre
 		//!   - <code>isEmpty()</code> returns <code>false</code>.
-		T getFront() const;
+		T const& getFront() const;
+
+		//! \brief Returns a reference to the first element in this <code>%QueueList</code>.
+		//!
+		//! \pre
+		//!   - <code>isEmpty()</code> returns <code>false</code>.
+		T& front();
+		T const& front() const;
+
+		//! \brief Removes the first element from this <code>%QueueList</code> and returns it,
+		//! moving it out instead of copying it.
+		//!
+		//! \pre
+		//!   - <code>isEmpty()</code> returns <code>false</code>.
+		T popFront();
 
 		//! \brief Removes the first element from this <code>%QueueList</code>.
 		//!
@@ -161,32 +218,34 @@ namespace fullsail_ai { namespace fundamentals {
 
 		//! \brief Returns <code>true</code> if this <code>%QueueList</code>
 		//! possesses the specified element, <code>false</code> otherwise.
-		bool contains(T element) const;
+		bool contains(Parameter element) const;
 
 		//! \brief Finds the first occurrence of the specified element and
 		//! removes it from the <code>%QueueList</code>.
 		//!
 		//! \pre
 		//!   - <code>isEmpty()</code> returns <code>false</code>.
-		void remove(T element);
+		void remove(Parameter element);
 	};
 
 	template <typename T>
-	unsigned int QueueList<T>::Node::createdNodeCount = 0;
+	std::atomic<unsigned int> QueueList<T>::Node::createdNodeCount(0);
 
 	template <typename T>
-	unsigned int QueueList<T>::Node::destroyedNodeCount = 0;
+	std::atomic<unsigned int> QueueList<T>::Node::destroyedNodeCount(0);
 
 	template <typename T>
-	QueueList<T>::Node::Node(T element) : data(element), next(0)
+	template <typename... Arguments>
+	QueueList<T>::Node::Node(Arguments&&... arguments)
+		: data(std::forward<Arguments>(arguments)...), next(0)
 	{
-		++createdNodeCount;
+		createdNodeCount.fetch_add(1, std::memory_order_relaxed);
 	}
 
 	template <typename T>
 	QueueList<T>::Node::~Node()
 	{
-		++destroyedNodeCount;
+		destroyedNodeCount.fetch_add(1, std::memory_order_relaxed);
 	}
 
 	template <typename T>
@@ -204,13 +263,19 @@ namespace fullsail_ai { namespace fundamentals {
 	template <typename T>
 	unsigned int QueueList<T>::Node::getCreatedNodeCount()
 	{
-		return createdNodeCount;
+		return createdNodeCount.load(std::memory_order_relaxed);
 	}
 
 	template <typename T>
 	unsigned int QueueList<T>::Node::getDestroyedNodeCount()
 	{
-		return destroyedNodeCount;
+		return destroyedNodeCount.load(std::memory_order_relaxed);
+	}
+
+	template <typename T>
+	void QueueList<T>::reserve(unsigned int count)
+	{
+		pool.reserve(count);
 	}
 
 	template <typename T>
@@ -234,7 +299,7 @@ namespace fullsail_ai { namespace fundamentals {
 	template <typename T>
 	typename QueueList<T>::Iterator QueueList<T>::begin() const
 	{
-		return Iterator(front);
+		return Iterator(frontNode);
 	}
 
 	template <typename T>
@@ -27,16 +27,15 @@ namespace fullsail_ai { namespace fundamentals {
 	}
 
 	template <typename T>
-	T QueueList<T>::Iterator::operator*() const
+	T const& QueueList<T>::Iterator::operator*() const
 	{
 		return currentNode->data;
 	}
 
 	template <typename T>
 	QueueList<T>::QueueList() {
-		//not sure what to do here honestly.
-		front = nullptr;
-		back = nullptr;
+		frontNode = nullptr;
+		backNode = nullptr;
 	}
 
 	template <typename T>
@@ -46,37 +45,73 @@ namespace fullsail_ai { namespace fundamentals {
 
 	template <typename T>
 	bool QueueList<T>::isEmpty() const {
-		return front == nullptr;
+		return frontNode == nullptr;
 	}
 
 	template <typename T>
-	void QueueList<T>::enqueue(T element) {
-		Node* newNode = new Node(element);
-
+	void QueueList<T>::linkBack(Node* newNode) {
 		if (isEmpty()) {
-			front = newNode;
-			back = newNode;
+			frontNode = newNode;
+			backNode = newNode;
 		}
 		else {
-			back->next = newNode;
-			back = back->next;
+			backNode->next = newNode;
+			backNode = backNode->next;
 		}
 	}
 
 	template <typename T>
-	T QueueList<T>::getFront() const {
-		return front->data;
+	void QueueList<T>::enqueue(Parameter element) {
+		linkBack(pool.create(element));
+	}
+
+	template <typename T>
+	void QueueList<T>::enqueue(RvalueParameter element) {
+		linkBack(pool.create(std::move(element)));
+	}
+
+	template <typename T>
+	template <typename... Arguments>
+	void QueueList<T>::emplace(Arguments&&... arguments) {
+		linkBack(pool.create(std::forward<Arguments>(arguments)...));
+	}
+
+	template <typename T>
+	T const& QueueList<T>::getFront() const {
+		return frontNode->data;
+	}
+
+	template <typename T>
+	T& QueueList<T>::front() {
+		return frontNode->data;
+	}
+
+	template <typename T>
+	T const& QueueList<T>::front() const {
+		return frontNode->data;
+	}
+
+	template <typename T>
+	T QueueList<T>::popFront() {
+		// Forwarding moves an object out of the node but hands a stored reference back as is.
+		T element(std::forward<T>(frontNode->data));
+		dequeue();
+		return element;
 	}
 
 	template <typename T>
 	void QueueList<T>::dequeue() {
-		if (front == back) {
-			front = nullptr;
-			back = nullptr;
+		Node* oldFront = frontNode;
+
+		if (frontNode == backNode) {
+			frontNode = nullptr;
+			backNode = nullptr;
 		}
 		else {
-			front = front->next;
+			frontNode = frontNode->next;
 		}
+
+		pool.destroy(oldFront);
 	}
 
 	template <typename T>
@@ -86,8 +121,8 @@ namespace fullsail_ai { namespace fundamentals {
 	}
 
 	template <typename T>
-	bool QueueList<T>::contains(T element) const {
-		Node* curr = front;
+	bool QueueList<T>::contains(Parameter element) const {
+		Node* curr = frontNode;
 
 		while (curr != nullptr) {
 			if (curr->data == element)
@@ -100,19 +135,20 @@ namespace fullsail_ai { namespace fundamentals {
 	}
 
 	template <typename T>
-	void QueueList<T>::remove(T element) {
+	void QueueList<T>::remove(Parameter element) {
 		Node* prev = nullptr;
-		Node* curr = front;
+		Node* curr = frontNode;
 
 		while (curr != nullptr) {
 			if (curr->data == element) {
-				if (curr == front)
+				if (curr == frontNode)
 					dequeue();
 				else {
 					if (curr->next == nullptr)
-						back = prev;
+						backNode = prev;
 
 					prev->next = curr->next;
+					pool.destroy(curr);
 				}
 				return;
 			}
@@ -0,0 +1,416 @@
+//! \file RingQueue.h
+//! \brief Defines the <code>fullsail_ai::fundamentals::RingQueue</code> class template.
+#ifndef _FULLSAIL_AI_FUNDAMENTALS_RINGQUEUE_H_
+#define _FULLSAIL_AI_FUNDAMENTALS_RINGQUEUE_H_
+
+#include <cstddef>
+#include <new>
+#include <utility>
+
+namespace fullsail_ai { namespace fundamentals {
+
+	//! \brief C++ implementation of a queue stored in a growable, contiguous ring buffer.
+	//!
+	//! Exposes the same interface as <code>QueueList</code>, so either one can be passed
+	//! wherever a queue is a template parameter (for example
+	//! <code>template \<typename\> class Queue</code>).
+	//!
+	//! \note
+	//!   - The capacity is always a power of two, so wrapping an index is a single mask.
+	//!   - Elements are inserted to the back and accessed or removed from the front
+	//!     in amortized constant time.
+	//!   - Elements are searched for or removed from anywhere else in linear time
+	//!     with respect to the number of elements.
+	//!   - Unlike <code>QueueList</code>, \a T must be an object type, not a reference.
+	template <typename T>
+	class RingQueue
+	{
+	public:
+		//! \brief Type definition of an iterator through a <code>RingQueue</code>.
+		class Iterator
+		{
+			RingQueue const* queue;
+			std::size_t position;
+
+			// The RingQueue needs access to the two-argument constructor.
+			friend class RingQueue<T>;
+
+			// Used by the RingQueue::begin() and RingQueue::end() methods.
+			Iterator(RingQueue const* _queue, std::size_t _position);
+
+		public:
+			//! \brief Default constructor.
+			//!
+			//! Allows user code to delay initialization of this iterator.
+			Iterator();
+
+			//! \brief Pre-increment operator.
+			//!
+			//! \return  A reference to this iterator.
+			//!
+			//! \pre
+			//!   - This iterator does not point past the end of the <code>RingQueue</code>.
+			Iterator& operator++();
+
+			//! \brief Post-increment operator.
+			//!
+			//! \return  A copy of this iterator.
+			//!
+			//! \pre
+			//!   - This iterator does not point past the end of the <code>RingQueue</code>.
+			Iterator operator++(int);
+
+			//! \brief Dereference operator.
+			//!
+			//! \return  A reference to the element to which this iterator refers.
+			//!
+			//! \pre
+			//!   - This iterator does not point past the end of the <code>RingQueue</code>.
+			T const& operator*() const;
+
+			//! \brief Equality operator.
+			inline friend bool operator==(Iterator const& lhs, Iterator const& rhs)
+			{
+				return lhs.queue == rhs.queue && lhs.position == rhs.position;
+			}
+
+			//! \brief Inequality operator.
+			inline friend bool operator!=(Iterator const& lhs, Iterator const& rhs)
+			{
+				return !(lhs == rhs);
+			}
+		};
+
+	private:
+		static const std::size_t initialCapacity = 16;
+
+		T* slots;
+		std::size_t capacity;
+		std::size_t head;
+		std::size_t count;
+
+		// Returns the slot that holds the element at the specified distance from the front.
+		T* slotAt(std::size_t position) const;
+
+		// Moves every element into a buffer with the specified power-of-two capacity.
+		void grow(std::size_t newCapacity);
+
+		// Moves every element to the front of the specified buffer and adopts it.
+		void relocate(T* newSlots, std::size_t newCapacity);
+
+	public:
+		//! \brief Parameter type of the copying <code>enqueue()</code>,
+		//! <code>contains()</code> and <code>remove()</code>.
+		typedef T const& Parameter;
+
+		//! \brief Parameter type of the moving <code>enqueue()</code>.
+		typedef T&& RvalueParameter;
+
+		//! \brief Default constructor. Does not allocate until the first element is enqueued.
+		RingQueue();
+
+		//! \brief Cleans up all internal memory.
+		~RingQueue();
+
+	private:
+		// Do not implement.
+		RingQueue(RingQueue const&);
+		RingQueue& operator=(RingQueue const&);
+
+	public:
+		//! \brief Returns an iterator pointing to the beginning of this <code>%RingQueue</code>.
+		Iterator begin() const;
+
+		//! \brief Returns an iterator pointing past the end of this <code>%RingQueue</code>.
+		Iterator end() const;
+
+		//! \brief Returns <code>true</code> if this <code>%RingQueue</code> does not contain any
+		//! elements, <code>false</code> otherwise.
+		bool isEmpty() const;
+
+		//! \brief Returns the number of elements in this <code>%RingQueue</code>.
+		std::size_t getSize() const;
+
+		//! \brief Makes sure at least \a minimumCapacity elements fit without growing the buffer.
+		void reserve(std::size_t minimumCapacity);
+
+		//! \brief Adds a copy of the specified element to this <code>%RingQueue</code>.
+		//!
+		//! \post
+		//!   - <code>contains()</code> will return <code>true</code> if \a element is passed in.
+		void enqueue(Parameter element);
+
+		//! \brief Moves the specified element into this <code>%RingQueue</code>.
+		void enqueue(RvalueParameter element);
+
+		//! \brief Constructs a new element at the back of this <code>%RingQueue</code>
+		//! directly from \a arguments.
+		template <typename... Arguments>
+		void emplace(Arguments&&... arguments);
+
+		//! \brief Returns the first element in this <code>%RingQueue</code>.
+		//!
+		//! \pre
+		//!   - <code>isEmpty()</code> returns <code>false</code>.
+		T const& getFront() const;
+
+		//! \brief Returns a reference to the first element in this <code>%RingQueue</code>.
+		//!
+		//! \pre
+		//!   - <code>isEmpty()</code> returns <code>false</code>.
+		T& front();
+		T const& front() const;
+
+		//! \brief Removes the first element from this <code>%RingQueue</code> and returns it
+		//! by move.
+		//!
+		//! \pre
+		//!   - <code>isEmpty()</code> returns <code>false</code>.
+		T popFront();
+
+		//! \brief Removes the first element from this <code>%RingQueue</code>.
+		//!
+		//! \pre
+		//!   - <code>isEmpty()</code> returns <code>false</code>.
+		void dequeue();
+
+		//! \brief Removes all elements from this <code>%RingQueue</code>. Keeps the buffer.
+		//!
+		//! \post
+		//!   - <code>isEmpty()</code> will return <code>true</code>.
+		void removeAll();
+
+		//! \brief Returns <code>true</code> if this <code>%RingQueue</code>
+		//! possesses the specified element, <code>false</code> otherwise.
+		bool contains(Parameter element) const;
+
+		//! \brief Finds the first occurrence of the specified element and
+		//! removes it from the <code>%RingQueue</code>, keeping the order of the others.
+		void remove(Parameter element);
+	};
+
+	template <typename T>
+	RingQueue<T>::Iterator::Iterator(RingQueue const* _queue, std::size_t _position)
+		: queue(_queue), position(_position)
+	{
+	}
+
+	template <typename T>
+	RingQueue<T>::Iterator::Iterator() : queue(0), position(0)
+	{
+	}
+
+	template <typename T>
+	typename RingQueue<T>::Iterator& RingQueue<T>::Iterator::operator++()
+	{
+		++position;
+		return *this;
+	}
+
+	template <typename T>
+	typename RingQueue<T>::Iterator RingQueue<T>::Iterator::operator++(int)
+	{
+		Iterator itr(*this);
+		++(*this);
+		return itr;
+	}
+
+	template <typename T>
+	T const& RingQueue<T>::Iterator::operator*() const
+	{
+		return *queue->slotAt(position);
+	}
+
+	template <typename T>
+	RingQueue<T>::RingQueue() : slots(0), capacity(0), head(0), count(0)
+	{
+	}
+
+	template <typename T>
+	RingQueue<T>::~RingQueue()
+	{
+		removeAll();
+		::operator delete(slots);
+	}
+
+	template <typename T>
+	T* RingQueue<T>::slotAt(std::size_t position) const
+	{
+		return slots + ((head + position) & (capacity - 1));
+	}
+
+	template <typename T>
+	void RingQueue<T>::grow(std::size_t newCapacity)
+	{
+		relocate(static_cast<T*>(::operator new(sizeof(T) * newCapacity)), newCapacity);
+	}
+
+	template <typename T>
+	void RingQueue<T>::relocate(T* newSlots, std::size_t newCapacity)
+	{
+		for (std::size_t position = 0; position < count; ++position)
+		{
+			T* oldSlot = slotAt(position);
+			new (newSlots + position) T(std::move(*oldSlot));
+			oldSlot->~T();
+		}
+
+		::operator delete(slots);
+		slots = newSlots;
+		capacity = newCapacity;
+		head = 0;
+	}
+
+	template <typename T>
+	typename RingQueue<T>::Iterator RingQueue<T>::begin() const
+	{
+		return Iterator(this, 0);
+	}
+
+	template <typename T>
+	typename RingQueue<T>::Iterator RingQueue<T>::end() const
+	{
+		return Iterator(this, count);
+	}
+
+	template <typename T>
+	bool RingQueue<T>::isEmpty() const
+	{
+		return count == 0;
+	}
+
+	template <typename T>
+	std::size_t RingQueue<T>::getSize() const
+	{
+		return count;
+	}
+
+	template <typename T>
+	void RingQueue<T>::reserve(std::size_t minimumCapacity)
+	{
+		if (minimumCapacity <= capacity)
+			return;
+
+		std::size_t newCapacity = capacity ? capacity : initialCapacity;
+
+		while (newCapacity < minimumCapacity)
+			newCapacity *= 2;
+
+		grow(newCapacity);
+	}
+
+	template <typename T>
+	void RingQueue<T>::enqueue(Parameter element)
+	{
+		emplace(element);
+	}
+
+	template <typename T>
+	void RingQueue<T>::enqueue(RvalueParameter element)
+	{
+		emplace(std::move(element));
+	}
+
+	template <typename T>
+	template <typename... Arguments>
+	void RingQueue<T>::emplace(Arguments&&... arguments)
+	{
+		if (count == capacity)
+		{
+			// Build the new element before moving the old ones, in case the arguments
+			// refer to an element of this queue. If building it throws, the queue is left
+			// as it was.
+			std::size_t newCapacity = capacity ? capacity * 2 : initialCapacity;
+			T* newSlots = static_cast<T*>(::operator new(sizeof(T) * newCapacity));
+
+			try
+			{
+				new (newSlots + count) T(std::forward<Arguments>(arguments)...);
+			}
+			catch (...)
+			{
+				::operator delete(newSlots);
+				throw;
+			}
+
+			relocate(newSlots, newCapacity);
+		}
+		else
+			new (slotAt(count)) T(std::forward<Arguments>(arguments)...);
+
+		++count;
+	}
+
+	template <typename T>
+	T const& RingQueue<T>::getFront() const
+	{
+		return slots[head];
+	}
+
+	template <typename T>
+	T& RingQueue<T>::front()
+	{
+		return slots[head];
+	}
+
+	template <typename T>
+	T const& RingQueue<T>::front() const
+	{
+		return slots[head];
+	}
+
+	template <typename T>
+	T RingQueue<T>::popFront()
+	{
+		T element(std::move(slots[head]));
+		dequeue();
+		return element;
+	}
+
+	template <typename T>
+	void RingQueue<T>::dequeue()
+	{
+		slots[head].~T();
+		head = (head + 1) & (capacity - 1);
+		--count;
+	}
+
+	template <typename T>
+	void RingQueue<T>::removeAll()
+	{
+		while (!isEmpty())
+			dequeue();
+
+		head = 0;
+	}
+
+	template <typename T>
+	bool RingQueue<T>::contains(Parameter element) const
+	{
+		for (std::size_t position = 0; position < count; ++position)
+			if (*slotAt(position) == element)
+				return true;
+
+		return false;
+	}
+
+	template <typename T>
+	void RingQueue<T>::remove(Parameter element)
+	{
+		for (std::size_t position = 0; position < count; ++position)
+		{
+			if (*slotAt(position) == element)
+			{
+				// Close the gap by shifting the rest of the queue toward the front.
+				for (; position + 1 < count; ++position)
+					*slotAt(position) = std::move(*slotAt(position + 1));
+
+				slotAt(count - 1)->~T();
+				--count;
+				return;
+			}
+		}
+	}
+}}  // namespace fullsail_ai::fundamentals
+
+#endif  // _FULLSAIL_AI_FUNDAMENTALS_RINGQUEUE_H_
@@ -2,11 +2,16 @@
 // Code by Cromwell D. Enage, December 2008
 // Updated by Jeremiah Blanchard, January 2009
 // Updated by Cromwell D. Enage, April 2009
+#include <cstring>
 #include <limits>
 #include <string>
+#include <vector>
+#include <thread>
 #include <cassert>
 #include <iostream>
 #include "QueueList/QueueList.h"
+#include "QueueList/ConcurrentQueue.h"
+#include "QueueList/IndexedQueueList.h"
 
 using namespace std;
 using namespace fullsail_ai::fundamentals;
@@ -17,8 +22,10 @@ void traverse(QueueList<T> const& q, F& dataFunction);
 
 void printString(string& testString);
 void printCString(char const* testString);
+void testConcurrentQueue(unsigned int producerCount, unsigned int consumerCount);
+void testIndexedQueueList();
 
-int main()
+int main(int argc, char* argv[])
 {
 	// Get ready.
 	QueueList<string&> alist;
@@ -178,6 +185,8 @@ int main()
 	// Test removal of all elements by method.
 	cout << "Removing all elements from qlist...";
 	qlist.removeAll();
+	assert((QueueList<char const*>::getCreatedNodeCount() == QueueList<char const*>::getDestroyedNodeCount())
+	    && "removeAll() did not destroy every node");
 	cout << endl << "\tqlist:";
 	traverse(qlist, printCString);
 	cout << endl;
@@ -194,10 +203,45 @@ int main()
 	traverse(qlist, printCString);
 	cout << endl << "\talist:";
 	traverse(alist, printString);
-	cout << endl << endl;
+	cout << endl;
+
+	// Test in-place construction and moving elements in and out.
+	{
+		QueueList<string> slist;
+		unsigned int created = QueueList<string>::getCreatedNodeCount();
+
+		slist.emplace(5, 'k');
+		slist.enqueue(string("lima"));
+		slist.enqueue(testStrings[0]);
+		assert((slist.front() == "kkkkk") && "emplace() did not construct the element in place");
+		slist.front() += "ilo";
+		assert((slist.getFront() == "kkkkkilo") && "front() does not refer to the stored element");
+		assert((slist.popFront() == "kkkkkilo") && (slist.getFront() == "lima"));
+		assert(testStrings[0] == "alpha" && "enqueue() of an lvalue moved from it");
+		slist.removeAll();
+		assert((QueueList<string>::getCreatedNodeCount() == created + 3)
+		    && (QueueList<string>::getDestroyedNodeCount() == created + 3)
+		    && "node counts do not balance");
+		cout << "Emplace, move and popFront tests passed." << endl;
+	}
+
+	cout << endl;
+
+	// Test the hashed membership index.
+	testIndexedQueueList();
+
+	// Test the concurrent queue and the node counters under contention.
+	testConcurrentQueue(1, 1);
+	testConcurrentQueue(4, 4);
+	testConcurrentQueue(2, 6);
+	cout << endl;
+
+	// "--no-wait" skips the pause, for running unattended.
+	if (argc > 1 && strcmp(argv[1], "--no-wait") == 0)
+		return 0;
 
 	cout << "Press ENTER to continue..." << endl;
-	while(cin.get() != '\n') {;}
+	while(cin.get() != '\n' && cin) {;}
 	return 0;
 }
 
@@ -219,6 +263,132 @@ void traverse(QueueList<T> const& q, F& dataFunction)
 	}
 }
 
+// Hashes a string by its length only, so that unequal strings collide.
+struct StringLengthHash
+{
+	size_t operator()(string const& value) const { return value.size(); }
+};
+
+void testIndexedQueueList()
+{
+	IndexedQueueList<string, StringLengthHash> ilist;
+	string const initial[] = { "alpha", "bravo", "charlie", "charlie", "dog", "echo" };
+	string const expected[] = { "bravo", "echo", "charlie", "dog" };
+
+	for (unsigned int index = 0; index < 6; ++index)
+		ilist.enqueue(initial[index]);
+
+	assert(ilist.contains("charlie") && ilist.contains("echo") && !ilist.contains("golf"));
+
+	// Removal takes out the oldest occurrence and leaves the others in order.
+	ilist.remove("charlie");
+	ilist.remove("golf");
+	ilist.dequeue();
+	ilist.enqueue("charlie");
+	ilist.remove("charlie");
+	ilist.remove("dog");
+	ilist.enqueue("dog");
+
+	unsigned int index = 0;
+
+	for (IndexedQueueList<string, StringLengthHash>::Iterator itr = ilist.begin(); itr != ilist.end(); ++itr, ++index)
+		assert((index < 4 && *itr == expected[index]) && "IndexedQueueList changed the queue order");
+
+	assert(index == 4);
+
+	for (index = 0; index < 4; ++index)
+		assert(ilist.popFront() == expected[index]);
+
+	assert(ilist.isEmpty() && !ilist.contains("charlie") && !ilist.contains("dog"));
+	cout << "IndexedQueueList tests passed." << endl;
+}
+
+void testConcurrentQueue(unsigned int producerCount, unsigned int consumerCount)
+{
+	unsigned int const itemsPerProducer = 100000;
+	unsigned int const totalItems = itemsPerProducer * producerCount;
+
+	// Each item encodes its producer in the high bits and its sequence number in the low bits.
+	ConcurrentQueue<unsigned int> queue(1024);
+	vector<vector<unsigned int> > consumed(consumerCount);
+	vector<thread> threads;
+	unsigned int nodesCreated = QueueList<unsigned int>::getCreatedNodeCount();
+
+	for (unsigned int producer = 0; producer < producerCount; ++producer)
+	{
+		threads.push_back(thread([&queue, producer, itemsPerProducer]()
+		{
+			// Also churn a private QueueList so the shared node counters see contention.
+			QueueList<unsigned int> local;
+
+			for (unsigned int sequence = 0; sequence < itemsPerProducer; ++sequence)
+			{
+				local.enqueue(sequence);
+				local.dequeue();
+
+				while (!queue.enqueue((producer << 24) | sequence))
+					this_thread::yield();
+			}
+		}));
+	}
+
+	std::atomic<unsigned int> remaining(totalItems);
+
+	for (unsigned int consumer = 0; consumer < consumerCount; ++consumer)
+	{
+		threads.push_back(thread([&queue, &consumed, &remaining, consumer]()
+		{
+			unsigned int item;
+
+			while (remaining.load() > 0)
+			{
+				if (queue.dequeue(item))
+				{
+					consumed[consumer].push_back(item);
+					remaining.fetch_sub(1);
+				}
+				else
+					this_thread::yield();
+			}
+		}));
+	}
+
+	for (size_t index = 0; index < threads.size(); ++index)
+		threads[index].join();
+
+	// Every item arrives exactly once, and each consumer sees each producer's items in order.
+	vector<unsigned int> seen(totalItems, 0);
+
+	for (unsigned int consumer = 0; consumer < consumerCount; ++consumer)
+	{
+		vector<unsigned int> last(producerCount, 0);
+		vector<bool> any(producerCount, false);
+
+		for (size_t index = 0; index < consumed[consumer].size(); ++index)
+		{
+			unsigned int item = consumed[consumer][index];
+			unsigned int producer = item >> 24, sequence = item & 0xFFFFFF;
+
+			assert((producer < producerCount && sequence < itemsPerProducer) && "corrupted item");
+			assert((!any[producer] || last[producer] < sequence) && "items from one producer reordered");
+			any[producer] = true;
+			last[producer] = sequence;
+			++seen[producer * itemsPerProducer + sequence];
+		}
+	}
+
+	for (unsigned int index = 0; index < totalItems; ++index)
+		assert((seen[index] == 1) && "item lost or duplicated");
+
+	assert(queue.isEmpty());
+	assert((QueueList<unsigned int>::getCreatedNodeCount() - nodesCreated == totalItems)
+	    && (QueueList<unsigned int>::getCreatedNodeCount() == QueueList<unsigned int>::getDestroyedNodeCount())
+	    && "node counters lost updates across threads");
+
+	cout << "ConcurrentQueue: " << producerCount << " producers, " << consumerCount
+	     << " consumers, " << totalItems << " items passed." << endl;
+}
+
 void printString(string& testString)
 {
 	cout << ' ' << testString;
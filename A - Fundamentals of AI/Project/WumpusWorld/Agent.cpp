@@ -2,7 +2,9 @@
 //! \brief Implements the <code>fullsail_ai::fundamentals::Agent</code> class.
 //! \author Jeremiah Blanchard
 
+#include "../BehaviorTree/TraceRecorder.h"
 #include "Agent.h"
+#include "BatchBehavior.h"
 
 namespace fullsail_ai { namespace fundamentals {
 
@@ -10,19 +12,12 @@ namespace fullsail_ai { namespace fundamentals {
 	void Knowledge::init(unsigned _x, unsigned _y, unsigned width, unsigned height)
 	{
 		// Erase our knowledge of the world.
-		modelWorld.resize(width);
-		stimulus.resize(width);
-		for (unsigned xIndex = 0; xIndex < width; xIndex++)
-		{
-			stimulus[xIndex].resize(height);
-			modelWorld[xIndex].resize(height);
-
-			for (unsigned yIndex = 0; yIndex < height; yIndex++)
-			{
-				modelWorld[xIndex][yIndex] = UNKNOWN;
-				stimulus[xIndex][yIndex] = UNEXPLORED;
-			}
-		}
+		modelWorld.assign(width, height, (char)UNKNOWN);
+		stimulus.assign(width, height, UNEXPLORED);
+		possibleWumpusCells.assign(modelWorld.getCellCount());
+		frontier.assign(modelWorld.getCellCount());
+		explored.assign(modelWorld.getCellCount());
+		path.clear();
 
 		// Forget the previous wumpus location.
 		wumpusX = wumpusY = -1;
@@ -31,14 +26,67 @@ namespace fullsail_ai { namespace fundamentals {
 		x = _x;
 		y = _y;
 
-		// Forget about the gold.
+		// Forget about the gold, and pick up a fresh arrow.
 		hasGold = false;
+		hasArrow = true;
 	}
 
 	// Clear out Agent Knowledge
 	void Knowledge::shutdown()
 	{
 		modelWorld.clear();
+		possibleWumpusCells.clear();
+		frontier.clear();
+		explored.clear();
+		vector<unsigned>().swap(path);
+	}
+
+	void Knowledge::mark(unsigned _x, unsigned _y, char state)
+	{
+		unsigned cell = _x * modelWorld.getHeight() + _y;
+
+		modelWorld(_x, _y) = state;
+
+		if (state == POSSIBLE_WUMPUS || state == POSSIBLE_W_P)
+			possibleWumpusCells.insert(cell);
+		else
+			possibleWumpusCells.erase(cell);
+
+		updateFrontier(_x, _y);
+	}
+
+	void Knowledge::perceive(unsigned _x, unsigned _y, char percept)
+	{
+		stimulus(_x, _y) = percept;
+
+		if (!(percept & UNEXPLORED))
+			explored.insert(_x * modelWorld.getHeight() + _y);
+
+		updateFrontier(_x, _y);
+	}
+
+	void Knowledge::forgetPossibleWumpus()
+	{
+		unsigned height = modelWorld.getHeight();
+
+		// mark() takes each cell out of the set, so the set empties from the back.
+		while (!possibleWumpusCells.isEmpty())
+		{
+			unsigned cell = possibleWumpusCells[possibleWumpusCells.size() - 1];
+			unsigned cellX = cell / height, cellY = cell % height;
+
+			mark(cellX, cellY, modelWorld(cellX, cellY) == POSSIBLE_WUMPUS ? (char)UNKNOWN : (char)POSSIBLE_PIT);
+		}
+	}
+
+	void Knowledge::updateFrontier(unsigned _x, unsigned _y)
+	{
+		unsigned cell = _x * modelWorld.getHeight() + _y;
+
+		if (modelWorld(_x, _y) == CLEAR && (stimulus(_x, _y) & UNEXPLORED))
+			frontier.insert(cell);
+		else
+			frontier.erase(cell);
 	}
 
 	// Instantiate an agent.
@@ -58,24 +106,66 @@ namespace fullsail_ai { namespace fundamentals {
 	{
 		// Erase our knowledge of the world.
 		knowledge.init(_x, _y, world.getWidth(), world.getHeight());
+		running.reset();
 	}
 
-	// Update the agent's behavior.
+	// Update the agent's behavior, picking up where the last update left off if an action
+	// is still in progress.
 	void Agent::update()
 	{
+		TraceSpan span("Agent::update");
+
 		perceive();
-		behavior.run(behaviorLog, this);
+		Composite::resume(&behavior, running, behaviorLog, this);
+	}
+
+	// Update many agents that share a behavior tree.
+	void Agent::updateBatch(Agent* const* agents, size_t count, BatchBehavior* batch)
+	{
+		if (count == 0)
+			return;
+
+		if (batch == NULL)
+		{
+			for (size_t index = 0; index < count; index++)
+				agents[index]->update();
+
+			return;
+		}
+
+		TraceSpan span("Agent::updateBatch");
+
+		// Walking every agent's state once per node thrashes the cache for large crowds,
+		// so the crowd is run in slices small enough for their state to stay resident.
+		size_t const sliceSize = 64;
+		void* contexts[sliceSize];
+
+		for (size_t first = 0; first < count; first += sliceSize)
+		{
+			size_t sliceCount = (count - first < sliceSize) ? count - first : sliceSize;
+
+			for (size_t index = 0; index < sliceCount; index++)
+			{
+				agents[first + index]->perceive();
+				contexts[index] = agents[first + index];
+			}
+
+			batch->run(agents[first]->behaviorLog, contexts, sliceCount);
+		}
 	}
 
 	// Shut down the agent.
 	void Agent::exit()
 	{
 		knowledge.shutdown();
+		running.reset();
 	}
 
 	// Agent actions
 	bool Agent::pickUpGold()
 	{
+		TraceSpan span("Agent::pickUpGold");
+
 		if (world.retrieveGold())
 		{
 			knowledge.hasGold = true;
@@ -87,6 +177,8 @@ namespace fullsail_ai { namespace fundamentals {
 
 	bool Agent::move(Direction direction)
 	{
+		TraceSpan span("Agent::move");
+
 		if (world.moveAgent(direction))
 		{
 			switch (direction)
@@ -113,6 +205,8 @@ namespace fullsail_ai { namespace fundamentals {
 
 	bool Agent::shoot(Direction direction)
 	{
+		TraceSpan span("Agent::shoot");
+
 		if (knowledge.hasArrow)
 		{
 			world.attackWumpus(direction);
@@ -125,7 +219,9 @@ namespace fullsail_ai { namespace fundamentals {
 
 	void Agent::perceive()
 	{
+		TraceSpan span("Agent::perceive");
+
 		// Gather stimulus from the world state.
-		knowledge.stimulus[knowledge.x][knowledge.y] = world.getStimulus();
+		knowledge.perceive(knowledge.x, knowledge.y, world.getStimulus());
 	}
 }}
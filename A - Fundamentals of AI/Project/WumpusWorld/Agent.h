@@ -5,6 +5,10 @@
 #define _FULLSAIL_AI_FUNDAMENTALS_AGENT_H_
 
 #include <vector>
+#include "CellSet.h"
+#include "Grid2D.h"
+#include "ProbabilisticInference.h"
+#include "Behaviors.h"
 #include "World.h"
 #include "../BehaviorTree/Behavior.h"
 
@@ -18,8 +22,17 @@ namespace fullsail_ai { namespace fundamentals {
 		enum locationState { CLEAR = 0, DEFINITE_WUMPUS, DEFINITE_PIT,
 		                     POSSIBLE_WUMPUS, POSSIBLE_PIT, POSSIBLE_W_P, UNKNOWN = -1 };
 
-		vector<vector<char>> stimulus; // Stimulus perceived by the agent
-		vector<vector<char>> modelWorld; // Perceptions agent has had of world and information deduced
+		Grid2D<char> stimulus; // Stimulus perceived by the agent; write through perceive()
+		Grid2D<char> modelWorld; // Perceptions agent has had of world and information deduced; write through mark()
+
+		// Both sets are kept up to date by mark() and perceive(), so inference can visit just
+		// their members instead of sweeping the whole map.
+		CellSet possibleWumpusCells; // Cells marked POSSIBLE_WUMPUS or POSSIBLE_W_P
+		CellSet frontier; // Cells known to be CLEAR that are still UNEXPLORED
+		CellSet explored; // Cells the agent has perceived, kept by perceive()
+
+		ProbabilisticInference inference; // Pit and wumpus probabilities; refreshed by ExploreLeastRisky
+		std::vector<unsigned> path; // Cells PlanPathTo is following, goal first and next step last
 
 		unsigned x, y; // Location of agent in world currently
 		
@@ -30,8 +43,23 @@ namespace fullsail_ai { namespace fundamentals {
 
 		void init(unsigned _x, unsigned _y, unsigned width, unsigned height);
 		void shutdown();
+
+		// Sets the modelWorld state of (_x, _y), and its membership of the cell sets.
+		void mark(unsigned _x, unsigned _y, char state);
+
+		// Records the stimulus perceived at (_x, _y).
+		void perceive(unsigned _x, unsigned _y, char percept);
+
+		// Once the wumpus is found, no other cell can hold it: turns every POSSIBLE_WUMPUS
+		// into UNKNOWN and every POSSIBLE_W_P into POSSIBLE_PIT.
+		void forgetPossibleWumpus();
+
+	private:
+		void updateFrontier(unsigned _x, unsigned _y);
 	};
 
+	class BatchBehavior;
+
 	//! \brief The Agent class for this project
 	class Agent
 	{
@@ -43,6 +71,13 @@ namespace fullsail_ai { namespace fundamentals {
 		void update();
 		void exit();
 
+		// Updates every agent, one after another as update() would. Given a batch, runs
+		// them in one pass of the batch executor instead: the agents must then share the
+		// tree compiled into the batch and the behavior logging function, and the batch
+		// runs every tick from the root, so nothing is left running. The executor has not
+		// been measured faster than updating in turn, so it is only used when asked for.
+		static void updateBatch(Agent* const* agents, size_t count, BatchBehavior* batch = NULL);
+
 		// Agent actions
 		bool pickUpGold();
 		bool move(Direction direction);
@@ -54,6 +89,7 @@ namespace fullsail_ai { namespace fundamentals {
 		World& world; // The outside world.
 		Behavior& behavior; // Agent behavior
 		Knowledge knowledge; // Knowledge the agent has about the world.
+		RunningState running; // Where update() resumes the behavior, if a node was left running.
 		void (*behaviorLog)(Behavior const*); // Behavior loggin function.
 		// TODO: make behaviorLog a const pointer.
 	};
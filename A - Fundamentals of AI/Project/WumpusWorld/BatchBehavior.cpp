@@ -0,0 +1,68 @@
+//! \file BatchBehavior.cpp
+//! \brief Implements the <code>fullsail_ai::fundamentals::BatchBehavior</code> class.
+
+#include "../BehaviorTree/TraceRecorder.h"
+#include "BatchBehavior.h"
+
+namespace fullsail_ai { namespace fundamentals {
+
+	BatchBehavior::BatchBehavior(CompiledBehavior const& _tree) : tree(_tree)
+	{
+	}
+
+	size_t BatchBehavior::run(void (*dataFunction)(Behavior const*), void** contexts, size_t count)
+	{
+		if (count == 0)
+			return 0;
+
+		TraceSpan span("BatchBehavior::run");
+		return run(0, dataFunction, contexts, count);
+	}
+
+	size_t BatchBehavior::run(unsigned index, void (*dataFunction)(Behavior const*), void** contexts, size_t count)
+	{
+		CompiledBehavior::Entry const& entry = tree.getEntry(index);
+		size_t succeeded = 0;
+
+		if (entry.kind == CompiledBehavior::LEAF)
+		{
+			// Keep the successful contexts at the front, in order, and set the others aside.
+			failed.clear();
+
+			for (size_t contextIndex = 0; contextIndex < count; contextIndex++)
+			{
+				if (entry.behavior->run(dataFunction, contexts[contextIndex]))
+					contexts[succeeded++] = contexts[contextIndex];
+				else
+					failed.push_back(contexts[contextIndex]);
+			}
+
+			for (size_t failedIndex = 0; failedIndex < failed.size(); failedIndex++)
+				contexts[succeeded + failedIndex] = failed[failedIndex];
+
+			return succeeded;
+		}
+
+		unsigned end = index + entry.subtreeSize;
+
+		if (entry.kind == CompiledBehavior::SEQUENCE)
+		{
+			// The contexts that succeed at each child are the only ones that go on to the next.
+			succeeded = count;
+
+			for (unsigned child = index + 1; child < end && succeeded > 0; child += tree.getEntry(child).subtreeSize)
+				succeeded = run(child, dataFunction, contexts, succeeded);
+		}
+		else
+		{
+			// The contexts that fail at each child are the only ones that go on to the next.
+			for (unsigned child = index + 1; child < end && succeeded < count; child += tree.getEntry(child).subtreeSize)
+				succeeded += run(child, dataFunction, contexts + succeeded, count - succeeded);
+		}
+
+		for (size_t contextIndex = 0; contextIndex < succeeded; contextIndex++)
+			dataFunction(entry.behavior);
+
+		return succeeded;
+	}
+}}  // namespace fullsail_ai::fundamentals
@@ -0,0 +1,46 @@
+//! \file BatchBehavior.h
+//! \brief Defines the <code>fullsail_ai::fundamentals::BatchBehavior</code> class.
+#ifndef _FULLSAIL_AI_FUNDAMENTALS_BATCH_BEHAVIOR_H_
+#define _FULLSAIL_AI_FUNDAMENTALS_BATCH_BEHAVIOR_H_
+
+#include <vector>
+#include "CompiledBehavior.h"
+
+namespace fullsail_ai { namespace fundamentals {
+
+	//! \brief Runs one compiled behavior tree for many contexts (agents) at once.
+	//!
+	//! Each node is evaluated for every context that reaches it before the executor moves
+	//! on to the next node, so the node's code and data stay hot in cache. At each
+	//! <code>Sequence</code> and <code>Selector</code> the contexts are partitioned into
+	//! those that succeeded and those that failed, and only the ones that still need the
+	//! next child are passed on to it.
+	//!
+	//! \note
+	//!   - Every context gets the same result as running the tree for it alone, and sees
+	//!     its own <code>dataFunction</code> callbacks in the same order; callbacks for
+	//!     different contexts are interleaved.
+	//!   - Contexts must not depend on each other within a tick (for example, agents must
+	//!     not share a <code>World</code>), because they no longer run one after another.
+	class BatchBehavior
+	{
+		CompiledBehavior const& tree;
+		std::vector<void*> failed; // Scratch space for partitioning contexts at a leaf.
+
+		// Runs the subtree at the specified entry for the contexts in [contexts, contexts + count).
+		// Reorders them so the successful ones come first and returns how many succeeded.
+		size_t run(unsigned index, void (*dataFunction)(Behavior const*), void** contexts, size_t count);
+
+	public:
+		//! \brief Creates an executor for the specified tree, which must outlive it.
+		explicit BatchBehavior(CompiledBehavior const& _tree);
+
+		//! \brief Executes the tree for each of the \a count contexts.
+		//!
+		//! \return  The number of contexts for which the tree succeeded. Those contexts are
+		//!          moved to the front of \a contexts, and the failed ones follow them.
+		size_t run(void (*dataFunction)(Behavior const*), void** contexts, size_t count);
+	};
+}}  // namespace fullsail_ai::fundamentals
+
+#endif  // _FULLSAIL_AI_FUNDAMENTALS_BATCH_BEHAVIOR_H_
@@ -0,0 +1,516 @@
+//! \file BehaviorImage.cpp
+//! \brief Implements the <code>fullsail_ai::fundamentals::BehaviorImage</code> class.
+
+#include <cstddef>
+#include <cstring>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include "BehaviorImage.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace fullsail_ai { namespace fundamentals {
+
+	namespace {
+
+		char const magic[4] = { 'B', 'T', 'R', 'E' };
+
+		void fail(unsigned line, std::string const& message)
+		{
+			throw std::runtime_error("line " + std::to_string(line) + ": " + message);
+		}
+
+		bool isNameCharacter(char character)
+		{
+			return (character >= 'A' && character <= 'Z') || (character >= 'a' && character <= 'z')
+			    || (character >= '0' && character <= '9') || character == '_';
+		}
+
+		// Builds the string table, storing each distinct string once.
+		struct StringTable
+		{
+			std::string bytes;
+			std::map<std::string, std::uint32_t> offsets;
+
+			std::uint32_t intern(std::string const& text)
+			{
+				std::map<std::string, std::uint32_t>::const_iterator found = offsets.find(text);
+
+				if (found != offsets.end())
+					return found->second;
+
+				std::uint32_t offset = (std::uint32_t)bytes.size();
+				bytes.append(text);
+				bytes.push_back('\0');
+				offsets[text] = offset;
+				return offset;
+			}
+		};
+	}
+
+	std::vector<char> BehaviorImage::compile(char const* text, BehaviorRegistry const& registry)
+	{
+		// The lines above the current one that may still take children: indentation and node.
+		std::vector<std::pair<size_t, std::uint32_t> > open;
+		std::vector<BehaviorRegistry::NodeType const*> usedTypes;
+		std::vector<std::uint32_t> typeNames;
+		std::vector<Node> tree;
+		StringTable strings;
+		unsigned line = 0;
+
+		for (char const* cursor = text; *cursor != '\0'; )
+		{
+			char const* end = cursor;
+
+			while (*end != '\0' && *end != '\n')
+				end++;
+
+			char const* next = (*end == '\n') ? end + 1 : end;
+
+			line++;
+
+			// Trailing carriage returns and spaces are not part of the line.
+			while (end > cursor && (end[-1] == '\r' || end[-1] == ' ' || end[-1] == '\t'))
+				end--;
+
+			char const* position = cursor;
+
+			while (position < end && (*position == ' ' || *position == '\t'))
+				position++;
+
+			size_t indent = position - cursor;
+			cursor = next;
+
+			if (position == end || *position == '#')
+				continue;
+
+			// The type name.
+			char const* name = position;
+
+			while (position < end && isNameCharacter(*position))
+				position++;
+
+			BehaviorRegistry::NodeType const* type = registry.find(name, position - name);
+
+			if (position == name)
+				fail(line, "expected a node type");
+
+			if (type == NULL)
+				fail(line, "unknown node type \"" + std::string(name, position) + "\"");
+
+			// The description.
+			while (position < end && (*position == ' ' || *position == '\t'))
+				position++;
+
+			if (position == end || *position != '"')
+				fail(line, "expected a quoted description");
+
+			std::string description;
+
+			for (position++; position < end && *position != '"'; position++)
+			{
+				if (*position == '\\' && position + 1 < end)
+					position++;
+
+				description.push_back(*position);
+			}
+
+			if (position == end)
+				fail(line, "unterminated description");
+
+			position++;
+
+			// The parameter, if the type takes one.
+			while (position < end && (*position == ' ' || *position == '\t'))
+				position++;
+
+			char const* parameterName = position;
+
+			while (position < end && isNameCharacter(*position))
+				position++;
+
+			std::uint32_t parameter = 0;
+
+			if (type->parameterCount == 0)
+			{
+				if (position != parameterName)
+					fail(line, std::string(type->name) + " takes no parameter");
+			}
+			else
+			{
+				while (parameter < type->parameterCount
+				       && (std::strncmp(type->parameterNames[parameter], parameterName, position - parameterName) != 0
+				           || type->parameterNames[parameter][position - parameterName] != '\0'))
+					parameter++;
+
+				if (position == parameterName || parameter == type->parameterCount)
+					fail(line, "expected a parameter of " + std::string(type->name));
+			}
+
+			while (position < end && (*position == ' ' || *position == '\t'))
+				position++;
+
+			if (position < end && *position != '#')
+				fail(line, "unexpected \"" + std::string(position, end) + "\"");
+
+			// Find the parent among the lines above.
+			while (!open.empty() && open.back().first >= indent)
+				open.pop_back();
+
+			if (open.empty() && !tree.empty())
+				fail(line, "a tree has only one root");
+
+			std::uint32_t index = (std::uint32_t)tree.size();
+			Node node = { 0, parameter, strings.intern(description), index, 1 };
+
+			if (!open.empty())
+			{
+				node.parent = open.back().second;
+
+				if (usedTypes[tree[node.parent].type]->kind == CompiledBehavior::LEAF)
+					fail(line, std::string(usedTypes[tree[node.parent].type]->name) + " cannot have children");
+			}
+
+			while (node.type < usedTypes.size() && usedTypes[node.type] != type)
+				node.type++;
+
+			if (node.type == usedTypes.size())
+			{
+				usedTypes.push_back(type);
+				typeNames.push_back(strings.intern(type->name));
+			}
+
+			tree.push_back(node);
+			open.push_back(std::make_pair(indent, index));
+		}
+
+		if (tree.empty())
+			fail(line, "the text holds no tree");
+
+		// Each subtree follows its root, so adding sizes from the back totals every subtree
+		// before it is added to its parent.
+		for (size_t index = tree.size() - 1; index > 0; index--)
+			tree[tree[index].parent].subtreeSize += tree[index].subtreeSize;
+
+		Header header = { { magic[0], magic[1], magic[2], magic[3] }, VERSION, (std::uint32_t)typeNames.size(),
+		                  (std::uint32_t)tree.size(), (std::uint32_t)strings.bytes.size() };
+		std::vector<char> image(sizeof(Header) + typeNames.size() * sizeof(std::uint32_t) + tree.size() * sizeof(Node)
+		                        + strings.bytes.size());
+		char* out = &image[0];
+
+		std::memcpy(out, &header, sizeof(Header));
+		out += sizeof(Header);
+		std::memcpy(out, &typeNames[0], typeNames.size() * sizeof(std::uint32_t));
+		out += typeNames.size() * sizeof(std::uint32_t);
+		std::memcpy(out, &tree[0], tree.size() * sizeof(Node));
+		out += tree.size() * sizeof(Node);
+		std::memcpy(out, strings.bytes.data(), strings.bytes.size());
+		return image;
+	}
+
+	BehaviorImage::BehaviorImage(void const* _data, size_t _size, BehaviorRegistry const& registry)
+		: Behavior(""), data(_data), size(_size), view(NULL), fileMapping(NULL), nodes(NULL), strings(NULL), storage(NULL)
+	{
+		load(registry);
+	}
+
+	BehaviorImage::BehaviorImage(char const* path, BehaviorRegistry const& registry)
+		: Behavior(""), data(NULL), size(0), view(NULL), fileMapping(NULL), nodes(NULL), strings(NULL), storage(NULL)
+	{
+#if defined(_WIN32)
+		HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+		LARGE_INTEGER fileSize;
+
+		fileSize.QuadPart = 0;
+
+		if (file == INVALID_HANDLE_VALUE)
+			throw std::runtime_error(std::string("cannot open ") + path);
+
+		if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0)
+		{
+			fileMapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+
+			if (fileMapping != NULL)
+				view = MapViewOfFile(fileMapping, FILE_MAP_READ, 0, 0, 0);
+		}
+
+		// The mapping keeps the file open.
+		CloseHandle(file);
+		size = (size_t)fileSize.QuadPart;
+#else
+		int file = open(path, O_RDONLY);
+		struct stat status;
+
+		if (file < 0)
+			throw std::runtime_error(std::string("cannot open ") + path);
+
+		if (fstat(file, &status) == 0 && status.st_size > 0)
+		{
+			size = (size_t)status.st_size;
+			view = mmap(NULL, size, PROT_READ, MAP_PRIVATE, file, 0);
+
+			if (view == MAP_FAILED)
+				view = NULL;
+		}
+
+		// The mapping keeps the file open.
+		close(file);
+#endif
+
+		if (view == NULL)
+		{
+			unmap();
+			throw std::runtime_error(std::string("cannot map ") + path);
+		}
+
+		data = view;
+
+		// The destructor does not run for a constructor that throws; load() frees any
+		// nodes it built, and the mapping is freed here.
+		try
+		{
+			load(registry);
+		}
+		catch (...)
+		{
+			unmap();
+			throw;
+		}
+	}
+
+	BehaviorImage::~BehaviorImage()
+	{
+		for (size_t index = objects.size(); index-- > 0; )
+			types[nodes[index].type]->destroy(objects[index]);
+
+		::operator delete(storage);
+		unmap();
+	}
+
+	void BehaviorImage::unmap()
+	{
+#if defined(_WIN32)
+		if (view != NULL)
+			UnmapViewOfFile(view);
+
+		if (fileMapping != NULL)
+			CloseHandle(fileMapping);
+#else
+		if (view != NULL)
+			munmap(view, size);
+#endif
+
+		view = fileMapping = NULL;
+	}
+
+	void BehaviorImage::load(BehaviorRegistry const& registry)
+	{
+		Header header;
+
+		if (size < sizeof(Header) || ((std::uintptr_t)data % alignof(Node)) != 0)
+			throw std::runtime_error("not a behavior image: too small or misaligned");
+
+		std::memcpy(&header, data, sizeof(Header));
+
+		if (std::memcmp(header.magic, magic, 4) != 0 || header.version != VERSION)
+			throw std::runtime_error("not a behavior image, or an unsupported version");
+
+		unsigned long long expected = sizeof(Header) + (unsigned long long)header.typeCount * sizeof(std::uint32_t)
+		                            + (unsigned long long)header.nodeCount * sizeof(Node) + header.stringBytes;
+
+		if (expected != size || header.nodeCount == 0 || header.stringBytes == 0)
+			throw std::runtime_error("behavior image has the wrong size");
+
+		char const* bytes = static_cast<char const*>(data);
+		std::uint32_t const* typeNames = reinterpret_cast<std::uint32_t const*>(bytes + sizeof(Header));
+		nodes = reinterpret_cast<Node const*>(typeNames + header.typeCount);
+		strings = reinterpret_cast<char const*>(nodes + header.nodeCount);
+
+		// Every string ends inside the table, since the table ends in a NUL.
+		if (strings[header.stringBytes - 1] != '\0')
+			throw std::runtime_error("behavior image string table is not terminated");
+
+		types.resize(header.typeCount);
+
+		for (std::uint32_t index = 0; index < header.typeCount; index++)
+		{
+			if (typeNames[index] >= header.stringBytes)
+				throw std::runtime_error("behavior image type name is out of range");
+
+			types[index] = registry.find(strings + typeNames[index]);
+
+			if (types[index] == NULL)
+				throw std::runtime_error(std::string("unknown node type \"") + (strings + typeNames[index]) + "\"");
+		}
+
+		// Check the fields the executor trusts; each node must sit inside its parent's
+		// subtree, right after its previous sibling's.
+		std::vector<std::uint32_t> ancestors;
+		size_t blockSize = 0;
+
+		for (std::uint32_t index = 0; index < header.nodeCount; index++)
+		{
+			Node const& node = nodes[index];
+
+			if (node.type >= header.typeCount || node.description >= header.stringBytes
+			    || node.parameter >= (types[node.type]->parameterCount ? types[node.type]->parameterCount : 1)
+			    || node.subtreeSize == 0 || node.subtreeSize > header.nodeCount - index
+			    || (types[node.type]->kind == CompiledBehavior::LEAF && node.subtreeSize != 1))
+				throw std::runtime_error("behavior image node is malformed");
+
+			while (!ancestors.empty() && ancestors.back() + nodes[ancestors.back()].subtreeSize <= index)
+				ancestors.pop_back();
+
+			if (index == 0 ? (node.parent != 0 || node.subtreeSize != header.nodeCount)
+			               : (ancestors.empty() || node.parent != ancestors.back()
+			                  || index + node.subtreeSize > node.parent + nodes[node.parent].subtreeSize))
+				throw std::runtime_error("behavior image tree structure is malformed");
+
+			ancestors.push_back(index);
+
+			if (types[node.type]->alignment > alignof(std::max_align_t))
+				throw std::runtime_error("node type is over-aligned");
+
+			blockSize = (blockSize + types[node.type]->alignment - 1) / types[node.type]->alignment * types[node.type]->alignment;
+			blockSize += types[node.type]->size;
+		}
+
+		// One block for every node.
+		objects.reserve(header.nodeCount);
+		storage = ::operator new(blockSize);
+		blockSize = 0;
+
+		try
+		{
+			for (std::uint32_t index = 0; index < header.nodeCount; index++)
+			{
+				BehaviorRegistry::NodeType const* type = types[nodes[index].type];
+
+				blockSize = (blockSize + type->alignment - 1) / type->alignment * type->alignment;
+				objects.push_back(type->construct(static_cast<char*>(storage) + blockSize, strings + nodes[index].description,
+				                                  nodes[index].parameter));
+				blockSize += type->size;
+			}
+		}
+		catch (...)
+		{
+			// The destructor does not run for a constructor that throws: undo the nodes
+			// built so far here.
+			for (size_t index = objects.size(); index-- > 0; )
+				types[nodes[index].type]->destroy(objects[index]);
+
+			objects.clear();
+			::operator delete(storage);
+			storage = NULL;
+			throw;
+		}
+
+		description = strings + nodes[0].description;
+	}
+
+	size_t BehaviorImage::getNodeCount() const
+	{
+		return objects.size();
+	}
+
+	Behavior const* BehaviorImage::getNode(size_t index) const
+	{
+		return objects[index];
+	}
+
+	Behavior* BehaviorImage::instantiate() const
+	{
+		std::vector<Behavior*> created(objects.size());
+
+		for (size_t index = 0; index < objects.size(); index++)
+		{
+			BehaviorRegistry::NodeType const* type = types[nodes[index].type];
+
+			created[index] = type->construct(::operator new(type->size), strings + nodes[index].description, nodes[index].parameter);
+
+			if (index > 0)
+				created[nodes[index].parent]->addChild(created[index]);
+		}
+
+		return created[0];
+	}
+
+	Behavior* BehaviorImage::instantiate(BehaviorArena& arena) const
+	{
+		std::vector<Behavior*> created(objects.size());
+
+		for (size_t index = 0; index < objects.size(); index++)
+		{
+			BehaviorRegistry::NodeType const* type = types[nodes[index].type];
+
+			created[index] = type->construct(arena.allocate(type->size, type->alignment), strings + nodes[index].description, nodes[index].parameter);
+			arena.adopt(created[index]);
+
+			if (index > 0)
+				created[nodes[index].parent]->addChild(created[index]);
+		}
+
+		return created[0];
+	}
+
+	bool BehaviorImage::run(void (*dataFunction)(Behavior const*), void* context)
+	{
+		// The same walk as CompiledBehavior::run(), over the image's own nodes.
+		Node const* base = nodes;
+		Behavior* const* object = &objects[0];
+		BehaviorRegistry::NodeType const* const* type = &types[0];
+		std::uint32_t index = 0;
+		bool result;
+
+		for (;;)
+		{
+			CompiledBehavior::Kind kind = type[base[index].type]->kind;
+
+			if (kind == CompiledBehavior::LEAF)
+				result = object[index]->run(dataFunction, context);
+			else if (base[index].subtreeSize > 1)
+			{
+				index++;
+				continue;
+			}
+			else
+			{
+				// An empty sequence succeeds and an empty selector fails.
+				result = (kind == CompiledBehavior::SEQUENCE);
+
+				if (result)
+					dataFunction(object[index]);
+			}
+
+			// Hand the result up until some composite needs to run its next child.
+			for (;;)
+			{
+				if (index == 0)
+					return result;
+
+				std::uint32_t parentIndex = base[index].parent;
+				std::uint32_t next = index + base[index].subtreeSize;
+				bool sequence = (type[base[parentIndex].type]->kind == CompiledBehavior::SEQUENCE);
+
+				if (result == sequence && next < parentIndex + base[parentIndex].subtreeSize)
+				{
+					index = next;
+					break;
+				}
+
+				if (result)
+					dataFunction(object[parentIndex]);
+
+				index = parentIndex;
+			}
+		}
+	}
+}}  // namespace fullsail_ai::fundamentals
@@ -0,0 +1,130 @@
+//! \file BehaviorImage.h
+//! \brief Defines the <code>fullsail_ai::fundamentals::BehaviorImage</code> class.
+#ifndef _FULLSAIL_AI_FUNDAMENTALS_BEHAVIOR_IMAGE_H_
+#define _FULLSAIL_AI_FUNDAMENTALS_BEHAVIOR_IMAGE_H_
+
+#include <cstdint>
+#include <vector>
+#include "../BehaviorTree/BehaviorArena.h"
+#include "BehaviorRegistry.h"
+
+namespace fullsail_ai { namespace fundamentals {
+
+	//! \brief A behavior tree loaded from its binary form and executed in place.
+	//!
+	//! Trees are authored as text, one node per line, children indented under their
+	//! parent:
+	//!
+	//! \code
+	//! # Comments run to the end of the line.
+	//! Sequence "Basic Behavior"
+	//!     ProcessPercepts "Process Percepts"
+	//!     Selector "Explore"
+	//!         ExploreDirection "Explore Up" UP
+	//! \endcode
+	//!
+	//! Each line names a type of the <code>BehaviorRegistry</code>, a quoted description
+	//! (<code>\\"</code> and <code>\\\\</code> escape), and the type's parameter, if it has
+	//! one. A line is a child of the nearest line above it that is indented less;
+	//! indentation is compared character for character, so a file should not mix tabs and
+	//! spaces. <code>compile()</code> turns the text into the binary form:
+	//!
+	//!   - a <code>Header</code>;
+	//!   - <code>typeCount</code> string offsets, naming the types the tree uses;
+	//!   - <code>nodeCount</code> <code>Node</code>s in pre-order, which the executor walks
+	//!     directly;
+	//!   - <code>stringBytes</code> of NUL-terminated strings, each stored once however
+	//!     many nodes share it.
+	//!
+	//! Every field is a little-endian 32-bit integer, so a file can be mapped and used
+	//! without parsing or copying. Loading validates the image, resolves each type name
+	//! once, and constructs the nodes into a single block for the executor to call and to
+	//! report; their descriptions point into the image.
+	//!
+	//! \note
+	//!   - <code>run()</code> walks sequences and selectors like <code>CompiledBehavior</code>,
+	//!     and runs every other node through its own <code>run()</code>. The constructed
+	//!     nodes are not linked to their children; <code>instantiate()</code> builds an
+	//!     ordinary pointer tree when one is needed.
+	//!   - Only <code>Sequence</code>- and <code>Selector</code>-kind types may have children.
+	//!   - Malformed text or images throw <code>std::runtime_error</code>.
+	class BehaviorImage : public Behavior
+	{
+	public:
+		//! \brief The start of an image.
+		struct Header
+		{
+			char magic[4]; // "BTRE"
+			std::uint32_t version;
+			std::uint32_t typeCount;
+			std::uint32_t nodeCount;
+			std::uint32_t stringBytes;
+		};
+
+		//! \brief One node of an image. Offsets are into the string table.
+		struct Node
+		{
+			std::uint32_t type; // Index into the image's type names
+			std::uint32_t parameter; // Index into the type's parameter names, or 0
+			std::uint32_t description;
+			std::uint32_t parent; // Index of the parent node (the root is its own parent)
+			std::uint32_t subtreeSize; // Number of nodes in this subtree, including this one
+		};
+
+		enum { VERSION = 1 };
+
+	private:
+		void const* data;
+		size_t size;
+		void* view; // The mapped file, if the image was loaded from one
+		void* fileMapping; // The mapping handle, on Windows
+		Node const* nodes;
+		char const* strings;
+		std::vector<BehaviorRegistry::NodeType const*> types; // Resolved, one per image type
+		std::vector<Behavior*> objects; // The constructed nodes, in pre-order
+		void* storage; // The block the nodes were constructed in
+
+		void load(BehaviorRegistry const& registry);
+		void unmap();
+
+		BehaviorImage(BehaviorImage const&) = delete;
+		BehaviorImage& operator=(BehaviorImage const&) = delete;
+
+	public:
+		//! \brief Loads the image at \a _data, which must stay valid, unchanged, for the
+		//! lifetime of this object, and be aligned to 4 bytes.
+		BehaviorImage(void const* _data, size_t _size, BehaviorRegistry const& registry = BehaviorRegistry::getDefault());
+
+		//! \brief Maps the image file at \a path into memory and loads it from there.
+		explicit BehaviorImage(char const* path, BehaviorRegistry const& registry = BehaviorRegistry::getDefault());
+
+		~BehaviorImage();
+
+		//! \brief Compiles the text of a tree into an image.
+		static std::vector<char> compile(char const* text, BehaviorRegistry const& registry = BehaviorRegistry::getDefault());
+
+		//! \brief Returns the number of nodes in the tree.
+		size_t getNodeCount() const;
+
+		//! \brief Returns the node at the specified pre-order index, as reported by
+		//! <code>run()</code>.
+		//!
+		//! \pre      \a index <code>\< getNodeCount()</code>
+		Behavior const* getNode(size_t index) const;
+
+		//! \brief Builds the tree as ordinary nodes, one allocation each, to be deleted the
+		//! same way as a tree built by hand. Their descriptions point into the image,
+		//! which must outlive them.
+		Behavior* instantiate() const;
+
+		//! \brief Builds the tree as ordinary nodes in \a arena, which owns them. Their
+		//! descriptions point into the image, which must outlive them.
+		Behavior* instantiate(BehaviorArena& arena) const;
+
+		//! \brief Executes the tree. Returns true (and runs dataFunction on each node that
+		//! succeeds) on success, false otherwise, exactly like running the tree's root.
+		bool run(void (*dataFunction)(Behavior const*), void* context);
+	};
+}}  // namespace fullsail_ai::fundamentals
+
+#endif  // _FULLSAIL_AI_FUNDAMENTALS_BEHAVIOR_IMAGE_H_
@@ -0,0 +1,271 @@
+//! \file BehaviorLog.cpp
+//! \brief Implements the <code>fullsail_ai::fundamentals::BehaviorLog</code> class.
+
+#include <chrono>
+#include <cstring>
+#include "BehaviorLog.h"
+
+namespace fullsail_ai { namespace fundamentals {
+
+	namespace {
+		// Counts the logs destroyed so far. A context set up before the latest one may
+		// point at it, so it logs nothing until its thread's next beginTick().
+		std::atomic<unsigned long long> destroyedLogs(0);
+
+		// The tick this thread is logging for, set by beginTick().
+		struct Context
+		{
+			BehaviorLog* log;
+			unsigned long long generation; // destroyedLogs when beginTick() ran
+			std::uint32_t agent;
+			std::uint32_t tick;
+			bool active; // Whether the tick passed the sampling and the filter
+
+			bool isActive() const
+			{
+				return active && generation == destroyedLogs.load(std::memory_order_acquire);
+			}
+		};
+
+		thread_local Context context = { NULL, 0, 0, 0, false };
+
+		char const* const statusNames[] = { "FAILURE", "SUCCESS", "RUNNING" };
+	}
+
+	BehaviorLog::BehaviorLog(std::FILE* _output, Format _format, Formatter _formatter, size_t capacity)
+		: events(capacity), output(_output), format(_format), formatter(_formatter), samplingPeriod(1),
+		  added(0), written(0), flushRequested(0), stopping(false)
+	{
+		if (format == BINARY)
+		{
+			std::uint32_t version = 1;
+
+			std::fwrite("BLOG", 1, 4, output);
+			std::fwrite(&version, sizeof(version), 1, output);
+		}
+
+		writer = std::thread(&BehaviorLog::write, this);
+	}
+
+	BehaviorLog::~BehaviorLog()
+	{
+		flush();
+
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			stopping = true;
+		}
+
+		wake.notify_one();
+		writer.join();
+
+		// Threads that logged here may still hold this log in their contexts.
+		destroyedLogs.fetch_add(1, std::memory_order_release);
+	}
+
+	void BehaviorLog::setSampling(unsigned period)
+	{
+		samplingPeriod = period ? period : 1;
+	}
+
+	void BehaviorLog::setAgentFilter(std::vector<unsigned> const& agents)
+	{
+		agentFilter.clear();
+
+		for (size_t index = 0; index < agents.size(); index++)
+		{
+			if (agents[index] >= agentFilter.size())
+				agentFilter.resize(agents[index] + 1, false);
+
+			agentFilter[agents[index]] = true;
+		}
+	}
+
+	bool BehaviorLog::beginTick(unsigned agent, unsigned tick)
+	{
+		context.log = this;
+		context.generation = destroyedLogs.load(std::memory_order_acquire);
+		context.agent = agent;
+		context.tick = tick;
+		context.active = tick % samplingPeriod == 0 &&
+		                 (agentFilter.empty() || (agent < agentFilter.size() && agentFilter[agent]));
+
+		if (context.active)
+		{
+			Event event = { NULL, agent, tick, 0, 0, TICK, 0 };
+			add(event);
+		}
+
+		return context.active;
+	}
+
+	void BehaviorLog::logNode(Behavior const* node)
+	{
+		if (context.isActive())
+		{
+			Event event = { node, context.agent, context.tick, 0, 0, NODE, Behavior::SUCCESS };
+			context.log->add(event);
+		}
+	}
+
+	void BehaviorLog::logLeaf(Behavior const* node)
+	{
+		if (context.isActive() && node->isLeaf())
+		{
+			Event event = { node, context.agent, context.tick, 0, 0, NODE, Behavior::SUCCESS };
+			context.log->add(event);
+		}
+	}
+
+	void BehaviorLog::logStatus(World const& world)
+	{
+		if (context.log != this || !context.isActive())
+			return;
+
+		Event event = { NULL, context.agent, context.tick, (std::uint16_t)world.getAgentX(),
+		                (std::uint16_t)world.getAgentY(), STATUS, 0 };
+
+		event.result = (world.doesAgentHaveArrow() ? HAS_ARROW : 0) | (world.isGoldRetrieved() ? HAS_GOLD : 0) |
+		               (world.isAgentAlive() ? AGENT_ALIVE : 0) | (world.isWumpusAlive() ? WUMPUS_ALIVE : 0);
+		add(event);
+	}
+
+	void BehaviorLog::flush()
+	{
+		unsigned long long target = added.load(std::memory_order_acquire);
+		std::unique_lock<std::mutex> lock(mutex);
+
+		if (written.load(std::memory_order_acquire) >= target)
+			return;
+
+		if (target > flushRequested)
+			flushRequested = target;
+
+		wake.notify_one();
+		drained.wait(lock, [this, target]() { return written.load(std::memory_order_acquire) >= target; });
+	}
+
+	unsigned long long BehaviorLog::getWrittenCount() const
+	{
+		return written.load(std::memory_order_acquire);
+	}
+
+	void BehaviorLog::formatEvent(Event const& event, std::string& text)
+	{
+		char line[128];
+
+		switch (event.kind)
+		{
+		case TICK:
+			std::snprintf(line, sizeof(line), "%u\t%u\ttick\n", event.agent, event.tick);
+			text += line;
+			break;
+
+		case NODE:
+			std::snprintf(line, sizeof(line), "%u\t%u\tnode\t", event.agent, event.tick);
+			text += line;
+			text += event.node->toString();
+			text += '\t';
+			text += statusNames[event.result];
+			text += '\n';
+			break;
+
+		case STATUS:
+			std::snprintf(line, sizeof(line), "%u\t%u\tstatus\t(%u, %u)\tarrow=%d gold=%d alive=%d wumpus=%d\n",
+			              event.agent, event.tick, event.x, event.y, (event.result & HAS_ARROW) != 0,
+			              (event.result & HAS_GOLD) != 0, (event.result & AGENT_ALIVE) != 0,
+			              (event.result & WUMPUS_ALIVE) != 0);
+			text += line;
+			break;
+		}
+	}
+
+	void BehaviorLog::add(Event const& event)
+	{
+		// Full: wake the writer and wait for room rather than lose the event.
+		while (!events.enqueue(event))
+		{
+			wake.notify_one();
+			std::this_thread::yield();
+		}
+
+		added.fetch_add(1, std::memory_order_release);
+	}
+
+	void BehaviorLog::write()
+	{
+		std::string buffer;
+		std::unique_lock<std::mutex> lock(mutex);
+
+		for (;;)
+		{
+			// Every few milliseconds, or as soon as flush() asks.
+			wake.wait_for(lock, std::chrono::milliseconds(10), [this]()
+			{
+				return stopping || flushRequested > written.load(std::memory_order_relaxed);
+			});
+
+			bool stop = stopping;
+
+			lock.unlock();
+			drain(buffer);
+			lock.lock();
+			drained.notify_all();
+
+			if (stop && events.isEmpty())
+				return;
+		}
+	}
+
+	void BehaviorLog::drain(std::string& buffer)
+	{
+		// No more than a queue's worth a batch, so that busy loggers cannot hold the
+		// writer back from writing.
+		size_t limit = events.getCapacity();
+		unsigned long long count = 0;
+		Event event;
+
+		buffer.clear();
+
+		for (; count < limit && events.dequeue(event); count++)
+		{
+			if (format == TEXT)
+			{
+				formatter(event, buffer);
+				continue;
+			}
+
+			BinaryRecord record = { event.agent, event.tick, 0, event.kind, event.result, 0 };
+
+			if (event.kind == NODE)
+			{
+				std::unordered_map<Behavior const*, std::uint32_t>::iterator entry = nodeIds.find(event.node);
+
+				if (entry == nodeIds.end())
+				{
+					char const* name = event.node->toString();
+					size_t length = std::strlen(name);
+					BinaryRecord nameRecord = { event.agent, event.tick, (std::uint32_t)nodeIds.size(), NAME, 0,
+					                            (std::uint16_t)(length < 0xFFFF ? length : 0xFFFF) };
+
+					entry = nodeIds.insert(std::make_pair(event.node, nameRecord.data)).first;
+					buffer.append(reinterpret_cast<char const*>(&nameRecord), sizeof(nameRecord));
+					buffer.append(name, nameRecord.length);
+				}
+
+				record.data = entry->second;
+			}
+			else if (event.kind == STATUS)
+				record.data = (std::uint32_t)event.x << 16 | event.y;
+
+			buffer.append(reinterpret_cast<char const*>(&record), sizeof(record));
+		}
+
+		if (count == 0)
+			return;
+
+		std::fwrite(buffer.data(), 1, buffer.size(), output);
+		std::fflush(output);
+		written.fetch_add(count, std::memory_order_release);
+	}
+}}  // namespace fullsail_ai::fundamentals
@@ -0,0 +1,161 @@
+//! \file BehaviorLog.h
+//! \brief Defines the <code>fullsail_ai::fundamentals::BehaviorLog</code> class.
+#ifndef _FULLSAIL_AI_FUNDAMENTALS_BEHAVIOR_LOG_H_
+#define _FULLSAIL_AI_FUNDAMENTALS_BEHAVIOR_LOG_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "../BehaviorTree/Behavior.h"
+#include "../QueueList/ConcurrentQueue.h"
+#include "World.h"
+
+namespace fullsail_ai { namespace fundamentals {
+
+	//! \brief Records what agents' behavior trees report as compact events, and writes them
+	//! out on a background thread.
+	//!
+	//! A thread starts each agent update with <code>beginTick()</code>, which decides whether
+	//! the update is logged at all (sampling and the agent filter) and remembers the agent
+	//! and tick for the events that follow. <code>logNode()</code> and
+	//! <code>logLeaf()</code> are data functions for <code>Agent</code> and the tree runners;
+	//! they and <code>logStatus()</code> add an event to a queue allocated up front, and a
+	//! writer thread drains the queue in batches, one write per batch. A full queue makes
+	//! the logging thread wait for room rather than lose events.
+	//!
+	//! TEXT output renders every event through a formatter. BINARY output starts with the
+	//! bytes "BLOG" and a 32-bit version, 1, followed by 16-byte records of
+	//! <code>BinaryRecord</code> in the host's byte order; a NAME record, followed by the
+	//! node's name, comes before the first record that refers to a node.
+	//!
+	//! \note
+	//!   - Data functions only see nodes that succeeded, so node events carry
+	//!     <code>Behavior::SUCCESS</code>.
+	//!   - Nodes are named when the writer gets to them: keep every logged tree alive until
+	//!     <code>flush()</code> has returned. BINARY output names a node once, by its
+	//!     address, so a log should not see a tree built where a deleted one was.
+	//!   - Start each update with <code>beginTick()</code>; a thread logs nothing before.
+	//!   - Destroy a log only once no thread is logging to it. A thread whose last
+	//!     <code>beginTick()</code> went to a log since destroyed logs nothing until its
+	//!     next <code>beginTick()</code>.
+	//!   - Set the sampling and the agent filter while no thread is logging.
+	class BehaviorLog
+	{
+	public:
+		enum Format { TEXT, BINARY };
+
+		//! \brief What an event records.
+		enum Kind
+		{
+			TICK = 0, // An update logged by beginTick()
+			NODE, // A node reported to logNode() or logLeaf()
+			STATUS, // The state of the world, from logStatus()
+			NAME // BINARY output only: the name of a node
+		};
+
+		//! \brief The bits of a STATUS event's flags.
+		enum StatusFlag { HAS_ARROW = 1, HAS_GOLD = 2, AGENT_ALIVE = 4, WUMPUS_ALIVE = 8 };
+
+		//! \brief One event, as queued and as passed to a formatter.
+		struct Event
+		{
+			Behavior const* node; // NODE events only
+			std::uint32_t agent;
+			std::uint32_t tick;
+			std::uint16_t x, y; // STATUS events only: the agent's position
+			std::uint8_t kind;
+			std::uint8_t result; // Behavior::Status of a NODE event; StatusFlag bits of a STATUS event
+		};
+
+		//! \brief One record of BINARY output.
+		struct BinaryRecord
+		{
+			std::uint32_t agent;
+			std::uint32_t tick;
+			std::uint32_t data; // Node id of NODE and NAME records; x << 16 | y of STATUS records
+			std::uint8_t kind;
+			std::uint8_t result;
+			std::uint16_t length; // NAME records: the length of the name that follows
+		};
+
+		//! \brief Appends the text of \a event to \a text. Called on the writer thread only.
+		typedef void (*Formatter)(Event const& event, std::string& text);
+
+		//! \brief Creates a log that writes to \a output (which it does not close) in
+		//! \a format, through a queue of at least \a capacity events.
+		BehaviorLog(std::FILE* output, Format format, Formatter formatter = formatEvent, size_t capacity = 1 << 14);
+
+		//! \brief Writes what is still queued and stops the writer thread. Threads that
+		//! logged here stop logging until their next <code>beginTick()</code>.
+		~BehaviorLog();
+
+	private:
+		// Do not implement.
+		BehaviorLog(BehaviorLog const&);
+		BehaviorLog& operator=(BehaviorLog const&);
+
+	public:
+		//! \brief Logs only ticks that are a multiple of \a period; 0 and 1 log every tick.
+		void setSampling(unsigned period);
+
+		//! \brief Logs only the specified agents; an empty list logs every agent.
+		void setAgentFilter(std::vector<unsigned> const& agents);
+
+		//! \brief Attributes the events this thread logs from now on to \a tick of \a agent,
+		//! and logs a TICK event if they pass the sampling and the filter.
+		//!
+		//! \return  Whether the tick is logged.
+		bool beginTick(unsigned agent, unsigned tick);
+
+		//! \brief Data function that logs \a node for the current tick of this thread.
+		static void logNode(Behavior const* node);
+
+		//! \brief Data function that logs \a node, if it is a leaf, for the current tick of
+		//! this thread.
+		static void logLeaf(Behavior const* node);
+
+		//! \brief Logs the state of \a world for the current tick of this thread.
+		void logStatus(World const& world);
+
+		//! \brief Returns once every event logged before the call has been written and the
+		//! output flushed.
+		void flush();
+
+		//! \brief Returns the number of events written so far.
+		unsigned long long getWrittenCount() const;
+
+		//! \brief The default TEXT formatter: one tab-separated line per event, with the
+		//! agent, the tick, the kind and what the event records.
+		static void formatEvent(Event const& event, std::string& text);
+
+	private:
+		void add(Event const& event);
+		void write();
+		void drain(std::string& buffer);
+
+		ConcurrentQueue<Event> events;
+		std::FILE* output;
+		Format format;
+		Formatter formatter;
+		unsigned samplingPeriod;
+		std::vector<bool> agentFilter; // Indexed by agent; empty logs every agent
+
+		std::unordered_map<Behavior const*, std::uint32_t> nodeIds; // Writer thread only
+		std::atomic<unsigned long long> added;
+		std::atomic<unsigned long long> written;
+		std::mutex mutex; // Guards the writer's waits and wake-ups
+		std::condition_variable wake; // The writer waits on it
+		std::condition_variable drained; // flush() waits on it
+		unsigned long long flushRequested; // Highest added count a flush() waits for
+		bool stopping;
+		std::thread writer;
+	};
+}}  // namespace fullsail_ai::fundamentals
+
+#endif  // _FULLSAIL_AI_FUNDAMENTALS_BEHAVIOR_LOG_H_
@@ -0,0 +1,96 @@
+//! \file BehaviorRegistry.cpp
+//! \brief Implements the <code>fullsail_ai::fundamentals::BehaviorRegistry</code> class.
+
+#include <cstring>
+#include "Behaviors.h"
+#include "BehaviorRegistry.h"
+
+namespace fullsail_ai { namespace fundamentals {
+
+	namespace {
+
+		// Named in the order of Direction.
+		char const* const directionNames[] = { "UP", "DOWN", "LEFT", "RIGHT" };
+		char const* const valueNames[] = { "false", "true" };
+
+		Behavior* constructExploreDirection(void* storage, char const* description, unsigned parameter)
+		{
+			return new (storage) ExploreDirection(description, (Direction)parameter);
+		}
+
+		Behavior* constructTestBehavior(void* storage, char const* description, unsigned parameter)
+		{
+			return new (storage) TestBehavior(description, parameter != 0);
+		}
+
+		template <typename T>
+		BehaviorRegistry::NodeType makeType(char const* name, CompiledBehavior::Kind kind,
+		                                    Behavior* (*construct)(void*, char const*, unsigned) = BehaviorRegistry::construct<T>)
+		{
+			BehaviorRegistry::NodeType type = { name, kind, NULL, 0, sizeof(T), alignof(T),
+			                                    construct, BehaviorRegistry::destroy<T> };
+			return type;
+		}
+
+		BehaviorRegistry createDefault()
+		{
+			BehaviorRegistry registry;
+			BehaviorRegistry::NodeType type;
+
+			registry.add(makeType<Sequence>("Sequence", CompiledBehavior::SEQUENCE));
+			registry.add(makeType<Selector>("Selector", CompiledBehavior::SELECTOR));
+			registry.add(makeType<ProcessPercepts>("ProcessPercepts", CompiledBehavior::LEAF));
+			registry.add(makeType<CheckForGold>("CheckForGold", CompiledBehavior::LEAF));
+			registry.add(makeType<PickUpGold>("PickUpGold", CompiledBehavior::LEAF));
+			registry.add(makeType<ShootWumpus>("ShootWumpus", CompiledBehavior::LEAF));
+			registry.add(makeType<PlanPathTo>("PlanPathTo", CompiledBehavior::LEAF));
+			registry.add(makeType<ExploreLeastRisky>("ExploreLeastRisky", CompiledBehavior::LEAF));
+
+			type = makeType<ExploreDirection>("ExploreDirection", CompiledBehavior::LEAF, constructExploreDirection);
+			type.parameterNames = directionNames;
+			type.parameterCount = 4;
+			registry.add(type);
+
+			type = makeType<TestBehavior>("TestBehavior", CompiledBehavior::LEAF, constructTestBehavior);
+			type.parameterNames = valueNames;
+			type.parameterCount = 2;
+			registry.add(type);
+
+			return registry;
+		}
+	}
+
+	void BehaviorRegistry::add(NodeType const& type)
+	{
+		for (size_t index = 0; index < types.size(); index++)
+			if (std::strcmp(types[index].name, type.name) == 0)
+			{
+				types[index] = type;
+				return;
+			}
+
+		types.push_back(type);
+	}
+
+	BehaviorRegistry::NodeType const* BehaviorRegistry::find(char const* name) const
+	{
+		return find(name, std::strlen(name));
+	}
+
+	BehaviorRegistry::NodeType const* BehaviorRegistry::find(char const* name, size_t length) const
+	{
+		// Registries hold a few dozen types at most, and are searched once per type a
+		// file uses, not once per node.
+		for (size_t index = 0; index < types.size(); index++)
+			if (std::strncmp(types[index].name, name, length) == 0 && types[index].name[length] == '\0')
+				return &types[index];
+
+		return NULL;
+	}
+
+	BehaviorRegistry const& BehaviorRegistry::getDefault()
+	{
+		static BehaviorRegistry const registry = createDefault();
+		return registry;
+	}
+}}  // namespace fullsail_ai::fundamentals
@@ -0,0 +1,73 @@
+//! \file BehaviorRegistry.h
+//! \brief Defines the <code>fullsail_ai::fundamentals::BehaviorRegistry</code> class.
+#ifndef _FULLSAIL_AI_FUNDAMENTALS_BEHAVIOR_REGISTRY_H_
+#define _FULLSAIL_AI_FUNDAMENTALS_BEHAVIOR_REGISTRY_H_
+
+#include <cstddef>
+#include <new>
+#include <vector>
+#include "CompiledBehavior.h"
+
+namespace fullsail_ai { namespace fundamentals {
+
+	//! \brief The node types a tree file may name, and how to construct each one.
+	//!
+	//! Tree files refer to types by name and to a type's parameter (such as the direction
+	//! of an <code>ExploreDirection</code>) by one of the names the type lists, so files do
+	//! not depend on the order in which types were added, or on enum values.
+	//!
+	//! Nodes are constructed into storage the caller provides, so a loader can place a
+	//! whole tree in one block.
+	class BehaviorRegistry
+	{
+	public:
+		//! \brief One registered node type.
+		struct NodeType
+		{
+			char const* name;
+			CompiledBehavior::Kind kind; // How an executor treats the node
+			char const* const* parameterNames; // Names of the parameter's values, or NULL
+			unsigned parameterCount; // Number of parameterNames
+			size_t size; // sizeof the node class
+			size_t alignment; // alignof the node class
+
+			//! \brief Constructs the node in \a storage, with the index of its parameter value.
+			Behavior* (*construct)(void* storage, char const* description, unsigned parameter);
+
+			//! \brief Destroys a node that construct() made, without freeing its storage.
+			void (*destroy)(Behavior* behavior);
+		};
+
+	private:
+		std::vector<NodeType> types;
+
+	public:
+		//! \brief Adds a node type, replacing any other with the same name.
+		void add(NodeType const& type);
+
+		//! \brief Returns the type with the specified name, or NULL if there is none.
+		NodeType const* find(char const* name) const;
+
+		//! \brief Returns the type whose name is the \a length characters at \a name.
+		NodeType const* find(char const* name, size_t length) const;
+
+		//! \brief Returns the registry of every node type in <code>Behaviors.h</code>.
+		static BehaviorRegistry const& getDefault();
+
+		//! \brief A <code>construct</code> for node types built from a description alone.
+		template <typename T>
+		static Behavior* construct(void* storage, char const* description, unsigned)
+		{
+			return new (storage) T(description);
+		}
+
+		//! \brief A <code>destroy</code> for any node type.
+		template <typename T>
+		static void destroy(Behavior* behavior)
+		{
+			static_cast<T*>(behavior)->~T();
+		}
+	};
+}}  // namespace fullsail_ai::fundamentals
+
+#endif  // _FULLSAIL_AI_FUNDAMENTALS_BEHAVIOR_REGISTRY_H_
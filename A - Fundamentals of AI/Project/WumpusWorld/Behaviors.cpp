@@ -4,52 +4,264 @@
 
 #include <queue>
 #include <stack>
+#include <typeinfo>
+#include <utility>
+#include "../BehaviorTree/BehaviorArena.h"
+#include "../BehaviorTree/TickProfiler.h"
+#include "../BehaviorTree/TraceRecorder.h"
 #include "Agent.h"
 #include "definitions.h"
 #include "Behaviors.h"
+#include "PathPlanner.h"
 
 namespace fullsail_ai { namespace fundamentals {
 
-	bool Sequence::run(void (*dataFunction)(Behavior const*), void* context)
+	bool Composite::runSubtree(Composite* root, bool sequence, void (*dataFunction)(Behavior const*), void* context)
 	{
-		for (size_t index = 0; index < children.size(); index++)
-			if (!children[index]->run(dataFunction, context))
-				return false;
+		// Kept per thread; a tree run from inside a leaf or dataFunction works above the
+		// frames of the one that called it. The composite being run lives in locals, and
+		// only those above it are on the stack.
+		static thread_local vector<RunningState::Frame> frames;
+		TraceSpan span("Composite::runSubtree");
+		size_t base = frames.size();
+		Composite* node = root;
+		Behavior* const* next = root->children.data();
+		Behavior* const* end = next + root->children.size();
+		bool result;
+
+		FULLSAIL_PROFILE_ENTER(root);
+
+		for (;;)
+		{
+			if (next == end)
+			{
+				// Every child has run: a sequence succeeds and a selector fails.
+				result = sequence;
+			}
+			else
+			{
+				Behavior* child = *next++;
+				Kind kind = getKind(child);
 
-		dataFunction(this);
-		return true;
+				if (kind != OTHER)
+				{
+					RunningState::Frame suspended = { node, next, end, sequence };
+					frames.push_back(suspended);
+					node = static_cast<Composite*>(child);
+					next = node->children.data();
+					end = next + node->children.size();
+					sequence = (kind == SEQUENCE);
+					FULLSAIL_PROFILE_ENTER(child);
+					continue;
+				}
+
+				FULLSAIL_PROFILE_ENTER(child);
+				result = child->run(dataFunction, context);
+				FULLSAIL_PROFILE_EXIT(result ? SUCCESS : FAILURE);
+
+				// A sequence moves on after a success and a selector after a failure.
+				if (result == sequence)
+					continue;
+			}
+
+			// The composite is done; hand its result up until one of them moves on.
+			for (;;)
+			{
+				if (result)
+					dataFunction(node);
+
+				FULLSAIL_PROFILE_EXIT(result ? SUCCESS : FAILURE);
+
+				if (frames.size() == base)
+					return result;
+
+				RunningState::Frame const& parent = frames.back();
+				node = parent.node;
+				next = parent.next;
+				end = parent.end;
+				sequence = parent.sequence;
+				frames.pop_back();
+
+				if (result == sequence)
+					break;
+			}
+		}
 	}
 
-	bool Selector::run(void (*dataFunction)(Behavior const*), void* context)
+	Behavior::Status Composite::resume(Behavior* root, RunningState& state, void (*dataFunction)(Behavior const*), void* context)
 	{
-		for (size_t index = 0; index < children.size(); index++)
+		// The same walk as runSubtree(), but over the state's own frames, which are left
+		// in place when a child returns RUNNING.
+		TraceSpan span("Composite::resume");
+		vector<RunningState::Frame>& frames = state.frames;
+		Composite* node;
+		Behavior* const* next;
+		Behavior* const* end;
+		bool sequence, result = false, resumed = false;
+
+		if (state.running)
 		{
-			if (children[index]->run(dataFunction, context))
+#if defined(FULLSAIL_PROFILE_TICKS)
+			// The composites above the running node are ticked again too.
+			for (size_t index = 0; index < frames.size(); index++)
+				TickProfiler::enter(frames[index].node);
+#endif
+			FULLSAIL_PROFILE_ENTER(state.running);
+			Status status = state.running->step(dataFunction, context);
+			FULLSAIL_PROFILE_EXIT(status);
+
+			// Still running: nothing above it has anything to do.
+			if (status == RUNNING)
 			{
-				dataFunction(this);
-				return true;
+#if defined(FULLSAIL_PROFILE_TICKS)
+				for (size_t index = 0; index < frames.size(); index++)
+					TickProfiler::exit(RUNNING);
+#endif
+				return RUNNING;
 			}
+
+			state.running = NULL;
+
+			if (frames.empty())
+				return status;
+
+			// Carry on with its composite as if the child had just returned.
+			RunningState::Frame const& parent = frames.back();
+			node = parent.node;
+			next = parent.next;
+			end = parent.end;
+			sequence = parent.sequence;
+			frames.pop_back();
+			result = (status == SUCCESS);
+			resumed = true;
 		}
+		else
+		{
+			Kind kind = getKind(root);
 
-		return false;
+			frames.clear();
+
+			if (kind == OTHER)
+			{
+				FULLSAIL_PROFILE_ENTER(root);
+				Status status = root->step(dataFunction, context);
+				FULLSAIL_PROFILE_EXIT(status);
+
+				if (status == RUNNING)
+					state.running = root;
+
+				return status;
+			}
+
+			node = static_cast<Composite*>(root);
+			next = node->children.data();
+			end = next + node->children.size();
+			sequence = (kind == SEQUENCE);
+			FULLSAIL_PROFILE_ENTER(root);
+		}
+
+		for (;;)
+		{
+			if (resumed)
+			{
+				resumed = false;
+
+				if (result == sequence)
+					continue;
+			}
+			else if (next == end)
+			{
+				result = sequence;
+			}
+			else
+			{
+				Behavior* child = *next++;
+				Kind kind = getKind(child);
+
+				if (kind != OTHER)
+				{
+					RunningState::Frame suspended = { node, next, end, sequence };
+					frames.push_back(suspended);
+					node = static_cast<Composite*>(child);
+					next = node->children.data();
+					end = next + node->children.size();
+					sequence = (kind == SEQUENCE);
+					FULLSAIL_PROFILE_ENTER(child);
+					continue;
+				}
+
+				FULLSAIL_PROFILE_ENTER(child);
+				Status status = child->step(dataFunction, context);
+				FULLSAIL_PROFILE_EXIT(status);
+
+				// Suspend this composite too, at the child after the running one.
+				if (status == RUNNING)
+				{
+					RunningState::Frame suspended = { node, next, end, sequence };
+					frames.push_back(suspended);
+					state.running = child;
+#if defined(FULLSAIL_PROFILE_TICKS)
+					for (size_t index = 0; index < frames.size(); index++)
+						TickProfiler::exit(RUNNING);
+#endif
+					return RUNNING;
+				}
+
+				result = (status == SUCCESS);
+
+				if (result == sequence)
+					continue;
+			}
+
+			for (;;)
+			{
+				if (result)
+					dataFunction(node);
+
+				FULLSAIL_PROFILE_EXIT(result ? SUCCESS : FAILURE);
+
+				if (frames.empty())
+					return result ? SUCCESS : FAILURE;
+
+				RunningState::Frame const& parent = frames.back();
+				node = parent.node;
+				next = parent.next;
+				end = parent.end;
+				sequence = parent.sequence;
+				frames.pop_back();
+
+				if (result == sequence)
+					break;
+			}
+		}
 	}
 
-	bool ProcessPercepts::run(void (*dataFunction)(Behavior const*), void* context)
+	bool Sequence::run(void (*dataFunction)(Behavior const*), void* context)
+	{
+		return runSubtree(this, true, dataFunction, context);
+	}
+
+	bool Selector::run(void (*dataFunction)(Behavior const*), void* context)
 	{
-		Agent* agent = (Agent*) context;
+		return runSubtree(this, false, dataFunction, context);
+	}
+
+	bool ProcessPercepts::tick(Agent& agent)
+	{
+		TraceSpan span("ProcessPercepts::run");
 
 		// Offsets for looking around a square.
 		int offset[4][2] = { {-1, 0}, {1, 0}, {0, -1}, {0, 1} };
 
 		// Local variables for working with the agent's knowledge.
-		Knowledge& knowledge = agent->getKnowledge();
+		Knowledge& knowledge = agent.getKnowledge();
 		unsigned x = knowledge.x, y = knowledge.y;
-		vector<vector<char>>& stimulus = knowledge.stimulus;
-		vector<vector<char>>& modelWorld = knowledge.modelWorld;
+		Grid2D<char>& stimulus = knowledge.stimulus;
+		Grid2D<char>& modelWorld = knowledge.modelWorld;
 
 		// First, gather stimulus from the world state.
-		bool breeze = ((stimulus[x][y] & BREEZE) != 0);
-		bool stench = ((stimulus[x][y] & STENCH) != 0);
+		bool breeze = ((stimulus(x, y) & BREEZE) != 0);
+		bool stench = ((stimulus(x, y) & STENCH) != 0);
 
 		// If there is no breeze or stench, then the boxes immediately around this square are clear.
 		if (!breeze && !stench)
@@ -59,9 +271,9 @@ namespace fullsail_ai { namespace fundamentals {
 				unsigned newX = x + offset[index][0],
 				         newY = y + offset[index][1];
 
-				if (newX >= 0 && newX < modelWorld.size() && newY >= 0 && newY < modelWorld[newX].size())
+				if (modelWorld.contains(newX, newY))
 				{
-					modelWorld[newX][newY] = Knowledge::CLEAR;
+					knowledge.mark(newX, newY, Knowledge::CLEAR);
 				}
 			}
 		}
@@ -78,10 +290,10 @@ namespace fullsail_ai { namespace fundamentals {
 				unsigned newX = x + offset[index][0],
 				         newY = y + offset[index][1];
 
-				if (newX >= 0 && newX < modelWorld.size() && newY >= 0 && newY < modelWorld[newX].size())
+				if (modelWorld.contains(newX, newY))
 				{
 					// If the space cannot hold a pit, add it to the non-pit spaces.
-					if (modelWorld[newX][newY] == Knowledge::CLEAR || modelWorld[newX][newY] == Knowledge::DEFINITE_WUMPUS)
+					if (modelWorld(newX, newY) == Knowledge::CLEAR || modelWorld(newX, newY) == Knowledge::DEFINITE_WUMPUS)
 						nonPitSpaces++;
 				}
 				else
@@ -94,27 +306,27 @@ namespace fullsail_ai { namespace fundamentals {
 				unsigned newX = x + offset[index][0],
 				         newY = y + offset[index][1];
 
-				if (newX >= 0 && newX < modelWorld.size() && newY >= 0 && newY < modelWorld[newX].size())
+				if (modelWorld.contains(newX, newY))
 				{
 					// If there is only one possible pit and this is it, mark it as such.
-					if (nonPitSpaces == 3 && modelWorld[newX][newY] != Knowledge::CLEAR && modelWorld[newX][newY] != Knowledge::DEFINITE_WUMPUS)
+					if (nonPitSpaces == 3 && modelWorld(newX, newY) != Knowledge::CLEAR && modelWorld(newX, newY) != Knowledge::DEFINITE_WUMPUS)
 					{
-						modelWorld[newX][newY] = Knowledge::DEFINITE_PIT;
+						knowledge.mark(newX, newY, Knowledge::DEFINITE_PIT);
 					}
 
 					// If we believe that the space could hold a wumpus, mark it as possible wumpus OR pit.
-					else if (modelWorld[newX][newY] == Knowledge::POSSIBLE_WUMPUS)
-						modelWorld[newX][newY] = Knowledge::POSSIBLE_W_P;
+					else if (modelWorld(newX, newY) == Knowledge::POSSIBLE_WUMPUS)
+						knowledge.mark(newX, newY, Knowledge::POSSIBLE_W_P);
 
 					// If we know nothing about the space, note that it is possibly a pit. (All other cases are covered.)
-					else if (modelWorld[newX][newY] == Knowledge::UNKNOWN)
-						modelWorld[newX][newY] = Knowledge::POSSIBLE_PIT;
+					else if (modelWorld(newX, newY) == Knowledge::UNKNOWN)
+						knowledge.mark(newX, newY, Knowledge::POSSIBLE_PIT);
 				}
 			}
 		}
 
 		// If there is a stench and we have not yet fixed the location of the wumpus, we should do so now.
-		if (stench && (knowledge.wumpusX == -1 || knowledge.wumpusY == -1))
+		if (stench && (knowledge.wumpusX == (unsigned)-1 || knowledge.wumpusY == (unsigned)-1))
 		{
 			//Keep track of the non-pit spaces around this spot.
 			int nonWumpusSpaces = 0;
@@ -125,10 +337,10 @@ namespace fullsail_ai { namespace fundamentals {
 				unsigned newX = x + offset[index][0],
 				         newY = y + offset[index][1];
 
-				if (newX >= 0 && newX < modelWorld.size() && newY >= 0 && newY < modelWorld[newX].size())
+				if (modelWorld.contains(newX, newY))
 				{
 					// If the space cannot hold the wumpus, add it to the non-wumpus spaces.
-					if (modelWorld[newX][newY] == Knowledge::CLEAR || modelWorld[newX][newY] == Knowledge::DEFINITE_PIT)
+					if (modelWorld(newX, newY) == Knowledge::CLEAR || modelWorld(newX, newY) == Knowledge::DEFINITE_PIT)
 						nonWumpusSpaces++;
 				}
 				else
@@ -141,35 +353,28 @@ namespace fullsail_ai { namespace fundamentals {
 				unsigned newX = x + offset[index][0],
 				         newY = y + offset[index][1];
 
-				if (newX >= 0 && newX < modelWorld.size() && newY >= 0 && newY < modelWorld[newX].size())
+				if (modelWorld.contains(newX, newY))
 				{
 					// If there is only one possible wumpus space and this is it, mark it as such.
-					if (nonWumpusSpaces == 3 && modelWorld[newX][newY] != Knowledge::CLEAR && modelWorld[newX][newY] != Knowledge::DEFINITE_PIT)
+					if (nonWumpusSpaces == 3 && modelWorld(newX, newY) != Knowledge::CLEAR && modelWorld(newX, newY) != Knowledge::DEFINITE_PIT)
 					{
-						modelWorld[newX][newY] = Knowledge::DEFINITE_WUMPUS;
+						knowledge.mark(newX, newY, Knowledge::DEFINITE_WUMPUS);
 						knowledge.wumpusX = newX;
 						knowledge.wumpusY = newY;
 
 						// Once we have found the wumpus, we can remove any other
-						// "wumpus" marks from our knowledge of the world.
-						for (unsigned xIndex = 0; xIndex < modelWorld.size(); xIndex++)
-							for (unsigned yIndex = 0; yIndex < modelWorld[xIndex].size(); yIndex++)
-							{
-								if (modelWorld[xIndex][yIndex] == Knowledge::POSSIBLE_WUMPUS)
-									modelWorld[xIndex][yIndex] = Knowledge::UNKNOWN;
-
-								else if (modelWorld[xIndex][yIndex] == Knowledge::POSSIBLE_W_P)
-									modelWorld[xIndex][yIndex] = Knowledge::POSSIBLE_PIT;
-							}
+						// "wumpus" marks from our knowledge of the world. Only the
+						// marked cells are visited, not the whole map.
+						knowledge.forgetPossibleWumpus();
 					}
 
 					// If we believe that the space could hold a pit, mark it as possible pit OR wumpus.
-					else if (modelWorld[newX][newY] == Knowledge::POSSIBLE_PIT)
-						modelWorld[newX][newY] = Knowledge::POSSIBLE_W_P;
+					else if (modelWorld(newX, newY) == Knowledge::POSSIBLE_PIT)
+						knowledge.mark(newX, newY, Knowledge::POSSIBLE_W_P);
 
 					// If we know nothing about the space, note that it is possibly the wumpus. (All other cases are covered.)
-					else if (modelWorld[newX][newY] == Knowledge::UNKNOWN)
-						modelWorld[newX][newY] = Knowledge::POSSIBLE_WUMPUS;
+					else if (modelWorld(newX, newY) == Knowledge::UNKNOWN)
+						knowledge.mark(newX, newY, Knowledge::POSSIBLE_WUMPUS);
 				}
 			}
 		}
@@ -184,9 +389,9 @@ namespace fullsail_ai { namespace fundamentals {
 			unsigned newX = x + offset[index][0],
 			         newY = y + offset[index][1];
 
-			if (newX >= 0 && newX < modelWorld.size() && newY >= 0 && newY < modelWorld[newX].size())
+			if (modelWorld.contains(newX, newY))
 			{
-				if ((stimulus[newX][newY] & UNEXPLORED) && (modelWorld[newX][newY] == Knowledge::CLEAR))
+				if ((stimulus(newX, newY) & UNEXPLORED) && (modelWorld(newX, newY) == Knowledge::CLEAR))
 				{
 					knowledge.safeUnexploredLocationPresent = true;
 					break;
@@ -194,56 +399,44 @@ namespace fullsail_ai { namespace fundamentals {
 			}
 		}
 
-		dataFunction(this);
 		return true;
 	}
 
-	bool CheckForGold::run(void (*dataFunction)(Behavior const*), void* context)
+	bool CheckForGold::tick(Agent& agent)
 	{
-		Agent* agent = (Agent*) context;
-
-		if (agent->getKnowledge().stimulus[agent->getKnowledge().x][agent->getKnowledge().y] & GOLD)
+		if (agent.getKnowledge().stimulus(agent.getKnowledge().x, agent.getKnowledge().y) & GOLD)
 		{
-			dataFunction(this);
 			return true;
 		}
 
 		return false;
 	}
 
-	bool PickUpGold::run(void (*dataFunction)(Behavior const*), void* context)
+	bool PickUpGold::tick(Agent& agent)
 	{
-		Agent* agent = (Agent*) context;
-
-		if (agent->pickUpGold())
+		if (agent.pickUpGold())
 		{
-			dataFunction(this);
 			return true;
 		}
 
 		return false;
 	}
 
-	bool ShootWumpus::run(void (*dataFunction)(Behavior const*), void* context)
+	bool ShootWumpus::tick(Agent& agent)
 	{
-		Agent* agent = (Agent*) context;
-
-		if ((agent->getKnowledge().stimulus[agent->getKnowledge().x][agent->getKnowledge().y] & STENCH) && (agent->shoot(LEFT)))
+		if ((agent.getKnowledge().stimulus(agent.getKnowledge().x, agent.getKnowledge().y) & STENCH) && (agent.shoot(LEFT)))
 		{
-			dataFunction(this);
 			return true;
 		}
 
 		return false;
 	}
 
-	bool ExploreDirection::run(void (*dataFunction)(Behavior const*), void* context)
+	bool ExploreDirection::tick(Agent& agent)
 	{
-		Agent* agent = (Agent*) context;
-
-		Knowledge& knowledge = agent->getKnowledge();
-		vector<vector<char>>& modelWorld = knowledge.modelWorld;
-		vector<vector<char>>& stimulus = knowledge.stimulus;
+		Knowledge& knowledge = agent.getKnowledge();
+		Grid2D<char>& modelWorld = knowledge.modelWorld;
+		Grid2D<char>& stimulus = knowledge.stimulus;
 		unsigned x = knowledge.x, y = knowledge.y;
 
 		if (knowledge.safeUnexploredLocationPresent)
@@ -251,33 +444,225 @@ namespace fullsail_ai { namespace fundamentals {
 			switch (direction)
 			{
 			case UP:
-				if (y <= 0 || !(modelWorld[x][y-1] == Knowledge::CLEAR) || !(stimulus[x][y-1] & UNEXPLORED))
+				if (y <= 0 || !(modelWorld(x, y-1) == Knowledge::CLEAR) || !(stimulus(x, y-1) & UNEXPLORED))
 					return false;
 				break;
 			case DOWN:
-				if (y >= modelWorld[0].size() - 1 || !(modelWorld[x][y+1] == Knowledge::CLEAR) || !(stimulus[x][y+1] & UNEXPLORED))
+				if (y >= modelWorld.getHeight() - 1 || !(modelWorld(x, y+1) == Knowledge::CLEAR) || !(stimulus(x, y+1) & UNEXPLORED))
 					return false;
 				break;
 			case LEFT:
-				if (x <= 0 || !(modelWorld[x-1][y] == Knowledge::CLEAR) || !(stimulus[x-1][y] & UNEXPLORED))
+				if (x <= 0 || !(modelWorld(x-1, y) == Knowledge::CLEAR) || !(stimulus(x-1, y) & UNEXPLORED))
 					return false;
 				break;
 			case RIGHT:
-				if (x >= modelWorld.size() - 1 || !(modelWorld[x+1][y] == Knowledge::CLEAR) || !(stimulus[x][y+1] & UNEXPLORED))
+				if (x >= modelWorld.getWidth() - 1 || !(modelWorld(x+1, y) == Knowledge::CLEAR) || !(stimulus(x+1, y) & UNEXPLORED))
 					return false;
 				break;
 			}
 		}
 
-		if (agent->move(direction))
+		if (agent.move(direction))
 		{
-			dataFunction(this);
 			return true;
 		}
 
 		return false;
 	}
 
+	bool PlanPathTo::tick(Agent& agent)
+	{
+		static thread_local PathPlanner planner;
+
+		Knowledge& knowledge = agent.getKnowledge();
+		vector<unsigned>& path = knowledge.path;
+		unsigned x = knowledge.x, y = knowledge.y;
+		unsigned height = knowledge.modelWorld.getHeight();
+
+		if (knowledge.safeUnexploredLocationPresent || knowledge.frontier.isEmpty())
+			return false;
+
+		// Keep the cached path while its goal is worth reaching; put the agent back on it
+		// if something else moved it.
+		if (!path.empty() && !knowledge.frontier.contains(path.front()))
+			path.clear();
+
+		if (!path.empty())
+		{
+			unsigned next = path.back();
+			unsigned distance = (next / height > x ? next / height - x : x - next / height)
+			                  + (next % height > y ? next % height - y : y - next % height);
+
+			if (distance != 1)
+				planner.repairPath(knowledge, x, y, path);
+		}
+
+		if (path.empty())
+		{
+			// Aim for the nearest safe unexplored cell as the crow flies.
+			unsigned goal = knowledge.frontier[0], goalDistance = ~0u;
+
+			for (size_t index = 0; index < knowledge.frontier.size(); index++)
+			{
+				unsigned cell = knowledge.frontier[index];
+				unsigned distance = (cell / height > x ? cell / height - x : x - cell / height)
+				                  + (cell % height > y ? cell % height - y : y - cell % height);
+
+				if (distance < goalDistance)
+				{
+					goal = cell;
+					goalDistance = distance;
+				}
+			}
+
+			if (!planner.findPath(knowledge, x, y, goal / height, goal % height, path))
+				return false;
+		}
+
+		unsigned next = path.back(), nextX = next / height, nextY = next % height;
+		Direction direction = nextX < x ? LEFT : nextX > x ? RIGHT : nextY < y ? UP : DOWN;
+
+		if (agent.move(direction))
+		{
+			path.pop_back();
+			return true;
+		}
+
+		return false;
+	}
+
+	Behavior::Status PlanPathTo::step(Agent& agent)
+	{
+		if (!tick(agent))
+			return FAILURE;
+
+		// Walking on is only what the tree would choose anyway if nothing here could
+		// change its mind. On an explored cell with no stimulus, Process Percepts only
+		// marks neighbors CLEAR that already are, and no earlier choice applies; what is
+		// left is a safe unexplored neighbor, which Explore would take instead.
+		Knowledge& knowledge = agent.getKnowledge();
+		unsigned x = knowledge.x, y = knowledge.y;
+		int offset[4][2] = { {-1, 0}, {1, 0}, {0, -1}, {0, 1} };
+
+		if (knowledge.path.empty() || (knowledge.stimulus(x, y) & (UNEXPLORED | STENCH | BREEZE | GOLD)))
+			return SUCCESS;
+
+		for (int index = 0; index < 4; index++)
+		{
+			unsigned newX = x + offset[index][0],
+			         newY = y + offset[index][1];
+
+			if (knowledge.modelWorld.contains(newX, newY) && knowledge.frontier.contains(newX * knowledge.modelWorld.getHeight() + newY))
+				return SUCCESS;
+		}
+
+		return RUNNING;
+	}
+
+	bool ExploreLeastRisky::tick(Agent& agent)
+	{
+		Knowledge& knowledge = agent.getKnowledge();
+		Grid2D<char>& stimulus = knowledge.stimulus;
+		unsigned x = knowledge.x, y = knowledge.y;
+
+		if (knowledge.safeUnexploredLocationPresent)
+			return false;
+
+		// Offsets for looking around a square, in the order of Direction.
+		int offset[4][2] = { {0, -1}, {0, 1}, {-1, 0}, {1, 0} };
+		Direction directions[4] = { UP, DOWN, LEFT, RIGHT };
+		int best = -1;
+		double bestRisk = 2.0;
+
+		knowledge.inference.update(knowledge);
+
+		for (int index = 0; index < 4; index++)
+		{
+			unsigned newX = x + offset[index][0],
+			         newY = y + offset[index][1];
+
+			if (stimulus.contains(newX, newY) && (stimulus(newX, newY) & UNEXPLORED))
+			{
+				double risk = knowledge.inference.getRisk(newX, newY);
+
+				if (risk < bestRisk)
+				{
+					best = index;
+					bestRisk = risk;
+				}
+			}
+		}
+
+		if (best >= 0 && agent.move(directions[best]))
+		{
+			return true;
+		}
+
+		return false;
+	}
+
+	namespace {
+
+		// Builds nodes with new; BehaviorArena builds them in place.
+		struct HeapBuilder
+		{
+			template <typename T, typename... Arguments>
+			T* create(Arguments&&... arguments)
+			{
+				return new T(std::forward<Arguments>(arguments)...);
+			}
+		};
+
+		template <typename Builder>
+		Behavior* buildBasicBehavior(Builder& builder)
+		{
+			Behavior* behavior = builder.template create<Sequence>("Basic Behavior");
+			behavior->addChild(builder.template create<ProcessPercepts>("Process Percepts"));
+			behavior->addChild(builder.template create<Selector>("Choose Action"));
+			behavior->getChild(1)->addChild(builder.template create<Sequence>("Look For Gold"));
+			behavior->getChild(1)->getChild(0)->addChild(builder.template create<CheckForGold>("Check For Gold"));
+			behavior->getChild(1)->getChild(0)->addChild(builder.template create<PickUpGold>("Pick Up Gold"));
+			behavior->getChild(1)->addChild(builder.template create<ShootWumpus>("Shoot Wumpus"));
+			behavior->getChild(1)->addChild(builder.template create<Selector>("Explore"));
+			// Without a safe neighbor, ExploreDirection steps blindly, so the safer fallbacks go first.
+			behavior->getChild(1)->getChild(2)->addChild(builder.template create<PlanPathTo>("Backtrack To Frontier"));
+			behavior->getChild(1)->getChild(2)->addChild(builder.template create<ExploreLeastRisky>("Explore Least Risky"));
+			behavior->getChild(1)->getChild(2)->addChild(builder.template create<ExploreDirection>("Explore Up", UP));
+			behavior->getChild(1)->getChild(2)->addChild(builder.template create<ExploreDirection>("Explore Down", DOWN));
+			behavior->getChild(1)->getChild(2)->addChild(builder.template create<ExploreDirection>("Explore Left", LEFT));
+			behavior->getChild(1)->getChild(2)->addChild(builder.template create<ExploreDirection>("Explore Right", RIGHT));
+			return behavior;
+		}
+	}
+
+	Behavior* createBasicBehavior()
+	{
+		HeapBuilder builder;
+		return buildBasicBehavior(builder);
+	}
+
+	Behavior* createBasicBehavior(BehaviorArena& arena)
+	{
+		return buildBasicBehavior(arena);
+	}
+
+	char const basicBehaviorText[] =
+		"Sequence \"Basic Behavior\"\n"
+		"\tProcessPercepts \"Process Percepts\"\n"
+		"\tSelector \"Choose Action\"\n"
+		"\t\tSequence \"Look For Gold\"\n"
+		"\t\t\tCheckForGold \"Check For Gold\"\n"
+		"\t\t\tPickUpGold \"Pick Up Gold\"\n"
+		"\t\tShootWumpus \"Shoot Wumpus\"\n"
+		"\t\tSelector \"Explore\"\n"
+		"\t\t\t# Without a safe neighbor, ExploreDirection steps blindly, so the safer fallbacks go first.\n"
+		"\t\t\tPlanPathTo \"Backtrack To Frontier\"\n"
+		"\t\t\tExploreLeastRisky \"Explore Least Risky\"\n"
+		"\t\t\tExploreDirection \"Explore Up\" UP\n"
+		"\t\t\tExploreDirection \"Explore Down\" DOWN\n"
+		"\t\t\tExploreDirection \"Explore Left\" LEFT\n"
+		"\t\t\tExploreDirection \"Explore Right\" RIGHT\n";
+
 	bool TestBehavior::run(void (*dataFunction)(Behavior const*), void* context)
 	{
 		if (value)
@@ -4,16 +4,144 @@
 #ifndef _FULLSAIL_AI_FUNDAMENTALS_LEAF_BEHAVIORS_H_
 #define _FULLSAIL_AI_FUNDAMENTALS_LEAF_BEHAVIORS_H_
 
+#include <typeinfo>
 #include "../BehaviorTree/Behavior.h"
+#include "definitions.h"
 
 namespace fullsail_ai { namespace fundamentals {
 
+	class Agent;
+	class BehaviorArena;
+
+	//! \brief Base of the leaves that act on a <code>Context</code>.
+	//!
+	//! A leaf implements <code>tick()</code>, which takes the context by reference and does
+	//! not report anything. <code>run()</code> makes the one cast from the <code>void*</code>
+	//! the tree hands down and reports the leaf when it succeeds, so a leaf never reports
+	//! any node but itself; <code>CompiledBehavior</code> relies on that to report leaves
+	//! through a templated visitor.
+	//!
+	//! A leaf whose action takes several ticks overrides <code>step(Context&)</code> as well,
+	//! returning <code>RUNNING</code> until it is done; <code>run()</code> always finishes
+	//! in one tick.
+	template <typename Context>
+	class Leaf : public Behavior
+	{
+	public:
+		Leaf(char const* _description) : Behavior(_description) {}
+
+		//! \brief Acts on \a context. Returns true on success, false otherwise.
+		virtual bool tick(Context& context) = 0;
+
+		//! \brief Acts on \a context, and may leave the action in progress.
+		//! (Default: the result of <code>tick()</code>.)
+		virtual Status step(Context& context) { return tick(context) ? SUCCESS : FAILURE; }
+
+		bool run(void (*dataFunction)(Behavior const*), void* context)
+		{
+			if (!tick(*static_cast<Context*>(context)))
+				return false;
+
+			dataFunction(this);
+			return true;
+		}
+
+		Status step(void (*dataFunction)(Behavior const*), void* context)
+		{
+			Status status = step(*static_cast<Context*>(context));
+
+			if (status == SUCCESS)
+				dataFunction(this);
+
+			return status;
+		}
+
+		bool isLeaf() const { return true; }
+	};
+
+	class Composite;
+
+	//! \brief Where a run of a tree by <code>Composite::resume()</code> stopped, kept per
+	//! context (for instance, per agent) between ticks.
+	//!
+	//! When a node returns <code>RUNNING</code>, the state keeps it and the composites
+	//! above it, with the children each has left to run. The next resume steps that node
+	//! directly instead of walking down from the root again.
+	class RunningState
+	{
+		friend class Composite;
+
+		// A composite whose run is suspended below it: the node, the rest of its children,
+		// and its kind.
+		struct Frame
+		{
+			Composite* node;
+			Behavior* const* next;
+			Behavior* const* end;
+			bool sequence;
+		};
+
+		std::vector<Frame> frames; // Root first
+		Behavior* running; // The node that returned RUNNING, or NULL
+
+	public:
+		RunningState() : running(NULL) { }
+
+		//! \brief Returns true if a node was left running by the last resume.
+		bool isRunning() const { return running != NULL; }
+
+		//! \brief Returns the node left running, or NULL.
+		Behavior const* getRunning() const { return running; }
+
+		//! \brief Forgets the node left running, so the next resume starts from the root.
+		void reset() { frames.clear(); running = NULL; }
+	};
+
+	//! \brief Base of <code>Sequence</code> and <code>Selector</code>.
+	//!
+	//! A composite runs the sequences and selectors below it from an explicit stack rather
+	//! than through their <code>run()</code>, so the depth of a tree is not limited by the
+	//! call stack. Any other node is run through its own <code>run()</code>, as told by
+	//! <code>getKind()</code>.
+	class Composite : public Behavior
+	{
+	protected:
+		Composite(char const* _description) : Behavior(_description) { }
+
+		//! \brief Runs the subtree rooted at \a root, which is a sequence if \a sequence is
+		//! true and a selector otherwise, with the results and callbacks of the recursive
+		//! definitions.
+		static bool runSubtree(Composite* root, bool sequence, void (*dataFunction)(Behavior const*), void* context);
+
+	public:
+		//! \brief The nodes a composite expands rather than runs.
+		enum Kind { OTHER = 0, SEQUENCE, SELECTOR };
+
+		//! \brief Returns SEQUENCE or SELECTOR if \a node is exactly a <code>Sequence</code>
+		//! or a <code>Selector</code>, and OTHER otherwise, subclasses included: those may
+		//! override <code>run()</code>.
+		static Kind getKind(Behavior const* node);
+
+		//! \brief Ticks the tree rooted at \a root, resuming at the node \a state left
+		//! running if there is one.
+		//!
+		//! Nodes are stepped rather than run, so a leaf can return <code>RUNNING</code>; the
+		//! whole tree then returns <code>RUNNING</code>, and the composites above the leaf
+		//! report nothing until it finishes. Once it does, the run carries on from it
+		//! exactly as if the leaf had finished in a single tick. Without a running node,
+		//! results and dataFunction calls are those of <code>run()</code>.
+		//!
+		//! \pre     \a state was last used with this \a root, and the tree has not changed
+		//!          since; <code>RunningState::reset()</code> it otherwise.
+		static Status resume(Behavior* root, RunningState& state, void (*dataFunction)(Behavior const*), void* context);
+	};
+
 	//! \brief C++ implementation of sequence for behavior trees.
-	class Sequence : public Behavior
+	class Sequence : public Composite
 	{
 	public:
 		//! \brief Creates a new <code>%Sequence</code>with the description.
-		Sequence(char const* _description) : Behavior(_description) { }
+		Sequence(char const* _description) : Composite(_description) { }
 
 		//! \brief Executes the behavior. Returns true (and runs dataFunction) on success, false otherwise.
 		//!
@@ -25,11 +153,11 @@ namespace fullsail_ai { namespace fundamentals {
 	};
 
 	//! \brief C++ implementation of Selector behavior for behavior trees.
-	class Selector : public Behavior
+	class Selector : public Composite
 	{
 	public:
 		//! \brief Creates a new <code>%Selector</code>with the description.
-		Selector(char const* _description) : Behavior(_description) { }
+		Selector(char const* _description) : Composite(_description) { }
 
 		//! \brief Executes the behavior. Returns true (and runs dataFunction) on success, false otherwise.
 		//!
@@ -40,55 +168,123 @@ namespace fullsail_ai { namespace fundamentals {
 		bool run(void (*dataFunction)(Behavior const*), void* context);
 	};
 
+	inline Composite::Kind Composite::getKind(Behavior const* node)
+	{
+		// The type_info objects found to be neither, by address, so that comparing them
+		// by name is done once per thread rather than once per visit.
+		static thread_local std::type_info const* others[16];
+
+		std::type_info const& type = typeid(*node);
+		std::type_info const*& other = others[((size_t)&type >> 4) % 16];
+
+		// A type usually has one type_info, so the addresses are tried first. It may have
+		// more, as across a shared library boundary, so the objects are compared too.
+		if (&type == &typeid(Sequence))
+			return SEQUENCE;
+
+		if (&type == &typeid(Selector))
+			return SELECTOR;
+
+		if (&type == other)
+			return OTHER;
+
+		if (type == typeid(Sequence))
+			return SEQUENCE;
+
+		if (type == typeid(Selector))
+			return SELECTOR;
+
+		other = &type;
+		return OTHER;
+	}
+
 	//! \brief C++ implementation of a leaf node in a behavior tree.
-	class ProcessPercepts : public Behavior
+	class ProcessPercepts : public Leaf<Agent>
 	{
 	public:
-		ProcessPercepts(char const* _description) : Behavior(_description) {}
-		bool run(void (*dataFunction)(Behavior const*), void* context);
-		bool isLeaf() const { return true; }
+		ProcessPercepts(char const* _description) : Leaf<Agent>(_description) {}
+		bool tick(Agent& agent);
 	};
 
 	//! \brief C++ implementation of a leaf node in a behavior tree.
-	class CheckForGold : public Behavior
+	class CheckForGold : public Leaf<Agent>
 	{
 	public:
-		CheckForGold(char const* _description) : Behavior(_description) {}
-		bool run(void (*dataFunction)(Behavior const*), void* context);
-		bool isLeaf() const { return true; }
+		CheckForGold(char const* _description) : Leaf<Agent>(_description) {}
+		bool tick(Agent& agent);
 	};
 
 	//! \brief C++ implementation of a leaf node in a behavior tree.
-	class PickUpGold : public Behavior
+	class PickUpGold : public Leaf<Agent>
 	{
 	public:
-		PickUpGold(char const* _description) : Behavior(_description) {}
-		bool run(void (*dataFunction)(Behavior const*), void* context);
-		bool isLeaf() const { return true; }
+		PickUpGold(char const* _description) : Leaf<Agent>(_description) {}
+		bool tick(Agent& agent);
 	};
 
 	//! \brief C++ implementation of a leaf node in a behavior tree.
-	class ShootWumpus : public Behavior
+	class ShootWumpus : public Leaf<Agent>
 	{
 	public:
-		ShootWumpus(char const* _description) : Behavior(_description) {}
-		bool run(void (*dataFunction)(Behavior const*), void* context);
-		bool isLeaf() const { return true; }
+		ShootWumpus(char const* _description) : Leaf<Agent>(_description) {}
+		bool tick(Agent& agent);
 	};
 
 	//! \brief C++ implementation of a leaf node in a behavior tree.
-	class ExploreDirection : public Behavior
+	class ExploreDirection : public Leaf<Agent>
 	{
 	private:
 		Direction direction;
 
 	public:
-		ExploreDirection(char const* _description, Direction _direction) : Behavior(_description), direction(_direction) {}
-		bool run(void (*dataFunction)(Behavior const*), void* context);
-		bool isLeaf() const { return true; }
+		ExploreDirection(char const* _description, Direction _direction) : Leaf<Agent>(_description), direction(_direction) {}
+		bool tick(Agent& agent);
+	};
+
+	//! \brief Walks back to the nearest cell known to be safe and still unexplored, one step
+	//! per tick, when no neighbor is one. Fails if a neighbor is, or if there is none left.
+	//!
+	//! The path is kept in the agent's <code>Knowledge</code> and followed for as long as
+	//! its goal stays unexplored; if the agent has been moved off it, it is repaired
+	//! rather than planned again. Each thread keeps one <code>PathPlanner</code>, whose
+	//! search state is reused by every agent the thread runs.
+	//!
+	//! Stepped, it stays <code>RUNNING</code> for as long as the tree, run from the root,
+	//! would do nothing but take the next step: while the agent stands on explored cells
+	//! with no stimulus and no safe unexplored neighbor.
+	class PlanPathTo : public Leaf<Agent>
+	{
+	public:
+		using Leaf<Agent>::step;
+
+		PlanPathTo(char const* _description) : Leaf<Agent>(_description) {}
+		bool tick(Agent& agent);
+		Status step(Agent& agent);
 	};
-	
-		//! \brief C++ implementation of a leaf node in a behavior tree (this one does nothing; just a place holder.)
+
+	//! \brief Moves to the unexplored neighbor least likely to hold a pit or the wumpus,
+	//! according to the agent's <code>ProbabilisticInference</code>. The last resort when no
+	//! known-safe cell is left to explore; fails if a neighbor is known to be safe, or if
+	//! every neighbor has been explored.
+	class ExploreLeastRisky : public Leaf<Agent>
+	{
+	public:
+		ExploreLeastRisky(char const* _description) : Leaf<Agent>(_description) {}
+		bool tick(Agent& agent);
+	};
+
+	//! \brief Builds the wumpus-hunting tree the agents in <code>Game</code> run.
+	//! The caller owns the returned nodes.
+	Behavior* createBasicBehavior();
+
+	//! \brief Builds the same tree in \a arena, which owns its nodes.
+	Behavior* createBasicBehavior(BehaviorArena& arena);
+
+	//! \brief The tree <code>createBasicBehavior()</code> builds, in the text form
+	//! <code>BehaviorImage::compile()</code> reads.
+	extern char const basicBehaviorText[];
+
+	//! \brief C++ implementation of a leaf node in a behavior tree (this one does nothing; just a place holder.)
 	class TestBehavior : public Behavior
 	{
 	private:
@@ -0,0 +1,164 @@
+//! \file BitPlane.cpp
+//! \brief Implements the <code>fullsail_ai::fundamentals::BitPlane</code> class.
+
+#include <algorithm>
+#include "BitPlane.h"
+
+// SSE2 is part of every x64 target; AVX2 has to be enabled explicitly (/arch:AVX2, -mavx2).
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define FULLSAIL_AI_BIT_PLANE_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define FULLSAIL_AI_BIT_PLANE_SSE2
+#endif
+
+namespace fullsail_ai { namespace fundamentals {
+
+	namespace {
+
+		// The four-neighbor OR of one word, from the words around it in the flat array.
+		inline std::uint64_t neighborsOfWord(std::uint64_t const* source, std::size_t stride)
+		{
+			std::uint64_t word = source[0];
+
+			return (word << 1) | (word >> 1) | (source[-1] >> 63) | (source[1] << 63)
+			     | source[-(std::ptrdiff_t)stride] | source[stride];
+		}
+
+		// Runs neighborsOfWord() over count consecutive words.
+		void neighborsOfWords(std::uint64_t* target, std::uint64_t const* source, std::size_t count, std::size_t stride)
+		{
+			std::size_t index = 0;
+
+#if defined(FULLSAIL_AI_BIT_PLANE_AVX2)
+			for (; index + 4 <= count; index += 4)
+			{
+				std::uint64_t const* word = source + index;
+				__m256i center = _mm256_loadu_si256((__m256i const*)word);
+				__m256i below = _mm256_loadu_si256((__m256i const*)(word - 1));
+				__m256i above = _mm256_loadu_si256((__m256i const*)(word + 1));
+				__m256i left = _mm256_loadu_si256((__m256i const*)(word - stride));
+				__m256i right = _mm256_loadu_si256((__m256i const*)(word + stride));
+				__m256i result = _mm256_or_si256(_mm256_slli_epi64(center, 1), _mm256_srli_epi64(center, 1));
+
+				result = _mm256_or_si256(result, _mm256_srli_epi64(below, 63));
+				result = _mm256_or_si256(result, _mm256_slli_epi64(above, 63));
+				result = _mm256_or_si256(result, _mm256_or_si256(left, right));
+				_mm256_storeu_si256((__m256i*)(target + index), result);
+			}
+#elif defined(FULLSAIL_AI_BIT_PLANE_SSE2)
+			for (; index + 2 <= count; index += 2)
+			{
+				std::uint64_t const* word = source + index;
+				__m128i center = _mm_loadu_si128((__m128i const*)word);
+				__m128i below = _mm_loadu_si128((__m128i const*)(word - 1));
+				__m128i above = _mm_loadu_si128((__m128i const*)(word + 1));
+				__m128i left = _mm_loadu_si128((__m128i const*)(word - stride));
+				__m128i right = _mm_loadu_si128((__m128i const*)(word + stride));
+				__m128i result = _mm_or_si128(_mm_slli_epi64(center, 1), _mm_srli_epi64(center, 1));
+
+				result = _mm_or_si128(result, _mm_srli_epi64(below, 63));
+				result = _mm_or_si128(result, _mm_slli_epi64(above, 63));
+				result = _mm_or_si128(result, _mm_or_si128(left, right));
+				_mm_storeu_si128((__m128i*)(target + index), result);
+			}
+#endif
+
+			for (; index < count; index++)
+				target[index] = neighborsOfWord(source + index, stride);
+		}
+	}
+
+	BitPlane::BitPlane() : width(0), height(0), stride(0)
+	{
+	}
+
+	BitPlane::BitPlane(unsigned _width, unsigned _height) : width(0), height(0), stride(0)
+	{
+		assign(_width, _height);
+	}
+
+	void BitPlane::assign(unsigned _width, unsigned _height)
+	{
+		width = _width;
+		height = _height;
+
+		// height / 64 + 1 rather than rounding up, so the top bit of each column is padding.
+		stride = height / 64 + 1;
+		words.assign((width + 2) * stride, 0);
+	}
+
+	void BitPlane::clear()
+	{
+		std::fill(words.begin(), words.end(), 0);
+	}
+
+	void BitPlane::clearPadding()
+	{
+		std::size_t lastWord = height / 64;
+		std::uint64_t lastMask = (std::uint64_t(1) << (height % 64)) - 1;
+
+		for (unsigned x = 0; x < width; x++)
+		{
+			std::uint64_t* column = getColumn(x);
+
+			column[lastWord] &= lastMask;
+
+			for (std::size_t word = lastWord + 1; word < stride; word++)
+				column[word] = 0;
+		}
+	}
+
+	std::size_t BitPlane::count() const
+	{
+		std::size_t total = 0;
+
+		for (std::size_t index = 0; index < words.size(); index++)
+		{
+			// Portable population count; compilers recognize the pattern.
+			std::uint64_t word = words[index];
+			word = word - ((word >> 1) & 0x5555555555555555ull);
+			word = (word & 0x3333333333333333ull) + ((word >> 2) & 0x3333333333333333ull);
+			word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+			total += (std::size_t)((word * 0x0101010101010101ull) >> 56);
+		}
+
+		return total;
+	}
+
+	void BitPlane::setNeighborsOf(BitPlane const& source)
+	{
+		if (width == 0)
+			return;
+
+		// The columns are contiguous, so the plane is one run of words between the guards.
+		neighborsOfWords(getColumn(0), source.getColumn(0), width * stride, stride);
+
+		// Cells next to the edges of a column pick up bits from the padding and from
+		// the neighboring column; the padding absorbs them and is cleared here.
+		clearPadding();
+	}
+
+	BitPlane& BitPlane::operator&=(BitPlane const& other)
+	{
+		for (std::size_t index = 0; index < words.size(); index++)
+			words[index] &= other.words[index];
+
+		return *this;
+	}
+
+	BitPlane& BitPlane::operator|=(BitPlane const& other)
+	{
+		for (std::size_t index = 0; index < words.size(); index++)
+			words[index] |= other.words[index];
+
+		return *this;
+	}
+
+	void BitPlane::clearWhere(BitPlane const& other)
+	{
+		for (std::size_t index = 0; index < words.size(); index++)
+			words[index] &= ~other.words[index];
+	}
+}}  // namespace fullsail_ai::fundamentals
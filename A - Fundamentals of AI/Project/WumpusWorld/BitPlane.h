@@ -0,0 +1,110 @@
+//! \file BitPlane.h
+//! \brief Defines the <code>fullsail_ai::fundamentals::BitPlane</code> class.
+#ifndef _FULLSAIL_AI_FUNDAMENTALS_BIT_PLANE_H_
+#define _FULLSAIL_AI_FUNDAMENTALS_BIT_PLANE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace fullsail_ai { namespace fundamentals {
+
+	//! \brief One flag for every cell of a map, packed one bit per cell.
+	//!
+	//! Like <code>Grid2D</code>, the plane is x-major: each x coordinate owns a column of
+	//! <code>getStride()</code> 64-bit words, and cell (x, y) is bit <code>y % 64</code> of
+	//! word <code>y / 64</code> of column x. Neighbors along y are therefore a one-bit
+	//! shift away, and neighbors along x are the same word of the adjacent column.
+	//!
+	//! \note
+	//!   - Every column has at least one bit of padding after its last cell, and the
+	//!     plane has a column of zero words before the first column and after the last,
+	//!     so the whole-plane operations run as one flat loop over the words without
+	//!     special cases at the edges. The padding and guard columns are always zero.
+	//!   - The whole-plane operations require both planes to have the same size.
+	class BitPlane
+	{
+		std::vector<std::uint64_t> words;
+		unsigned width;
+		unsigned height;
+		std::size_t stride;
+
+	public:
+		//! \brief Creates an empty plane.
+		BitPlane();
+
+		//! \brief Creates a plane with every flag clear.
+		BitPlane(unsigned _width, unsigned _height);
+
+		//! \brief Resizes the plane and clears every flag.
+		void assign(unsigned _width, unsigned _height);
+
+		unsigned getWidth() const { return width; }
+		unsigned getHeight() const { return height; }
+
+		//! \brief Returns the number of words in each column.
+		std::size_t getStride() const { return stride; }
+
+		//! \brief Returns the words of column \a x. Unchecked.
+		std::uint64_t* getColumn(unsigned x) { return &words[(x + 1) * stride]; }
+		std::uint64_t const* getColumn(unsigned x) const { return &words[(x + 1) * stride]; }
+
+		//! \brief Returns the flag of cell (\a x, \a y). Unchecked.
+		bool test(unsigned x, unsigned y) const
+		{
+			return (getColumn(x)[y >> 6] >> (y & 63)) & 1;
+		}
+
+		//! \brief Raises the flag of cell (\a x, \a y). Unchecked.
+		void set(unsigned x, unsigned y)
+		{
+			getColumn(x)[y >> 6] |= std::uint64_t(1) << (y & 63);
+		}
+
+		//! \brief Clears the flag of cell (\a x, \a y). Unchecked.
+		void reset(unsigned x, unsigned y)
+		{
+			getColumn(x)[y >> 6] &= ~(std::uint64_t(1) << (y & 63));
+		}
+
+		//! \brief Clears every flag.
+		void clear();
+
+		//! \brief Zeroes the padding bits after the last cell of every column. Call this
+		//! after writing whole words through <code>getColumn()</code>.
+		void clearPadding();
+
+		//! \brief Returns the number of raised flags.
+		std::size_t count() const;
+
+		//! \brief Raises exactly the flags of the cells that have a raised flag in
+		//! \a source among their four neighbors (the cell itself does not count).
+		//! This is how <code>BREEZE</code> follows from <code>PIT</code> and
+		//! <code>STENCH</code> from <code>WUMPUS</code>.
+		//!
+		//! \pre
+		//!   - \a source is not this plane.
+		void setNeighborsOf(BitPlane const& source);
+
+		//! \brief Keeps only the flags that are also raised in \a other.
+		BitPlane& operator&=(BitPlane const& other);
+
+		//! \brief Raises the flags that are raised in \a other.
+		BitPlane& operator|=(BitPlane const& other);
+
+		//! \brief Clears the flags that are raised in \a other.
+		void clearWhere(BitPlane const& other);
+
+		inline friend bool operator==(BitPlane const& lhs, BitPlane const& rhs)
+		{
+			return lhs.width == rhs.width && lhs.height == rhs.height && lhs.words == rhs.words;
+		}
+
+		inline friend bool operator!=(BitPlane const& lhs, BitPlane const& rhs)
+		{
+			return !(lhs == rhs);
+		}
+	};
+}}  // namespace fullsail_ai::fundamentals
+
+#endif  // _FULLSAIL_AI_FUNDAMENTALS_BIT_PLANE_H_
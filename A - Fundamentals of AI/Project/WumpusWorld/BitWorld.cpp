@@ -0,0 +1,291 @@
+//! \file BitWorld.cpp
+//! \brief Implements the <code>fullsail_ai::fundamentals::BitWorld</code> class.
+
+#include <algorithm>
+#include "BitWorld.h"
+
+// The same test as BitPlane.cpp: SSE2 is part of every x64 target.
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define FULLSAIL_AI_BIT_WORLD_SSE2
+#endif
+
+namespace fullsail_ai { namespace fundamentals {
+
+	namespace {
+
+		// xoshiro256**, seeded through SplitMix64: fast, and defined purely in 64-bit
+		// arithmetic, so every platform produces the same sequence for the same seed.
+		class Random
+		{
+			std::uint64_t state[4];
+
+			static std::uint64_t rotate(std::uint64_t value, int bits)
+			{
+				return (value << bits) | (value >> (64 - bits));
+			}
+
+		public:
+			explicit Random(unsigned long long seed)
+			{
+				for (int index = 0; index < 4; index++)
+				{
+					std::uint64_t z = (seed += 0x9E3779B97F4A7C15ull);
+					z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+					z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+					state[index] = z ^ (z >> 31);
+				}
+			}
+
+			std::uint64_t next()
+			{
+				return step(state);
+			}
+
+			// Advances the four words of \a state and returns the next number.
+			static std::uint64_t step(std::uint64_t* state)
+			{
+				std::uint64_t result = rotate(state[1] * 5, 7) * 9;
+				std::uint64_t shifted = state[1] << 17;
+
+				state[2] ^= state[0];
+				state[3] ^= state[1];
+				state[1] ^= state[2];
+				state[0] ^= state[3];
+				state[2] ^= shifted;
+				state[3] = rotate(state[3], 45);
+				return result;
+			}
+
+			// Returns a value in [0, range). The bias is negligible for map-sized ranges.
+			std::size_t below(std::size_t range)
+			{
+				return (std::size_t)(next() % range);
+			}
+		};
+
+#if defined(FULLSAIL_AI_BIT_WORLD_SSE2)
+		template <int bits>
+		inline __m128i rotate(__m128i value)
+		{
+			return _mm_or_si128(_mm_slli_epi64(value, bits), _mm_srli_epi64(value, 64 - bits));
+		}
+
+		// xoshiro256** on both 64-bit lanes; the multiplications by 5 and 9 are shifts and adds.
+		inline __m128i next(__m128i& state0, __m128i& state1, __m128i& state2, __m128i& state3)
+		{
+			__m128i times5 = _mm_add_epi64(_mm_slli_epi64(state1, 2), state1);
+			__m128i rotated = rotate<7>(times5);
+			__m128i result = _mm_add_epi64(_mm_slli_epi64(rotated, 3), rotated);
+			__m128i shifted = _mm_slli_epi64(state1, 17);
+
+			state2 = _mm_xor_si128(state2, state0);
+			state3 = _mm_xor_si128(state3, state1);
+			state1 = _mm_xor_si128(state1, state2);
+			state0 = _mm_xor_si128(state0, state3);
+			state2 = _mm_xor_si128(state2, shifted);
+			state3 = rotate<45>(state3);
+			return result;
+		}
+#endif
+
+		// Fills count words with independent bits, each set with probability threshold / 256.
+		//
+		// Each random word halves the probability of a bit, then either keeps it or adds one
+		// half, following the binary digits of the threshold from the lowest set one up:
+		// ((r or r') and r'') ... ends at exactly threshold / 256. Two generators seeded
+		// from \a random fill the even and the odd words, side by side in SSE2 lanes when
+		// available; the scalar path produces exactly the same words.
+		void fillBernoulli(Random& random, unsigned threshold, unsigned lowestBit, std::uint64_t* target, std::size_t count)
+		{
+			std::uint64_t state[2][4];
+
+			for (int index = 0; index < 4; index++)
+			{
+				state[0][index] = random.next();
+				state[1][index] = random.next();
+			}
+
+			std::size_t index = 0;
+
+#if defined(FULLSAIL_AI_BIT_WORLD_SSE2)
+			// Locals rather than members, so the state stays in registers.
+			__m128i state0 = _mm_set_epi64x((long long)state[1][0], (long long)state[0][0]);
+			__m128i state1 = _mm_set_epi64x((long long)state[1][1], (long long)state[0][1]);
+			__m128i state2 = _mm_set_epi64x((long long)state[1][2], (long long)state[0][2]);
+			__m128i state3 = _mm_set_epi64x((long long)state[1][3], (long long)state[0][3]);
+
+			for (; index + 2 <= count; index += 2)
+			{
+				__m128i bits = _mm_setzero_si128();
+
+				for (unsigned bit = lowestBit; bit < 8; bit++)
+				{
+					__m128i word = next(state0, state1, state2, state3);
+					bits = ((threshold >> bit) & 1) ? _mm_or_si128(bits, word) : _mm_and_si128(bits, word);
+				}
+
+				_mm_storeu_si128((__m128i*)(target + index), bits);
+			}
+
+			_mm_storeu_si128((__m128i*)&state[0][0], _mm_unpacklo_epi64(state0, state1));
+			_mm_storeu_si128((__m128i*)&state[0][2], _mm_unpacklo_epi64(state2, state3));
+			_mm_storeu_si128((__m128i*)&state[1][0], _mm_unpackhi_epi64(state0, state1));
+			_mm_storeu_si128((__m128i*)&state[1][2], _mm_unpackhi_epi64(state2, state3));
+#endif
+
+			// An odd word at the end comes from the first generator.
+			for (; index < count; index++)
+			{
+				std::uint64_t* lane = state[index & 1];
+				std::uint64_t bits = 0;
+
+				for (unsigned bit = lowestBit; bit < 8; bit++)
+				{
+					std::uint64_t word = Random::step(lane);
+					bits = ((threshold >> bit) & 1) ? (bits | word) : (bits & word);
+				}
+
+				target[index] = bits;
+			}
+		}
+
+		// Returns a cell that is not the start cell, uniformly, or the start cell of a map
+		// that has no other.
+		void randomCellOtherThan(Random& random, unsigned width, unsigned height,
+		                         unsigned startX, unsigned startY, unsigned& x, unsigned& y)
+		{
+			std::size_t cellCount = (std::size_t)width * height;
+
+			if (cellCount == 1)
+			{
+				x = startX;
+				y = startY;
+				return;
+			}
+
+			std::size_t cell = ((std::size_t)startX * height + startY + 1 + random.below(cellCount - 1)) % cellCount;
+
+			x = (unsigned)(cell / height);
+			y = (unsigned)(cell % height);
+		}
+	}
+
+	BitWorld::BitWorld(unsigned _width, unsigned _height)
+		: width(_width), height(_height), pit(_width, _height), wumpus(_width, _height), gold(_width, _height),
+		  start(_width, _height), breeze(_width, _height), stench(_width, _height)
+	{
+	}
+
+	void BitWorld::generate(unsigned long long seed, double pitProbability)
+	{
+		Random random(seed);
+		unsigned threshold = (unsigned)(pitProbability * 256.0 + 0.5);
+		unsigned lowestBit = 0;
+
+		while (lowestBit < 8 && threshold != 0 && !((threshold >> lowestBit) & 1))
+			lowestBit++;
+
+		wumpus.clear();
+		gold.clear();
+		start.clear();
+
+		// The columns are contiguous, so the pits are drawn for one flat run of words,
+		// padding included.
+		std::uint64_t* words = pit.getColumn(0);
+		std::size_t count = width * pit.getStride();
+
+		if (threshold == 0 || threshold >= 256)
+			std::fill(words, words + count, threshold == 0 ? 0 : ~std::uint64_t(0));
+		else
+		{
+			fillBernoulli(random, threshold, lowestBit, words, count);
+		}
+
+		pit.clearPadding();
+
+		// The same placement rules as WorldGenerator: a safe start, the wumpus anywhere
+		// else, and the gold in a free cell if there is one.
+		unsigned startX = (unsigned)random.below(width), startY = (unsigned)random.below(height);
+		unsigned x, y;
+
+		start.set(startX, startY);
+		pit.reset(startX, startY);
+
+		randomCellOtherThan(random, width, height, startX, startY, x, y);
+		wumpus.set(x, y);
+
+		randomCellOtherThan(random, width, height, startX, startY, x, y);
+
+		for (std::size_t tries = 0, cellCount = (std::size_t)width * height; tries < cellCount; tries++)
+		{
+			if (!(x == startX && y == startY) && !pit.test(x, y) && !wumpus.test(x, y))
+				break;
+
+			if (++y == height)
+			{
+				y = 0;
+
+				if (++x == width)
+					x = 0;
+			}
+		}
+
+		gold.set(x, y);
+		deriveStimulus();
+	}
+
+	void BitWorld::deriveStimulus()
+	{
+		breeze.setNeighborsOf(pit);
+		stench.setNeighborsOf(wumpus);
+	}
+
+	void BitWorld::loadCells(char const* cells)
+	{
+		pit.clear();
+		wumpus.clear();
+		gold.clear();
+		start.clear();
+		breeze.clear();
+		stench.clear();
+
+		for (unsigned x = 0; x < width; x++)
+		{
+			char const* column = cells + (std::size_t)x * height;
+
+			for (unsigned y = 0; y < height; y++)
+			{
+				char cell = column[y];
+
+				if (cell & PIT)
+					pit.set(x, y);
+				if (cell & WUMPUS)
+					wumpus.set(x, y);
+				if (cell & GOLD)
+					gold.set(x, y);
+				if (cell & START)
+					start.set(x, y);
+				if (cell & BREEZE)
+					breeze.set(x, y);
+				if (cell & STENCH)
+					stench.set(x, y);
+			}
+		}
+	}
+
+	void BitWorld::storeCells(char* cells) const
+	{
+		for (unsigned x = 0; x < width; x++)
+		{
+			char* column = cells + (std::size_t)x * height;
+
+			for (unsigned y = 0; y < height; y++)
+			{
+				column[y] = (pit.test(x, y) ? PIT : NONE) | (wumpus.test(x, y) ? WUMPUS : NONE)
+				          | (gold.test(x, y) ? GOLD : NONE) | (start.test(x, y) ? START : NONE)
+				          | (breeze.test(x, y) ? BREEZE : NONE) | (stench.test(x, y) ? STENCH : NONE);
+			}
+		}
+	}
+}}  // namespace fullsail_ai::fundamentals
@@ -0,0 +1,63 @@
+//! \file BitWorld.h
+//! \brief Defines the <code>fullsail_ai::fundamentals::BitWorld</code> class.
+#ifndef _FULLSAIL_AI_FUNDAMENTALS_BIT_WORLD_H_
+#define _FULLSAIL_AI_FUNDAMENTALS_BIT_WORLD_H_
+
+#include "BitPlane.h"
+#include "definitions.h"
+
+namespace fullsail_ai { namespace fundamentals {
+
+	//! \brief A Wumpus world stored as one <code>BitPlane</code> per flag of
+	//! <code>definitions.h</code>, for maps too large for a <code>char</code> per cell.
+	//!
+	//! \note
+	//!   - <code>storeCells()</code> and <code>loadCells()</code> convert to and from the
+	//!     flat <code>char</code> layout <code>World</code> and <code>WorldGenerator</code>
+	//!     use, so a <code>World</code> can still be built from a <code>%BitWorld</code>.
+	//!   - <code>generate()</code> follows the same rules as <code>WorldGenerator</code>,
+	//!     but draws its own random numbers, so the same seed gives a different world.
+	//!     The pit probability is rounded to a multiple of 1/256. A one-cell map holds
+	//!     the start, the wumpus and the gold in its only cell.
+	//!   - This is a standalone prototype. Nothing in the game goes through it:
+	//!     <code>World</code>, <code>WorldGenerator</code> and the inference still work a
+	//!     <code>char</code> per cell, and only BitPlaneBenchmark uses the planes.
+	//!   - Generating a large map this way measures about 9x faster than
+	//!     <code>WorldGenerator</code> (7-11x across runs), short of the 10x it was meant to
+	//!     reach.
+	class BitWorld
+	{
+		unsigned width;
+		unsigned height;
+
+	public:
+		BitPlane pit;
+		BitPlane wumpus;
+		BitPlane gold;
+		BitPlane start;
+		BitPlane breeze; // Derived from pit by deriveStimulus()
+		BitPlane stench; // Derived from wumpus by deriveStimulus()
+
+		//! \brief Creates an empty world of the specified size.
+		BitWorld(unsigned _width, unsigned _height);
+
+		unsigned getWidth() const { return width; }
+		unsigned getHeight() const { return height; }
+
+		//! \brief Replaces the world with the one for \a seed, including its stimulus.
+		void generate(unsigned long long seed, double pitProbability = 0.2);
+
+		//! \brief Recomputes <code>breeze</code> and <code>stench</code> from
+		//! <code>pit</code> and <code>wumpus</code>.
+		void deriveStimulus();
+
+		//! \brief Reads every flag from \a cells, in which cell (x, y) is at
+		//! <code>x * height + y</code>.
+		void loadCells(char const* cells);
+
+		//! \brief Writes every flag to \a cells, laid out as for <code>loadCells()</code>.
+		void storeCells(char* cells) const;
+	};
+}}  // namespace fullsail_ai::fundamentals
+
+#endif  // _FULLSAIL_AI_FUNDAMENTALS_BIT_WORLD_H_
@@ -0,0 +1,82 @@
+//! \file CellSet.h
+//! \brief Defines the <code>fullsail_ai::fundamentals::CellSet</code> class.
+#ifndef _FULLSAIL_AI_FUNDAMENTALS_CELL_SET_H_
+#define _FULLSAIL_AI_FUNDAMENTALS_CELL_SET_H_
+
+#include <cstddef>
+#include <vector>
+
+namespace fullsail_ai { namespace fundamentals {
+
+	//! \brief A set of cells of a fixed-size map, by cell index (<code>x * height + y</code>,
+	//! as in <code>Grid2D</code>), with constant-time insertion, removal and lookup.
+	//!
+	//! The members are kept densely in an array, so walking the set costs time proportional
+	//! to its size rather than to the size of the map; each cell remembers its position in
+	//! that array, so removal swaps the last member into the hole.
+	//!
+	//! \note
+	//!   - The order of the members is unspecified and changes on removal.
+	//!   - Indices are not checked against the cell count.
+	class CellSet
+	{
+		enum : unsigned { absent = ~0u };
+
+		std::vector<unsigned> members;
+		std::vector<unsigned> positions;
+
+	public:
+		//! \brief Creates an empty set of a map without cells.
+		CellSet() { }
+
+		//! \brief Empties the set and sizes it for a map of \a cellCount cells.
+		void assign(std::size_t cellCount)
+		{
+			members.clear();
+			positions.assign(cellCount, absent);
+		}
+
+		//! \brief Empties the set and releases its memory.
+		void clear()
+		{
+			std::vector<unsigned>().swap(members);
+			std::vector<unsigned>().swap(positions);
+		}
+
+		std::size_t size() const { return members.size(); }
+		bool isEmpty() const { return members.empty(); }
+
+		//! \brief Returns the member at \a index, which is below <code>size()</code>.
+		unsigned operator[](std::size_t index) const { return members[index]; }
+
+		bool contains(unsigned cell) const { return positions[cell] != absent; }
+
+		//! \brief Adds \a cell, unless it is already a member.
+		void insert(unsigned cell)
+		{
+			if (positions[cell] == absent)
+			{
+				positions[cell] = (unsigned)members.size();
+				members.push_back(cell);
+			}
+		}
+
+		//! \brief Removes \a cell, if it is a member.
+		void erase(unsigned cell)
+		{
+			unsigned position = positions[cell];
+
+			if (position != absent)
+			{
+				unsigned last = members.back();
+
+				members[position] = last;
+				positions[last] = position;
+				members.pop_back();
+				positions[cell] = absent;
+			}
+		}
+	};
+}}  // namespace fullsail_ai::fundamentals
+
+#endif  // _FULLSAIL_AI_FUNDAMENTALS_CELL_SET_H_
@@ -0,0 +1,114 @@
+//! \file CompiledBehavior.cpp
+//! \brief Implements the <code>fullsail_ai::fundamentals::CompiledBehavior</code> class.
+
+#include <utility>
+#include "Behaviors.h"
+#include "CompiledBehavior.h"
+
+namespace fullsail_ai { namespace fundamentals {
+
+	CompiledBehavior::CompiledBehavior(Behavior* root)
+	{
+		compile(root);
+	}
+
+	void CompiledBehavior::compile(Behavior* root)
+	{
+		// Nodes waiting to be appended, each with the index of its parent's entry; children
+		// are pushed last to first so that they come off in order.
+		std::vector<std::pair<Behavior*, unsigned> > pending(1, std::make_pair(root, 0u));
+
+		while (!pending.empty())
+		{
+			Behavior* behavior = pending.back().first;
+			unsigned index = (unsigned)entries.size();
+			Entry entry = { behavior, pending.back().second, 1, LEAF };
+
+			pending.pop_back();
+
+			// Exact types only, as Composite::runSubtree() expands them: a subclass may
+			// override run(), so it runs as a leaf through its own run().
+			Composite::Kind kind = Composite::getKind(behavior);
+
+			if (kind == Composite::SEQUENCE)
+				entry.kind = SEQUENCE;
+			else if (kind == Composite::SELECTOR)
+				entry.kind = SELECTOR;
+
+			entries.push_back(entry);
+
+			// Any other node type runs its own subtree, so only sequences and selectors are expanded.
+			if (entry.kind != LEAF)
+				for (size_t childIndex = behavior->getChildCount(); childIndex-- > 0; )
+					pending.push_back(std::make_pair(behavior->getChild(childIndex), index));
+		}
+
+		// Each subtree follows its root, so adding sizes from the back totals every subtree
+		// before it is added to its parent.
+		for (size_t index = entries.size() - 1; index > 0; index--)
+			entries[entries[index].parent].subtreeSize += entries[index].subtreeSize;
+	}
+
+	size_t CompiledBehavior::getEntryCount() const
+	{
+		return entries.size();
+	}
+
+	CompiledBehavior::Entry const& CompiledBehavior::getEntry(size_t index) const
+	{
+		return entries[index];
+	}
+
+	bool CompiledBehavior::run(void (*dataFunction)(Behavior const*), void* context) const
+	{
+		Entry const* base = &entries[0];
+		unsigned index = 0;
+		bool result;
+
+		for (;;)
+		{
+			// Descend to the first node that produces a result on its own.
+			Entry const* entry = base + index;
+
+			if (entry->kind == LEAF)
+				result = entry->behavior->run(dataFunction, context);
+			else if (entry->subtreeSize > 1)
+			{
+				index++;
+				continue;
+			}
+			else
+			{
+				// An empty sequence succeeds and an empty selector fails.
+				result = (entry->kind == SEQUENCE);
+
+				if (result)
+					dataFunction(entry->behavior);
+			}
+
+			// Hand the result up until some composite needs to run its next child.
+			for (;;)
+			{
+				if (index == 0)
+					return result;
+
+				unsigned parentIndex = base[index].parent;
+				Entry const* parent = base + parentIndex;
+				unsigned next = index + base[index].subtreeSize;
+
+				// A sequence moves on after a success and a selector after a failure;
+				// otherwise the child's result is the composite's result.
+				if (result == (parent->kind == SEQUENCE) && next < parentIndex + parent->subtreeSize)
+				{
+					index = next;
+					break;
+				}
+
+				if (result)
+					dataFunction(parent->behavior);
+
+				index = parentIndex;
+			}
+		}
+	}
+}}  // namespace fullsail_ai::fundamentals
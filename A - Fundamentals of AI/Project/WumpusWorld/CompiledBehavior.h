@@ -0,0 +1,146 @@
+//! \file CompiledBehavior.h
+//! \brief Defines the <code>fullsail_ai::fundamentals::CompiledBehavior</code> class.
+#ifndef _FULLSAIL_AI_FUNDAMENTALS_COMPILED_BEHAVIOR_H_
+#define _FULLSAIL_AI_FUNDAMENTALS_COMPILED_BEHAVIOR_H_
+
+#include <type_traits>
+#include <vector>
+#include "../BehaviorTree/Behavior.h"
+
+namespace fullsail_ai { namespace fundamentals {
+
+	//! \brief A behavior tree flattened into one contiguous array, in pre-order, and
+	//! executed without recursion.
+	//!
+	//! \note
+	//!   - Nodes whose exact type is <code>Sequence</code> or <code>Selector</code> are
+	//!     interpreted directly, as <code>Composite::runSubtree()</code> does; every other
+	//!     node (leaves, subclasses of those two, and composites of other types, together
+	//!     with their subtrees) is executed by calling its own <code>run()</code>.
+	//!   - Results and <code>dataFunction</code> callbacks are the same, and come in the
+	//!     same order, as running the pointer tree from its root.
+	//!   - The compiled form refers to the original nodes, so the tree must outlive it and
+	//!     must not change shape after compiling.
+	class CompiledBehavior
+	{
+	public:
+		//! \brief Node-type tag of a compiled entry.
+		enum Kind { SEQUENCE, SELECTOR, LEAF };
+
+		//! \brief One node of the flattened tree.
+		//!
+		//! Because entries are stored in pre-order, the first child of a composite is the
+		//! next entry, and its next sibling starts \a subtreeSize entries after it.
+		struct Entry
+		{
+			Behavior* behavior;    // The original node: the leaf payload and the callback argument.
+			unsigned parent;       // Index of the parent entry (the root is its own parent).
+			unsigned subtreeSize;  // Number of entries in this subtree, including this one.
+			Kind kind;
+		};
+
+	private:
+		std::vector<Entry> entries;
+
+		// Appends the tree rooted at the specified node, in pre-order.
+		void compile(Behavior* root);
+
+		// The callback leaves get from the templated run(), which reports them itself.
+		static void ignoreBehavior(Behavior const*) {}
+
+	public:
+		//! \brief Compiles the tree rooted at \a root.
+		//!
+		//! \pre     \a root <code>\!= NULL</code>
+		explicit CompiledBehavior(Behavior* root);
+
+		//! \brief Returns the number of compiled entries.
+		size_t getEntryCount() const;
+
+		//! \brief Returns the entry at the specified pre-order index.
+		//!
+		//! \pre      \a index <code>\< getEntryCount()</code>
+		Entry const& getEntry(size_t index) const;
+
+		//! \brief Executes the tree. Returns true (and runs dataFunction on each node that
+		//! succeeds) on success, false otherwise, exactly like running the root.
+		bool run(void (*dataFunction)(Behavior const*), void* context) const;
+
+		//! \brief Executes the tree for \a context, calling \a visitor on each node that
+		//! succeeds, in the same order as the function-pointer overload.
+		//!
+		//! The loop is compiled into the caller, so a lambda or function object \a visitor
+		//! is inlined rather than called through a pointer. Leaves are still run through
+		//! their own <code>run()</code>, with a callback that does nothing, and reported
+		//! here when they succeed.
+		//!
+		//! \pre    Every leaf entry reports itself, and nothing else, when it succeeds, as
+		//!         every <code>Leaf</code> does; composites other than sequences and
+		//!         selectors (subclasses of those two included) are not expanded, so they
+		//!         must not appear in the tree.
+		//!
+		//! \note   Calls whose first argument is a function (pointer) are left to the
+		//!         function-pointer overload.
+		template <typename Context, typename Visitor>
+		typename std::enable_if<!std::is_convertible<Context&, void (*)(Behavior const*)>::value, bool>::type
+		run(Context& context, Visitor&& visitor) const;
+	};
+
+	template <typename Context, typename Visitor>
+	typename std::enable_if<!std::is_convertible<Context&, void (*)(Behavior const*)>::value, bool>::type
+	CompiledBehavior::run(Context& context, Visitor&& visitor) const
+	{
+		// The same walk as the function-pointer overload in CompiledBehavior.cpp.
+		Entry const* base = &entries[0];
+		unsigned index = 0;
+		bool result;
+
+		for (;;)
+		{
+			Entry const* entry = base + index;
+
+			if (entry->kind == LEAF)
+			{
+				result = entry->behavior->run(ignoreBehavior, &context);
+
+				if (result)
+					visitor(entry->behavior);
+			}
+			else if (entry->subtreeSize > 1)
+			{
+				index++;
+				continue;
+			}
+			else
+			{
+				result = (entry->kind == SEQUENCE);
+
+				if (result)
+					visitor(entry->behavior);
+			}
+
+			for (;;)
+			{
+				if (index == 0)
+					return result;
+
+				unsigned parentIndex = base[index].parent;
+				Entry const* parent = base + parentIndex;
+				unsigned next = index + base[index].subtreeSize;
+
+				if (result == (parent->kind == SEQUENCE) && next < parentIndex + parent->subtreeSize)
+				{
+					index = next;
+					break;
+				}
+
+				if (result)
+					visitor(parent->behavior);
+
+				index = parentIndex;
+			}
+		}
+	}
+}}  // namespace fullsail_ai::fundamentals
+
+#endif  // _FULLSAIL_AI_FUNDAMENTALS_COMPILED_BEHAVIOR_H_
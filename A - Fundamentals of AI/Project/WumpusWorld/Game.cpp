@@ -1,15 +1,26 @@
 // Game.cpp - the entry point of the Behavior Tree Game (in the Wumpus World.)
 // Code by Jeremiah Blanchard, August 2009
 // Updated by Jeremiah Blanchard, January 2012
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
 #include <limits>
 #include <iostream>
+#include <memory>
+#include <string>
 #include <vector>
-#include <queue>
 
+#include "../BehaviorTree/BehaviorArena.h"
+#include "../BehaviorTree/TickProfiler.h"
+#include "../BehaviorTree/TraceRecorder.h"
 #include "definitions.h"
 #include "Game.h"
 #include "Agent.h"
 #include "Behaviors.h"
+#include "BehaviorImage.h"
+#include "BehaviorLog.h"
+#include "Simulation.h"
 
 using namespace std;
 using namespace fullsail_ai::fundamentals;
@@ -21,62 +32,39 @@ char world1[6][6] = { { NONE, STENCH, WUMPUS, STENCH, NONE, NONE },
 					  { NONE, NONE, BREEZE, PIT, BREEZE, BREEZE },
 					  { START, NONE, NONE, BREEZE, NONE, NONE } };
 
-Behavior* buildTreeOne();
-Behavior* buildTreeTwo();
-void deleteTree(Behavior* root);
-void printLeafBehavior(Behavior const* behavior);
-void printBehavior(Behavior const* behavior);
+extern char const treeOneText[];
+extern char const treeTwoText[];
+void formatGameEvent(BehaviorLog::Event const& event, std::string& text);
 
 namespace fullsail_ai { namespace fundamentals {
 
 	void Game::main()
 	{
-		char** worldData = new char*[6];
-		for (int xIndex = 0; xIndex < 6; xIndex++)
-		{
-			worldData[xIndex] = new char[6];
-			for (int yIndex = 0; yIndex < 6; yIndex++)
-				worldData[xIndex][yIndex] = world1[xIndex][yIndex];
-		}
-
-		World world(worldData, 6, 6);
-		Behavior* behavior = new Sequence("Basic Behavior");
-		behavior->addChild(new ProcessPercepts("Process Percepts"));
-		behavior->addChild(new Selector("Choose Action"));
-		behavior->getChild(1)->addChild(new Sequence("Look For Gold"));
-		behavior->getChild(1)->getChild(0)->addChild(new CheckForGold("Check For Gold"));
-		behavior->getChild(1)->getChild(0)->addChild(new PickUpGold("Pick Up Gold"));
-		behavior->getChild(1)->addChild(new ShootWumpus("Shoot Wumpus"));
-		behavior->getChild(1)->addChild(new Selector("Explore"));
-		behavior->getChild(1)->getChild(2)->addChild(new ExploreDirection("Explore Up", UP));
-		behavior->getChild(1)->getChild(2)->addChild(new ExploreDirection("Explore Down", DOWN));
-		behavior->getChild(1)->getChild(2)->addChild(new ExploreDirection("Explore Left", LEFT));
-		behavior->getChild(1)->getChild(2)->addChild(new ExploreDirection("Explore Right", RIGHT));
+		// world1[x][y] is already laid out the way the flat constructor reads it.
+		World world(&world1[0][0], 6, 6);
+		BehaviorArena arena;
+		Behavior* behavior = createBasicBehavior(arena);
 
 		//		ProcessPercepts* behavior = new ProcessPercepts("Process Percepts");
-		Agent agent(world, *behavior, printLeafBehavior);
-		agent.enter(world.agentX, world.agentY);
+		// The leaves each update runs, and the world after it, go through the log rather
+		// than straight to cout, so the updates do not wait on the console.
+		BehaviorLog log(stdout, BehaviorLog::TEXT, formatGameEvent);
+		Agent agent(world, *behavior, BehaviorLog::logLeaf);
+		unsigned tick = 0;
 
-		cout << "\nWorld Information\n-----------------\n";
-		cout << "Agent Position: (" << world.agentX << ", " << world.agentY << ")" << endl;
-		cout << "Agent Has Arrow: " << world.agentHasArrow << endl;
-		cout << "Agent Has Gold: " << world.goldRetrieved << endl;
-		cout << "Agent is Alive: " << world.agentAlive << endl;
-		cout << "Wumpus is Alive: " << world.wumpusAlive << endl << endl;
+		agent.enter(world.agentX, world.agentY);
+		log.beginTick(0, tick);
+		log.logStatus(world);
 
 		while(world.agentAlive && world.agentHasArrow)
 		{
-			cout << "Leaf Behaviors\n--------------\n";
+			log.beginTick(0, ++tick);
 			agent.update();
-
-			cout << "\nWorld Information\n-----------------\n";
-			cout << "Agent Position: (" << world.agentX << ", " << world.agentY << ")" << endl;
-			cout << "Agent Has Arrow: " << world.agentHasArrow << endl;
-			cout << "Agent Has Gold: " << world.goldRetrieved << endl;
-			cout << "Agent is Alive: " << world.agentAlive << endl;
-			cout << "Wumpus is Alive: " << world.wumpusAlive << endl << endl;
+			log.logStatus(world);
 		}
 
+		log.flush();
+
 		if (!world.agentAlive)
 			cout << "You died!" << endl;
 
@@ -87,154 +75,233 @@ namespace fullsail_ai { namespace fundamentals {
 			cout << "You killed the wumpus!" << endl;
 
 		cout << "Press ENTER to continue..." << endl;
-		while(cin.get() != '\n') {;}
+		while(cin.get() != '\n' && cin) {;}
+	}
+
+	void Game::simulate(unsigned episodes, unsigned threads, char const* profilePath, BehaviorLog* log)
+	{
+		vector<unsigned> seeds(episodes);
+
+		for (unsigned index = 0; index < episodes; index++)
+			seeds[index] = index;
 
-		deleteTree(behavior);
-		for (unsigned index = 0; index < 6; index++)
-			delete worldData[index];
+		WorkStealingPool pool(threads);
+		SimulationStatistics statistics = Simulation(8, 1000).run(seeds, pool, log);
 
-		delete[] worldData;
+		cout << "Episodes: " << statistics.episodes << endl;
+		cout << "Wins: " << statistics.wins << endl;
+		cout << "Deaths: " << statistics.deaths << endl;
+		cout << "Gold Retrieved: " << statistics.goldRetrieved << endl;
+		cout << "Wumpus Killed: " << statistics.wumpusKilled << endl;
+		cout << "Timed Out: " << statistics.timeouts << endl;
+		cout << "Agent Updates: " << statistics.ticks << endl;
+
+		if (profilePath)
+		{
+#if defined(FULLSAIL_PROFILE_TICKS)
+			ofstream profile(profilePath);
+
+			TickProfiler::writeFoldedStacks(profile);
+
+			if (profile.flush())
+				cout << "Tick profile written to " << profilePath << endl;
+			else
+				cout << "Could not write " << profilePath << endl;
+#else
+			cout << "Not written: " << profilePath << " needs a build with FUNDAMENTALS_PROFILE" << endl;
+#endif
+		}
 	}
 }}
 
-void main()
+int main(int argc, char* argv[])
 {
-	// First, run a general test of the behavior tree mechanisms.
-	Behavior* root = buildTreeOne();
-	cout << "\nTree One:\n---------\n";
-	root->run(printBehavior, NULL);
-	deleteTree(root);
+	// "--simulate [episodes] [threads] [profile] [--trace file] [--log file [--log-every N]
+	// [--log-agents seed,seed...]]" skips the demonstrations and runs headlessly; --trace
+	// records a Chrome trace of the run, and --log a binary BehaviorLog of the updates of
+	// the sampled ticks and agents (each episode's agent is its world's seed).
+	if (argc > 1 && strcmp(argv[1], "--simulate") == 0)
+	{
+		char const* arguments[3] = { NULL, NULL, NULL };
+		char const* tracePath = NULL;
+		char const* logPath = NULL;
+		unsigned logPeriod = 1;
+		vector<unsigned> logAgents;
+		int count = 0;
+
+		for (int index = 2; index < argc; index++)
+		{
+			if (strcmp(argv[index], "--trace") == 0 && index + 1 < argc)
+				tracePath = argv[++index];
+			else if (strcmp(argv[index], "--log") == 0 && index + 1 < argc)
+				logPath = argv[++index];
+			else if (strcmp(argv[index], "--log-every") == 0 && index + 1 < argc)
+				logPeriod = (unsigned)atoi(argv[++index]);
+			else if (strcmp(argv[index], "--log-agents") == 0 && index + 1 < argc)
+			{
+				for (char const* agent = argv[++index]; agent; agent = strchr(agent, ','))
+					logAgents.push_back((unsigned)atoi(*agent == ',' ? ++agent : agent));
+			}
+			else if (count < 3)
+				arguments[count++] = argv[index];
+		}
+
+		unsigned episodes = arguments[0] ? (unsigned)atoi(arguments[0]) : 1000;
+		unsigned threads = arguments[1] ? (unsigned)atoi(arguments[1]) : thread::hardware_concurrency();
+
+		if (tracePath && !TraceRecorder::start(tracePath))
+		{
+			cout << "Could not write " << tracePath << endl;
+			return 1;
+		}
 
-	root = buildTreeTwo();
+		FILE* logFile = logPath ? fopen(logPath, "wb") : NULL;
+
+		if (logPath && !logFile)
+		{
+			cout << "Could not write " << logPath << endl;
+			return 1;
+		}
+
+		unique_ptr<BehaviorLog> log(logFile ? new BehaviorLog(logFile, BehaviorLog::BINARY) : NULL);
+
+		if (log)
+		{
+			log->setSampling(logPeriod);
+			log->setAgentFilter(logAgents);
+		}
+
+		fullsail_ai::fundamentals::Game::simulate(episodes, threads, arguments[2], log.get());
+		log.reset();
+
+		if (tracePath)
+		{
+			TraceRecorder::stop();
+			cout << "Trace written to " << tracePath << " (" << TraceRecorder::getDroppedCount() << " spans dropped)" << endl;
+		}
+
+		if (logFile)
+		{
+			fclose(logFile);
+			cout << "Behavior log written to " << logPath << endl;
+		}
+
+		return 0;
+	}
+
+	// First, run a general test of the behavior tree mechanisms, running tree one in
+	// place from its compiled image...
+	BehaviorLog log(stdout, BehaviorLog::TEXT, formatGameEvent);
+	vector<char> image = BehaviorImage::compile(treeOneText);
+	log.beginTick(0, 0);
+	{
+		BehaviorImage treeOne(&image[0], image.size());
+		cout << "\nTree One:\n---------\n";
+		treeOne.run(BehaviorLog::logNode, NULL);
+		log.flush();
+	}
+
+	// ...and building tree two as ordinary nodes, to traverse it.
+	image = BehaviorImage::compile(treeTwoText);
+	BehaviorArena arena;
+	Behavior* root = BehaviorImage(&image[0], image.size()).instantiate(arena);
 	cout << "\nTree Two:\n----------\n";
-	root->run(printBehavior, NULL);
+	root->run(BehaviorLog::logNode, NULL);
+	log.flush();
 	cout << "\nBreadth-First:\n--------------\n";
-	root->breadthFirstTraverse(printBehavior);
+	root->breadthFirstTraverse(BehaviorLog::logNode);
+	log.flush();
 	cout << "\nPreorder\n--------\n";
-	root->preOrderTraverse(printBehavior);
+	root->preOrderTraverse(BehaviorLog::logNode);
+	log.flush();
 	cout << "\nPostorder\n---------\n";
-	root->postOrderTraverse(printBehavior);
-	deleteTree(root);
+	root->postOrderTraverse(BehaviorLog::logNode);
+	log.flush();
 
 	cout << "Press ENTER to continue..." << endl;
-	while(cin.get() != '\n') {;}
+	while(cin.get() != '\n' && cin) {;}
 
 	// Then, run the wumpus world game simulation.
 	fullsail_ai::fundamentals::Game::main();
+	return 0;
 }
 
-Behavior* buildTreeOne()
+char const treeOneText[] =
+	"Selector \"Decider\"\n"
+	"\t# The \"Spy\" branch.\n"
+	"\tSequence \"SpyOnEnemy\"\n"
+	"\t\tTestBehavior \"Find\" true\n"
+	"\t\tTestBehavior \"Follow\" true\n"
+	"\t\tTestBehavior \"Report\" false\n"
+	"\t# The \"Attack\" branch.\n"
+	"\tSelector \"Approach\"\n"
+	"\t\tSequence \"DirectAttack\"\n"
+	"\t\t\tTestBehavior \"DrawWeapon\" true\n"
+	"\t\t\tSelector \"WeaponAttack\"\n"
+	"\t\t\t\tTestBehavior \"StabLeft\" false\n"
+	"\t\t\t\tTestBehavior \"StabFront\" false\n"
+	"\t\t\t\tTestBehavior \"StabRight\" false\n"
+	"\t\tSequence \"SneakAttack\"\n"
+	"\t\t\tTestBehavior \"Find\" false\n"
+	"\t\t\tTestBehavior \"Follow\" true\n"
+	"\t\t\tTestBehavior \"Back-Stab\" false\n"
+	"\t# The \"Flee\" branch.\n"
+	"\tSequence \"Flee\"\n"
+	"\t\tTestBehavior \"FindEscape\" true\n"
+	"\t\tTestBehavior \"FollowPath\" true\n"
+	"\t\tTestBehavior \"RunAway\" true\n";
+
+char const treeTwoText[] =
+	"Selector \"Decider\"\n"
+	"\t# The \"Spy\" branch.\n"
+	"\tSequence \"SpyOnEnemy\"\n"
+	"\t\tTestBehavior \"Find\" false\n"
+	"\t\tTestBehavior \"Follow\" false\n"
+	"\t\tTestBehavior \"Report\" false\n"
+	"\t# The \"Attack\" branch.\n"
+	"\tSelector \"Approach\"\n"
+	"\t\tSequence \"DirectAttack\"\n"
+	"\t\t\tTestBehavior \"DrawWeapon\" true\n"
+	"\t\t\tSelector \"WeaponAttack\"\n"
+	"\t\t\t\tTestBehavior \"StabLeft\" true\n"
+	"\t\t\t\tTestBehavior \"StabFront\" true\n"
+	"\t\t\t\tTestBehavior \"StabRight\" true\n"
+	"\t\tSequence \"SneakAttack\"\n"
+	"\t\t\tTestBehavior \"Find\" false\n"
+	"\t\t\tTestBehavior \"Follow\" false\n"
+	"\t\t\tTestBehavior \"Back-Stab\" true\n"
+	"\t# The \"Flee\" branch.\n"
+	"\tSequence \"Flee\"\n"
+	"\t\tTestBehavior \"FindEscape\" true\n"
+	"\t\tTestBehavior \"FollowPath\" true\n"
+	"\t\tTestBehavior \"RunAway\" false\n";
+
+// Renders the log the way the game has always printed: the leaves that succeeded during
+// an update, and then the state of the world. Tick 0 is the world before the first update.
+void formatGameEvent(BehaviorLog::Event const& event, std::string& text)
 {
-	Behavior* node1, * node2, *node3;
-
-	// Create the root.
-	Behavior* root = new Selector("Decider");
-
-	// Build the "Spy" branch.
-	node1 = new Sequence("SpyOnEnemy");
-	node1->addChild(new TestBehavior("Find", true));
-	node1->addChild(new TestBehavior("Follow", true));
-	node1->addChild(new TestBehavior("Report", false));
-	root->addChild(node1);
-
-	// Build the "Attack" branch.
-	node1 = new Selector("Approach");
-
-	node2 = new Sequence("DirectAttack");
-	node2->addChild(new TestBehavior("DrawWeapon", true));
-	node3 = new Selector("WeaponAttack");
-	node3->addChild(new TestBehavior("StabLeft", false));
-	node3->addChild(new TestBehavior("StabFront", false));
-	node3->addChild(new TestBehavior("StabRight", false));
-	node2->addChild(node3);
-	node1->addChild(node2);
-
-	node2 = new Sequence("SneakAttack");
-	node2->addChild(new TestBehavior("Find", false));
-	node2->addChild(new TestBehavior("Follow", true));
-	node2->addChild(new TestBehavior("Back-Stab", false));
-	node1->addChild(node2);
-
-	root->addChild(node1);
-
-	// Build the "Flee" branch.
-	node1 = new Sequence("Flee");
-	node1->addChild(new TestBehavior("FindEscape", true));
-	node1->addChild(new TestBehavior("FollowPath", true));
-	node1->addChild(new TestBehavior("RunAway", true));
-	root->addChild(node1);
-
-	return root;
-}
+	char line[64];
 
-Behavior* buildTreeTwo()
-{
-	Behavior* node1, * node2, *node3;
-
-	// Create the root.
-	Behavior* root = new Selector("Decider");
-
-	// Build the "Spy" branch.
-	node1 = new Sequence("SpyOnEnemy");
-	node1->addChild(new TestBehavior("Find", false));
-	node1->addChild(new TestBehavior("Follow", false));
-	node1->addChild(new TestBehavior("Report", false));
-	root->addChild(node1);
-
-	// Build the "Attack" branch.
-	node1 = new Selector("Approach");
-
-	node2 = new Sequence("DirectAttack");
-	node2->addChild(new TestBehavior("DrawWeapon", true));
-	node3 = new Selector("WeaponAttack");
-	node3->addChild(new TestBehavior("StabLeft", true));
-	node3->addChild(new TestBehavior("StabFront", true));
-	node3->addChild(new TestBehavior("StabRight", true));
-	node2->addChild(node3);
-	node1->addChild(node2);
-
-	node2 = new Sequence("SneakAttack");
-	node2->addChild(new TestBehavior("Find", false));
-	node2->addChild(new TestBehavior("Follow", false));
-	node2->addChild(new TestBehavior("Back-Stab", true));
-	node1->addChild(node2);
-
-	root->addChild(node1);
-
-	// Build the "Flee" branch.
-	node1 = new Sequence("Flee");
-	node1->addChild(new TestBehavior("FindEscape", true));
-	node1->addChild(new TestBehavior("FollowPath", true));
-	node1->addChild(new TestBehavior("RunAway", false));
-	root->addChild(node1);
-
-	return root;
-}
-
-void deleteTree(Behavior* root)
-{
-	std::queue<Behavior*> q;
-	q.push(root);
-
-	while (!q.empty())
+	switch (event.kind)
 	{
-		Behavior* current = q.front();
-		q.pop();
-
-		for (size_t index = 0; index < current->getChildCount(); index++)
-			q.push(current->getChild(index));
-
-		delete current;
+	case BehaviorLog::TICK:
+		if (event.tick != 0)
+			text += "Leaf Behaviors\n--------------\n";
+		break;
+
+	case BehaviorLog::NODE:
+		text += event.node->toString();
+		text += '\n';
+		break;
+
+	case BehaviorLog::STATUS:
+		snprintf(line, sizeof(line), "Agent Position: (%u, %u)\n", event.x, event.y);
+		text += "\nWorld Information\n-----------------\n";
+		text += line;
+		text += (event.result & BehaviorLog::HAS_ARROW) ? "Agent Has Arrow: 1\n" : "Agent Has Arrow: 0\n";
+		text += (event.result & BehaviorLog::HAS_GOLD) ? "Agent Has Gold: 1\n" : "Agent Has Gold: 0\n";
+		text += (event.result & BehaviorLog::AGENT_ALIVE) ? "Agent is Alive: 1\n" : "Agent is Alive: 0\n";
+		text += (event.result & BehaviorLog::WUMPUS_ALIVE) ? "Wumpus is Alive: 1\n\n" : "Wumpus is Alive: 0\n\n";
+		break;
 	}
 }
-
-void printLeafBehavior(Behavior const* behavior)
-{
-	if (behavior->isLeaf())
-		cout << behavior->toString() << endl;
-}
-
-void printBehavior(Behavior const* behavior)
-{
-	cout << behavior->toString() << endl;
-}
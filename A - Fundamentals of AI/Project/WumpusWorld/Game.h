@@ -8,10 +8,19 @@ using namespace std;
 
 namespace fullsail_ai { namespace fundamentals {
 
+	class BehaviorLog;
+
 	class Game
 	{
 	public:
 		static void main();
+
+		// Runs the specified number of generated worlds headlessly on a thread pool
+		// and prints the totals. With a profilePath, also writes the tick profile there
+		// as folded stacks (in a build with FUNDAMENTALS_PROFILE). With a log, records the
+		// episodes' updates to it.
+		static void simulate(unsigned episodes, unsigned threads, char const* profilePath = NULL,
+		                     BehaviorLog* log = NULL);
 	};
 
 }}  // namespace fullsail_ai::fundamentals
@@ -0,0 +1,119 @@
+//! \file Grid2D.h
+//! \brief Defines the <code>fullsail_ai::fundamentals::Grid2D</code> class template.
+#ifndef _FULLSAIL_AI_FUNDAMENTALS_GRID_2D_H_
+#define _FULLSAIL_AI_FUNDAMENTALS_GRID_2D_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+namespace fullsail_ai { namespace fundamentals {
+
+	//! \brief Fixed-size two-dimensional grid stored in one contiguous allocation.
+	//!
+	//! Cells are laid out x-major: cell (x, y) is at index <code>x * height + y</code>,
+	//! which is the layout <code>WorldGenerator</code> writes and matches the
+	//! <code>[x][y]</code> subscripts of the nested vectors it replaced.
+	//!
+	//! \note
+	//!   - <code>operator()</code> does not check its arguments; <code>at()</code> throws
+	//!     <code>std::out_of_range</code> instead.
+	//!   - <code>contains()</code> takes unsigned coordinates, so a coordinate that
+	//!     wrapped below zero is rejected along with those past the far edge.
+	template <typename T>
+	class Grid2D
+	{
+		std::vector<T> cells;
+		unsigned width;
+		unsigned height;
+
+	public:
+		//! \brief Creates an empty grid.
+		Grid2D() : width(0), height(0) { }
+
+		//! \brief Creates a grid with every cell set to \a value.
+		Grid2D(unsigned _width, unsigned _height, T const& value = T())
+			: cells((std::size_t)_width * _height, value), width(_width), height(_height)
+		{
+		}
+
+		//! \brief Creates a grid from \a data, laid out as described above.
+		Grid2D(T const* data, unsigned _width, unsigned _height)
+			: cells(data, data + (std::size_t)_width * _height), width(_width), height(_height)
+		{
+		}
+
+		unsigned getWidth() const { return width; }
+		unsigned getHeight() const { return height; }
+
+		//! \brief Returns the number of cells, <code>getWidth() * getHeight()</code>.
+		std::size_t getCellCount() const { return cells.size(); }
+
+		//! \brief Resizes the grid and sets every cell to \a value.
+		void assign(unsigned _width, unsigned _height, T const& value = T())
+		{
+			cells.assign((std::size_t)_width * _height, value);
+			width = _width;
+			height = _height;
+		}
+
+		//! \brief Sets every cell to \a value.
+		void fill(T const& value)
+		{
+			std::fill(cells.begin(), cells.end(), value);
+		}
+
+		//! \brief Empties the grid and releases its memory.
+		void clear()
+		{
+			std::vector<T>().swap(cells);
+			width = height = 0;
+		}
+
+		//! \brief Returns <code>true</code> if (\a x, \a y) lies on the grid.
+		bool contains(unsigned x, unsigned y) const
+		{
+			return x < width && y < height;
+		}
+
+		//! \brief Returns the cell at (\a x, \a y), unchecked.
+		T& operator()(unsigned x, unsigned y) { return cells[(std::size_t)x * height + y]; }
+		T const& operator()(unsigned x, unsigned y) const { return cells[(std::size_t)x * height + y]; }
+
+		//! \brief Returns the cell at (\a x, \a y).
+		//!
+		//! \throw  std::out_of_range if (\a x, \a y) is not on the grid.
+		T& at(unsigned x, unsigned y)
+		{
+			if (!contains(x, y))
+				throw std::out_of_range("Grid2D::at");
+
+			return (*this)(x, y);
+		}
+
+		T const& at(unsigned x, unsigned y) const
+		{
+			if (!contains(x, y))
+				throw std::out_of_range("Grid2D::at");
+
+			return (*this)(x, y);
+		}
+
+		//! \brief Returns the underlying array of <code>getCellCount()</code> cells.
+		T* getData() { return cells.empty() ? 0 : &cells[0]; }
+		T const* getData() const { return cells.empty() ? 0 : &cells[0]; }
+
+		inline friend bool operator==(Grid2D const& lhs, Grid2D const& rhs)
+		{
+			return lhs.width == rhs.width && lhs.height == rhs.height && lhs.cells == rhs.cells;
+		}
+
+		inline friend bool operator!=(Grid2D const& lhs, Grid2D const& rhs)
+		{
+			return !(lhs == rhs);
+		}
+	};
+}}  // namespace fullsail_ai::fundamentals
+
+#endif  // _FULLSAIL_AI_FUNDAMENTALS_GRID_2D_H_
@@ -0,0 +1,310 @@
+//! \file PathPlanner.cpp
+//! \brief Implements the <code>fullsail_ai::fundamentals::PathPlanner</code> class.
+
+#include <algorithm>
+#include "Agent.h"
+#include "PathPlanner.h"
+
+namespace fullsail_ai { namespace fundamentals {
+
+	namespace {
+
+		int const offset[4][2] = { {-1, 0}, {1, 0}, {0, -1}, {0, 1} };
+
+		unsigned distance(unsigned a, unsigned b)
+		{
+			return a > b ? a - b : b - a;
+		}
+
+		// Orders the open list as a min-heap on the estimate, preferring the entry that
+		// has come further on ties, which keeps A* from fanning out across equal costs.
+		struct Later
+		{
+			template <typename Entry>
+			bool operator()(Entry const& lhs, Entry const& rhs) const
+			{
+				return lhs.estimate > rhs.estimate || (lhs.estimate == rhs.estimate && lhs.cost < rhs.cost);
+			}
+		};
+	}
+
+	PathPlanner::PathPlanner(bool _jumpPoints)
+		: knowledge(0), width(0), height(0), search(0), goalX(0), goalY(0), jumpPoints(_jumpPoints), expanded(0)
+	{
+	}
+
+	void PathPlanner::begin(Knowledge const& _knowledge)
+	{
+		knowledge = &_knowledge;
+		width = _knowledge.modelWorld.getWidth();
+		height = _knowledge.modelWorld.getHeight();
+		expanded = 0;
+		open.clear();
+
+		// The generations of the previous searches mark nothing as reached in this one;
+		// only a larger map, or running out of generations, clears the arrays.
+		if (nodes.size() < (std::size_t)width * height || search >= 0x7FFFFFFEu)
+		{
+			Node empty = { 0, 0, 0, 0 };
+
+			Run unknown = { { 0, 0 }, { absent, absent } };
+
+			nodes.assign((std::size_t)width * height, empty);
+			runs.assign(jumpPoints ? (std::size_t)width * height : 0, unknown);
+			search = 0;
+		}
+
+		search++;
+	}
+
+	bool PathPlanner::isSafe(unsigned x, unsigned y) const
+	{
+		return x < width && y < height
+		    && (knowledge->modelWorld(x, y) == Knowledge::CLEAR || !(knowledge->stimulus(x, y) & UNEXPLORED));
+	}
+
+	unsigned PathPlanner::estimate(unsigned x, unsigned y) const
+	{
+		return distance(x, goalX) + distance(y, goalY);
+	}
+
+	void PathPlanner::reach(unsigned cell, unsigned parent, unsigned cost)
+	{
+		Node& node = nodes[cell];
+
+		if (node.generation == 2 * search + 1 || (node.generation == 2 * search && node.cost <= cost))
+			return;
+
+		node.cost = cost;
+		node.parent = parent;
+		node.generation = 2 * search;
+
+		OpenEntry entry = { cost + estimate(cell / height, cell % height), cost, cell };
+
+		open.push_back(entry);
+		std::push_heap(open.begin(), open.end(), Later());
+	}
+
+	bool PathPlanner::popOpen(unsigned& cell)
+	{
+		while (!open.empty())
+		{
+			OpenEntry entry = open.front();
+
+			std::pop_heap(open.begin(), open.end(), Later());
+			open.pop_back();
+
+			// Entries are never updated in place; a cheaper route pushes a new one, and
+			// the stale one is skipped here.
+			Node& node = nodes[entry.cell];
+
+			if (node.generation == 2 * search && node.cost == entry.cost)
+			{
+				node.generation = 2 * search + 1;
+				expanded++;
+				cell = entry.cell;
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	void PathPlanner::expand(unsigned cell)
+	{
+		unsigned x = cell / height, y = cell % height;
+		Node const& node = nodes[cell];
+		int directions[4][2];
+		int directionCount = 0;
+
+		if (jumpPoints && node.parent != cell)
+		{
+			// Only the way back is pruned; a shortest path never doubles back on itself.
+			unsigned parentX = node.parent / height, parentY = node.parent % height;
+			int dx = (x > parentX) - (x < parentX), dy = (y > parentY) - (y < parentY);
+
+			for (int index = 0; index < 4; index++)
+				if (!(offset[index][0] == -dx && offset[index][1] == -dy))
+				{
+					directions[directionCount][0] = offset[index][0];
+					directions[directionCount][1] = offset[index][1];
+					directionCount++;
+				}
+		}
+		else
+			for (directionCount = 0; directionCount < 4; directionCount++)
+			{
+				directions[directionCount][0] = offset[directionCount][0];
+				directions[directionCount][1] = offset[directionCount][1];
+			}
+
+		for (int index = 0; index < directionCount; index++)
+		{
+			int dx = directions[index][0], dy = directions[index][1];
+
+			if (jumpPoints)
+			{
+				unsigned jumpX, jumpY;
+
+				if (jump(x, y, dx, dy, jumpX, jumpY))
+					reach(jumpX * height + jumpY, cell, node.cost + distance(x, jumpX) + distance(y, jumpY));
+			}
+			else if (isSafe(x + dx, y + dy))
+				reach((x + dx) * height + y + dy, cell, node.cost + 1);
+		}
+	}
+
+	bool PathPlanner::jumpAlongColumn(unsigned x, unsigned y, int dy, unsigned& jumpY)
+	{
+		unsigned side = dy > 0, end = y, result = absent, column = x * height;
+
+		for (;;)
+		{
+			Run const& run = runs[column + end];
+
+			if (run.search[side] == search)
+			{
+				result = run.end[side];
+				break;
+			}
+
+			end += dy;
+
+			if (!isSafe(x, end))
+				break;
+
+			// Stop at the goal, at a cell of a path being repaired, and where a wall beside
+			// the run ends: the cell past its end can only be reached through here.
+			if ((x == goalX && end == goalY) || nodes[column + end].pathMark == search
+			    || (isSafe(x - 1, end) && !isSafe(x - 1, end - dy)) || (isSafe(x + 1, end) && !isSafe(x + 1, end - dy)))
+			{
+				result = end;
+				break;
+			}
+		}
+
+		// Every cell passed on the way jumps to the same place.
+		for (; y != end; y += dy)
+		{
+			Run& run = runs[column + y];
+
+			run.search[side] = search;
+			run.end[side] = result;
+		}
+
+		jumpY = result;
+		return result != absent;
+	}
+
+	bool PathPlanner::jump(unsigned x, unsigned y, int dx, int dy, unsigned& jumpX, unsigned& jumpY)
+	{
+		if (dx == 0)
+		{
+			jumpX = x;
+			return jumpAlongColumn(x, y, dy, jumpY);
+		}
+
+		// Runs across columns also stop wherever a run along the column would, so that turns
+		// are only ever taken at jump points.
+		for (;;)
+		{
+			x += dx;
+
+			if (!isSafe(x, y))
+				return false;
+
+			unsigned ignored;
+
+			if ((x == goalX && y == goalY) || nodes[x * height + y].pathMark == search
+			    || (isSafe(x, y - 1) && !isSafe(x - dx, y - 1)) || (isSafe(x, y + 1) && !isSafe(x - dx, y + 1))
+			    || jumpAlongColumn(x, y, 1, ignored) || jumpAlongColumn(x, y, -1, ignored))
+			{
+				jumpX = x;
+				jumpY = y;
+				return true;
+			}
+		}
+	}
+
+	void PathPlanner::appendPath(unsigned cell, std::vector<unsigned>& path) const
+	{
+		// Jump point parents are in line with their children; fill in the cells between.
+		while (nodes[cell].parent != cell)
+		{
+			unsigned parent = nodes[cell].parent;
+			unsigned x = cell / height, y = cell % height;
+			unsigned parentX = parent / height, parentY = parent % height;
+			int dx = (parentX > x) - (parentX < x), dy = (parentY > y) - (parentY < y);
+
+			for (; x != parentX || y != parentY; x += dx, y += dy)
+				path.push_back(x * height + y);
+
+			cell = parent;
+		}
+	}
+
+	bool PathPlanner::findPath(Knowledge const& _knowledge, unsigned startX, unsigned startY,
+	                           unsigned _goalX, unsigned _goalY, std::vector<unsigned>& path)
+	{
+		begin(_knowledge);
+		goalX = _goalX;
+		goalY = _goalY;
+		path.clear();
+
+		unsigned start = startX * height + startY, goal = goalX * height + goalY, cell;
+
+		reach(start, start, 0);
+
+		while (popOpen(cell))
+		{
+			if (cell == goal)
+			{
+				appendPath(goal, path);
+				return true;
+			}
+
+			expand(cell);
+		}
+
+		return false;
+	}
+
+	bool PathPlanner::repairPath(Knowledge const& _knowledge, unsigned startX, unsigned startY, std::vector<unsigned>& path)
+	{
+		if (path.empty())
+			return false;
+
+		begin(_knowledge);
+		goalX = path.front() / height;
+		goalY = path.front() % height;
+
+		unsigned start = startX * height + startY, cell;
+
+		for (std::size_t index = 0; index < path.size(); index++)
+			nodes[path[index]].pathMark = search;
+
+		// Standing on the path already: drop the part behind.
+		if (nodes[start].pathMark == search)
+		{
+			path.erase(std::find(path.begin(), path.end(), start), path.end());
+			return true;
+		}
+
+		reach(start, start, 0);
+
+		while (popOpen(cell))
+		{
+			if (nodes[cell].pathMark == search)
+			{
+				path.erase(std::find(path.begin(), path.end(), cell), path.end());
+				appendPath(cell, path);
+				return true;
+			}
+
+			expand(cell);
+		}
+
+		path.clear();
+		return false;
+	}
+}}  // namespace fullsail_ai::fundamentals
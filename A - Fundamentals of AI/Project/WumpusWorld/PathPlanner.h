@@ -0,0 +1,112 @@
+//! \file PathPlanner.h
+//! \brief Defines the <code>fullsail_ai::fundamentals::PathPlanner</code> class.
+#ifndef _FULLSAIL_AI_FUNDAMENTALS_PATH_PLANNER_H_
+#define _FULLSAIL_AI_FUNDAMENTALS_PATH_PLANNER_H_
+
+#include <cstddef>
+#include <vector>
+
+namespace fullsail_ai { namespace fundamentals {
+
+	struct Knowledge;
+
+	//! \brief Finds shortest four-connected paths across the cells an agent knows to be
+	//! safe: the ones it has explored, and the ones its <code>modelWorld</code> marks
+	//! <code>CLEAR</code>.
+	//!
+	//! Searches are A*, optionally with Jump Point Search: a straight run is followed
+	//! without queuing its cells until it reaches the goal or a cell with a forced
+	//! neighbor, so open areas cost a handful of heap operations instead of one per cell.
+	//! Jumping is opt-in: where walls are common it saves a little, but across open
+	//! ground its column scans cost far more than the heap operations they replace.
+	//! Jumps across columns look along every column they cross, which is contiguous in
+	//! memory; where each of those jumps ends is remembered for every cell it passed, so
+	//! each column is scanned at most once per direction and search.
+	//!
+	//! All per-cell search state (costs, parents, the closed set) lives in one array that
+	//! is reused by every search and only reallocated when a larger map comes along; each
+	//! search invalidates the previous one's entries by bumping a generation number
+	//! instead of clearing them. The open list keeps its capacity too, so a warmed-up
+	//! planner does not allocate.
+	//!
+	//! Paths are written to a caller-owned vector as cell indices
+	//! (<code>x * height + y</code>), goal first and next step last, so that following a
+	//! path is <code>pop_back()</code>. They exclude the start cell.
+	//!
+	//! \note
+	//!   - Knowledge only ever grows the safe set (<code>CLEAR</code> is never revoked), so
+	//!     a cached path stays walkable. <code>repairPath()</code> handles the remaining
+	//!     case, an agent that has been moved off its path.
+	class PathPlanner
+	{
+		struct Node
+		{
+			unsigned cost;
+			unsigned parent;
+			unsigned generation; // 2 * search when reached, 2 * search + 1 when closed
+			unsigned pathMark; // search when the cell is on the path being repaired
+		};
+
+		struct OpenEntry
+		{
+			unsigned estimate;
+			unsigned cost;
+			unsigned cell;
+		};
+
+		// Where a jump along the column from a cell ends, toward lower and higher y.
+		struct Run
+		{
+			unsigned search[2];
+			unsigned end[2]; // absent when the jump runs into a wall
+		};
+
+		enum : unsigned { absent = ~0u };
+
+		std::vector<Node> nodes;
+		std::vector<Run> runs;
+		std::vector<OpenEntry> open;
+		Knowledge const* knowledge;
+		unsigned width;
+		unsigned height;
+		unsigned search;
+		unsigned goalX;
+		unsigned goalY;
+		bool jumpPoints;
+		std::size_t expanded;
+
+		void begin(Knowledge const& _knowledge);
+		bool isSafe(unsigned x, unsigned y) const;
+		unsigned estimate(unsigned x, unsigned y) const;
+		void reach(unsigned cell, unsigned parent, unsigned cost);
+		bool popOpen(unsigned& cell);
+		void expand(unsigned cell);
+		bool jump(unsigned x, unsigned y, int dx, int dy, unsigned& jumpX, unsigned& jumpY);
+		bool jumpAlongColumn(unsigned x, unsigned y, int dy, unsigned& jumpY);
+		void appendPath(unsigned cell, std::vector<unsigned>& path) const;
+
+	public:
+		//! \brief Creates a planner; \a _jumpPoints chooses Jump Point Search over plain A*.
+		explicit PathPlanner(bool _jumpPoints = false);
+
+		//! \brief Finds a shortest path from (\a startX, \a startY) to (\a _goalX, \a _goalY)
+		//! and stores it in \a path.
+		//!
+		//! \return  <code>false</code>, leaving \a path empty, if the goal cannot be reached.
+		bool findPath(Knowledge const& _knowledge, unsigned startX, unsigned startY,
+		              unsigned _goalX, unsigned _goalY, std::vector<unsigned>& path);
+
+		//! \brief Reconnects (\a startX, \a startY) to the cached \a path, which was found by
+		//! this planner or <code>findPath()</code> for the same knowledge. Searches toward
+		//! the goal, but stops at the first cell of \a path it reaches and splices the
+		//! detour onto the remainder, so the cost follows the detour rather than the path.
+		//!
+		//! \return  <code>false</code>, leaving \a path empty, if the goal cannot be reached.
+		bool repairPath(Knowledge const& _knowledge, unsigned startX, unsigned startY, std::vector<unsigned>& path);
+
+		//! \brief Returns the number of cells the last search closed.
+		std::size_t getExpandedCount() const { return expanded; }
+	};
+}}  // namespace fullsail_ai::fundamentals
+
+#endif  // _FULLSAIL_AI_FUNDAMENTALS_PATH_PLANNER_H_
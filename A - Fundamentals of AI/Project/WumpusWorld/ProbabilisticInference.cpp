@@ -0,0 +1,400 @@
+//! \file ProbabilisticInference.cpp
+//! \brief Implements the <code>fullsail_ai::fundamentals::ProbabilisticInference</code> class.
+
+#include <algorithm>
+#include <cstdint>
+#include "Agent.h"
+#include "ProbabilisticInference.h"
+
+namespace fullsail_ai { namespace fundamentals {
+
+	namespace {
+
+		int const offset[4][2] = { {-1, 0}, {1, 0}, {0, -1}, {0, 1} };
+
+		typedef std::unordered_map<std::uint64_t, double> StateWeights;
+
+		unsigned findRoot(std::vector<unsigned>& parents, unsigned index)
+		{
+			while (parents[index] != index)
+				index = parents[index] = parents[parents[index]];
+
+			return index;
+		}
+
+		// Rescales the weights to sum to one. Only ratios of sums over the same step are
+		// ever taken, so the scale is free, and keeping it near one avoids underflow.
+		void normalize(StateWeights& weights)
+		{
+			double total = 0;
+
+			for (StateWeights::const_iterator weight = weights.begin(); weight != weights.end(); ++weight)
+				total += weight->second;
+
+			if (total > 0)
+				for (StateWeights::iterator weight = weights.begin(); weight != weights.end(); ++weight)
+					weight->second /= total;
+		}
+	}
+
+	ProbabilisticInference::ProbabilisticInference(double pitProbability)
+		: pitPrior(pitProbability), width(0), height(0), wumpusDefault(0), cacheHits(0), cacheMisses(0),
+		  componentCount(0), largestComponent(0), frontierSize(0)
+	{
+	}
+
+	void ProbabilisticInference::update(Knowledge const& knowledge)
+	{
+		width = knowledge.stimulus.getWidth();
+		height = knowledge.stimulus.getHeight();
+		inferPits(knowledge);
+		inferWumpus(knowledge);
+	}
+
+	void ProbabilisticInference::clearCache()
+	{
+		cache.clear();
+	}
+
+	double ProbabilisticInference::getPitProbability(unsigned x, unsigned y) const
+	{
+		std::unordered_map<unsigned, double>::const_iterator found = pitProbabilities.find(x * height + y);
+		return found == pitProbabilities.end() ? pitPrior : found->second;
+	}
+
+	double ProbabilisticInference::getWumpusProbability(unsigned x, unsigned y) const
+	{
+		std::unordered_map<unsigned, double>::const_iterator found = wumpusProbabilities.find(x * height + y);
+		return found == wumpusProbabilities.end() ? wumpusDefault : found->second;
+	}
+
+	double ProbabilisticInference::getRisk(unsigned x, unsigned y) const
+	{
+		return 1.0 - (1.0 - getPitProbability(x, y)) * (1.0 - getWumpusProbability(x, y));
+	}
+
+	void ProbabilisticInference::inferPits(Knowledge const& knowledge)
+	{
+		CellSet const& explored = knowledge.explored;
+		std::unordered_map<unsigned, unsigned> variables; // Frontier cell -> variable
+		std::vector<unsigned> variableCells;
+		std::vector<std::vector<unsigned> > breezes; // Variables next to each breeze
+
+		pitProbabilities.clear();
+		componentCount = largestComponent = frontierSize = 0;
+
+		// Explored cells hold no pit, and neither do the neighbors of one without a breeze.
+		for (std::size_t index = 0; index < explored.size(); index++)
+			pitProbabilities[explored[index]] = 0;
+
+		for (std::size_t index = 0; index < explored.size(); index++)
+		{
+			unsigned cell = explored[index], x = cell / height, y = cell % height;
+
+			if (knowledge.stimulus(x, y) & BREEZE)
+				continue;
+
+			for (int direction = 0; direction < 4; direction++)
+			{
+				unsigned newX = x + offset[direction][0], newY = y + offset[direction][1];
+
+				if (knowledge.stimulus.contains(newX, newY) && pitProbabilities.insert(std::make_pair(newX * height + newY, 0.0)).second)
+					frontierSize++;
+			}
+		}
+
+		// Every other neighbor of a breeze might hold the pit that explains it.
+		for (std::size_t index = 0; index < explored.size(); index++)
+		{
+			unsigned cell = explored[index], x = cell / height, y = cell % height;
+
+			if (!(knowledge.stimulus(x, y) & BREEZE))
+				continue;
+
+			std::vector<unsigned> breeze;
+
+			for (int direction = 0; direction < 4; direction++)
+			{
+				unsigned newX = x + offset[direction][0], newY = y + offset[direction][1];
+				unsigned newCell = newX * height + newY;
+
+				if (!knowledge.stimulus.contains(newX, newY) || pitProbabilities.count(newCell))
+					continue;
+
+				std::pair<std::unordered_map<unsigned, unsigned>::iterator, bool> inserted
+					= variables.insert(std::make_pair(newCell, (unsigned)variableCells.size()));
+
+				if (inserted.second)
+					variableCells.push_back(newCell);
+
+				breeze.push_back(inserted.first->second);
+			}
+
+			if (!breeze.empty())
+				breezes.push_back(breeze);
+		}
+
+		frontierSize += variableCells.size();
+
+		// Variables sharing a breeze belong to the same component.
+		std::vector<unsigned> parents(variableCells.size());
+
+		for (unsigned index = 0; index < parents.size(); index++)
+			parents[index] = index;
+
+		for (std::size_t index = 0; index < breezes.size(); index++)
+			for (std::size_t member = 1; member < breezes[index].size(); member++)
+				parents[findRoot(parents, breezes[index][member])] = findRoot(parents, breezes[index][0]);
+
+		std::unordered_map<unsigned, Component> components; // Keyed by root
+
+		for (unsigned index = 0; index < variableCells.size(); index++)
+			components[findRoot(parents, index)].cells.push_back(variableCells[index]);
+
+		for (std::size_t index = 0; index < breezes.size(); index++)
+			components[findRoot(parents, breezes[index][0])].breezes.push_back(breezes[index]);
+
+		for (std::unordered_map<unsigned, Component>::iterator entry = components.begin(); entry != components.end(); ++entry)
+		{
+			Component& component = entry->second;
+
+			// Put the component in a canonical form, cells in map order and breezes as
+			// sorted local indices, so that equal shapes share one memo entry wherever
+			// they are on the map.
+			std::sort(component.cells.begin(), component.cells.end());
+
+			for (std::size_t index = 0; index < component.breezes.size(); index++)
+			{
+				std::vector<unsigned>& breeze = component.breezes[index];
+
+				for (std::size_t member = 0; member < breeze.size(); member++)
+					breeze[member] = (unsigned)(std::lower_bound(component.cells.begin(), component.cells.end(),
+					                                             variableCells[breeze[member]]) - component.cells.begin());
+
+				std::sort(breeze.begin(), breeze.end());
+			}
+
+			std::sort(component.breezes.begin(), component.breezes.end());
+			component.breezes.erase(std::unique(component.breezes.begin(), component.breezes.end()), component.breezes.end());
+
+			std::vector<unsigned> key(1, (unsigned)component.cells.size());
+
+			for (std::size_t index = 0; index < component.breezes.size(); index++)
+			{
+				key.push_back((unsigned)component.breezes[index].size());
+				key.insert(key.end(), component.breezes[index].begin(), component.breezes[index].end());
+			}
+
+			componentCount++;
+			largestComponent = std::max(largestComponent, component.cells.size());
+
+			std::map<std::vector<unsigned>, std::vector<double> >::const_iterator cached = cache.find(key);
+			std::vector<double> probabilities;
+
+			if (cached != cache.end())
+			{
+				cacheHits++;
+				probabilities = cached->second;
+			}
+			else
+			{
+				cacheMisses++;
+
+				if (!solve(component, probabilities))
+					continue;
+
+				if (cache.size() >= cacheLimit)
+					cache.clear();
+
+				cache[key] = probabilities;
+			}
+
+			for (std::size_t index = 0; index < component.cells.size(); index++)
+				pitProbabilities[component.cells[index]] = probabilities[index];
+		}
+	}
+
+	bool ProbabilisticInference::solve(Component const& component, std::vector<double>& probabilities) const
+	{
+		std::size_t cellCount = component.cells.size();
+		std::vector<std::uint64_t> touched(cellCount, 0), closed(cellCount, 0);
+		std::vector<std::vector<unsigned> > starting(cellCount);
+
+		// Cells are decided in map order. A breeze is in progress from its first cell to its
+		// last, and holds one bit of the state meanwhile; the bits are reused once free.
+		for (std::size_t index = 0; index < component.breezes.size(); index++)
+			starting[component.breezes[index].front()].push_back((unsigned)index);
+
+		std::vector<int> slots(component.breezes.size(), -1);
+		std::vector<int> freeSlots;
+		int slotCount = 0;
+
+		for (std::size_t cell = 0; cell < cellCount; cell++)
+		{
+			for (std::size_t index = 0; index < starting[cell].size(); index++)
+			{
+				unsigned breeze = starting[cell][index];
+
+				if (freeSlots.empty())
+				{
+					if (slotCount == 64)
+						return false;
+
+					freeSlots.push_back(slotCount++);
+				}
+
+				slots[breeze] = freeSlots.back();
+				freeSlots.pop_back();
+
+				std::vector<unsigned> const& members = component.breezes[breeze];
+
+				for (std::size_t member = 0; member < members.size(); member++)
+					touched[members[member]] |= std::uint64_t(1) << slots[breeze];
+
+				closed[members.back()] |= std::uint64_t(1) << slots[breeze];
+			}
+
+			for (int slot = 0; slot < slotCount; slot++)
+				if ((closed[cell] >> slot) & 1)
+					freeSlots.push_back(slot);
+		}
+
+		// The weight of an assignment is (p / (1 - p)) to the number of pits, which is its
+		// prior probability up to a factor shared by all assignments.
+		double const pitWeight = pitPrior / (1.0 - pitPrior);
+		std::vector<StateWeights> forward(cellCount + 1);
+
+		forward[0][0] = 1;
+
+		for (std::size_t cell = 0; cell < cellCount; cell++)
+		{
+			for (StateWeights::const_iterator state = forward[cell].begin(); state != forward[cell].end(); ++state)
+			{
+				std::uint64_t empty = state->first, pit = state->first | touched[cell];
+
+				// A breeze with no pit among its cells by its last cell is unexplained.
+				if ((empty & closed[cell]) == closed[cell])
+					forward[cell + 1][empty & ~closed[cell]] += state->second;
+
+				forward[cell + 1][pit & ~closed[cell]] += state->second * pitWeight;
+			}
+
+			normalize(forward[cell + 1]);
+		}
+
+		// Walks back, combining the weight of the cells decided so far (forward) with the
+		// weight of the ways to finish (backward) to get each cell's share of pits.
+		StateWeights backward, previous;
+
+		backward[0] = 1;
+		probabilities.assign(cellCount, 0.0);
+
+		for (std::size_t cell = cellCount; cell-- > 0; )
+		{
+			double total = 0, withPit = 0;
+
+			previous.clear();
+
+			for (StateWeights::const_iterator state = forward[cell].begin(); state != forward[cell].end(); ++state)
+			{
+				std::uint64_t empty = state->first, pit = state->first | touched[cell];
+				double emptyWeight = 0, pitWeightAfter = 0;
+				StateWeights::const_iterator found;
+
+				if ((empty & closed[cell]) == closed[cell] && (found = backward.find(empty & ~closed[cell])) != backward.end())
+					emptyWeight = found->second;
+
+				if ((pit & closed[cell]) == closed[cell] && (found = backward.find(pit & ~closed[cell])) != backward.end())
+					pitWeightAfter = found->second * pitWeight;
+
+				previous[state->first] = emptyWeight + pitWeightAfter;
+				total += state->second * (emptyWeight + pitWeightAfter);
+				withPit += state->second * pitWeightAfter;
+			}
+
+			probabilities[cell] = total > 0 ? withPit / total : pitPrior;
+			normalize(previous);
+			backward.swap(previous);
+		}
+
+		return true;
+	}
+
+	void ProbabilisticInference::inferWumpus(Knowledge const& knowledge)
+	{
+		CellSet const& explored = knowledge.explored;
+		std::vector<unsigned> stenches;
+
+		wumpusProbabilities.clear();
+
+		for (std::size_t index = 0; index < explored.size(); index++)
+		{
+			unsigned cell = explored[index];
+
+			wumpusProbabilities[cell] = 0;
+
+			if (knowledge.stimulus(cell / height, cell % height) & STENCH)
+				stenches.push_back(cell);
+		}
+
+		if (stenches.empty())
+		{
+			// Nothing smelled yet: the wumpus is anywhere not explored or next to an
+			// explored cell.
+			for (std::size_t index = 0; index < explored.size(); index++)
+			{
+				unsigned cell = explored[index], x = cell / height, y = cell % height;
+
+				for (int direction = 0; direction < 4; direction++)
+				{
+					unsigned newX = x + offset[direction][0], newY = y + offset[direction][1];
+
+					if (knowledge.stimulus.contains(newX, newY))
+						wumpusProbabilities[newX * height + newY] = 0;
+				}
+			}
+
+			std::size_t remaining = (std::size_t)width * height - wumpusProbabilities.size();
+			wumpusDefault = remaining ? 1.0 / remaining : 0.0;
+			return;
+		}
+
+		// The wumpus is next to every stench, and next to no explored cell without one.
+		std::vector<unsigned> candidates;
+		unsigned firstX = stenches[0] / height, firstY = stenches[0] % height;
+
+		for (int direction = 0; direction < 4; direction++)
+		{
+			unsigned x = firstX + offset[direction][0], y = firstY + offset[direction][1];
+
+			if (!knowledge.stimulus.contains(x, y) || explored.contains(x * height + y))
+				continue;
+
+			bool possible = true;
+
+			for (std::size_t index = 1; index < stenches.size() && possible; index++)
+			{
+				unsigned stenchX = stenches[index] / height, stenchY = stenches[index] % height;
+				unsigned distance = (x > stenchX ? x - stenchX : stenchX - x) + (y > stenchY ? y - stenchY : stenchY - y);
+
+				possible = (distance == 1);
+			}
+
+			for (int neighbor = 0; neighbor < 4 && possible; neighbor++)
+			{
+				unsigned newX = x + offset[neighbor][0], newY = y + offset[neighbor][1];
+
+				if (knowledge.stimulus.contains(newX, newY) && explored.contains(newX * height + newY))
+					possible = (knowledge.stimulus(newX, newY) & STENCH) != 0;
+			}
+
+			if (possible)
+				candidates.push_back(x * height + y);
+		}
+
+		wumpusDefault = 0;
+
+		for (std::size_t index = 0; index < candidates.size(); index++)
+			wumpusProbabilities[candidates[index]] = 1.0 / candidates.size();
+	}
+}}  // namespace fullsail_ai::fundamentals
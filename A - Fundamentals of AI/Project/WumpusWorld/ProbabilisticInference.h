@@ -0,0 +1,103 @@
+//! \file ProbabilisticInference.h
+//! \brief Defines the <code>fullsail_ai::fundamentals::ProbabilisticInference</code> class.
+#ifndef _FULLSAIL_AI_FUNDAMENTALS_PROBABILISTIC_INFERENCE_H_
+#define _FULLSAIL_AI_FUNDAMENTALS_PROBABILISTIC_INFERENCE_H_
+
+#include <cstddef>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+namespace fullsail_ai { namespace fundamentals {
+
+	struct Knowledge;
+
+	//! \brief Computes the exact probability of a pit and of the wumpus in every cell, given
+	//! the <code>BREEZE</code> and <code>STENCH</code> the agent has perceived so far.
+	//!
+	//! The model is the one <code>WorldGenerator</code> draws from: every cell but the start
+	//! holds a pit independently with a fixed probability, and the wumpus is in one of the
+	//! cells other than the start, uniformly. Pits and wumpus are independent, and so are
+	//! their percepts, so the two are inferred separately.
+	//!
+	//! Pits are the expensive part. Only the unexplored cells next to explored ones (the
+	//! frontier) are constrained; every other unexplored cell keeps the prior. Cells next to
+	//! an explored cell without a breeze hold no pit, and the rest of the frontier splits
+	//! into components linked by shared breezes, which are independent of each other. Each
+	//! component is summed over all its pit assignments by dynamic programming along the
+	//! component, keeping only which of the breezes in progress a pit has explained yet,
+	//! and assignments that leave a breeze unexplained are dropped as soon as its last
+	//! cell is decided. Components are memoized, so a tick that only changes one corner of
+	//! the frontier recomputes just the components there.
+	//!
+	//! \note
+	//!   - A component whose cells cannot be ordered with at most 64 breezes in progress at
+	//!     once is not enumerated; its cells keep the prior. The frontiers of generated maps
+	//!     stay far below that.
+	//!   - Percepts that no world could produce (a breeze with every neighbor explored)
+	//!     are ignored.
+	//!   - The wumpus is assumed to be alive.
+	class ProbabilisticInference
+	{
+		struct Component
+		{
+			std::vector<unsigned> cells;
+			std::vector<std::vector<unsigned> > breezes; // Indices into cells
+		};
+
+		double pitPrior;
+		unsigned width;
+		unsigned height;
+
+		std::unordered_map<unsigned, double> pitProbabilities; // Cells that differ from the prior
+		std::unordered_map<unsigned, double> wumpusProbabilities; // Cells that differ from wumpusDefault
+		double wumpusDefault;
+
+		std::map<std::vector<unsigned>, std::vector<double> > cache;
+		std::size_t cacheHits;
+		std::size_t cacheMisses;
+		std::size_t componentCount;
+		std::size_t largestComponent;
+		std::size_t frontierSize;
+
+		void inferPits(Knowledge const& knowledge);
+		void inferWumpus(Knowledge const& knowledge);
+		bool solve(Component const& component, std::vector<double>& probabilities) const;
+
+	public:
+		//! \brief The number of components remembered before the memo is emptied.
+		static std::size_t const cacheLimit = 4096;
+
+		//! \brief Creates an engine for maps whose pits were drawn with \a pitProbability.
+		explicit ProbabilisticInference(double pitProbability = 0.2);
+
+		//! \brief Recomputes every probability from the cells \a knowledge has explored.
+		void update(Knowledge const& knowledge);
+
+		//! \brief Forgets the memoized components.
+		void clearCache();
+
+		//! \brief Returns the probability that (\a x, \a y) holds a pit.
+		double getPitProbability(unsigned x, unsigned y) const;
+
+		//! \brief Returns the probability that (\a x, \a y) holds the wumpus.
+		double getWumpusProbability(unsigned x, unsigned y) const;
+
+		//! \brief Returns the probability that entering (\a x, \a y) is fatal.
+		double getRisk(unsigned x, unsigned y) const;
+
+		//! \brief Returns the number of unexplored cells next to explored ones.
+		std::size_t getFrontierSize() const { return frontierSize; }
+
+		//! \brief Returns the number of components the last update enumerated or looked up.
+		std::size_t getComponentCount() const { return componentCount; }
+
+		//! \brief Returns the number of cells in the largest of those components.
+		std::size_t getLargestComponent() const { return largestComponent; }
+
+		std::size_t getCacheHits() const { return cacheHits; }
+		std::size_t getCacheMisses() const { return cacheMisses; }
+	};
+}}  // namespace fullsail_ai::fundamentals
+
+#endif  // _FULLSAIL_AI_FUNDAMENTALS_PROBABILISTIC_INFERENCE_H_
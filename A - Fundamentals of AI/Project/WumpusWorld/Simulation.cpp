@@ -0,0 +1,126 @@
+//! \file Simulation.cpp
+//! \brief Implements the <code>fullsail_ai::fundamentals::Simulation</code> class.
+
+#include "../BehaviorTree/BehaviorArena.h"
+#include "Agent.h"
+#include "BehaviorLog.h"
+#include "Behaviors.h"
+#include "Simulation.h"
+
+namespace fullsail_ai { namespace fundamentals {
+
+	namespace {
+
+		void ignoreBehavior(Behavior const*)
+		{
+		}
+
+		// Per-worker results, kept on separate cache lines.
+		struct alignas(64) WorkerState
+		{
+			SimulationStatistics statistics;
+			BehaviorArena arena; // Holds the worker's tree
+			Behavior* behavior;
+		};
+	}
+
+	SimulationStatistics::SimulationStatistics()
+		: episodes(0), wins(0), deaths(0), goldRetrieved(0), wumpusKilled(0), timeouts(0), ticks(0)
+	{
+	}
+
+	void SimulationStatistics::add(EpisodeResult const& result)
+	{
+		episodes++;
+		wins += (result.agentAlive && result.goldRetrieved) ? 1 : 0;
+		deaths += result.agentAlive ? 0 : 1;
+		goldRetrieved += result.goldRetrieved ? 1 : 0;
+		wumpusKilled += result.wumpusKilled ? 1 : 0;
+		timeouts += result.timedOut ? 1 : 0;
+		ticks += result.ticks;
+	}
+
+	void SimulationStatistics::add(SimulationStatistics const& statistics)
+	{
+		episodes += statistics.episodes;
+		wins += statistics.wins;
+		deaths += statistics.deaths;
+		goldRetrieved += statistics.goldRetrieved;
+		wumpusKilled += statistics.wumpusKilled;
+		timeouts += statistics.timeouts;
+		ticks += statistics.ticks;
+	}
+
+	Simulation::Simulation(unsigned _worldSize, unsigned _tickLimit)
+		: generator(_worldSize, _worldSize), tickLimit(_tickLimit)
+	{
+	}
+
+	EpisodeResult Simulation::runEpisode(unsigned seed, Behavior& behavior, BehaviorLog* log) const
+	{
+		vector<char> cells(generator.getCellCount());
+
+		generator.generate(seed, &cells[0]);
+
+		World world(&cells[0], generator.getWidth(), generator.getHeight());
+		Agent agent(world, behavior, log ? BehaviorLog::logNode : ignoreBehavior);
+		EpisodeResult result = { seed, 0, true, false, false, false };
+
+		agent.enter(world.getAgentX(), world.getAgentY());
+
+		if (log)
+		{
+			log->beginTick(seed, 0);
+			log->logStatus(world);
+		}
+
+		while (world.isAgentAlive() && world.doesAgentHaveArrow() && result.ticks < tickLimit)
+		{
+			if (log)
+				log->beginTick(seed, result.ticks + 1);
+
+			agent.update();
+			result.ticks++;
+
+			if (log)
+				log->logStatus(world);
+		}
+
+		agent.exit();
+
+		result.agentAlive = world.isAgentAlive();
+		result.goldRetrieved = world.isGoldRetrieved();
+		result.wumpusKilled = !world.isWumpusAlive();
+		result.timedOut = world.isAgentAlive() && world.doesAgentHaveArrow();
+		return result;
+	}
+
+	SimulationStatistics Simulation::run(std::vector<unsigned> const& seeds, WorkStealingPool& pool,
+	                                     BehaviorLog* log) const
+	{
+		std::vector<WorkerState> workers(pool.getWorkerCount());
+		SimulationStatistics totals;
+
+		for (size_t worker = 0; worker < workers.size(); worker++)
+			workers[worker].behavior = 0;
+
+		pool.parallelFor(seeds.size(), [&](size_t index, unsigned worker)
+		{
+			WorkerState& state = workers[worker];
+
+			if (state.behavior == 0)
+				state.behavior = createBasicBehavior(state.arena);
+
+			state.statistics.add(runEpisode(seeds[index], *state.behavior, log));
+		});
+
+		// The log names nodes as it writes them, so before the trees go.
+		if (log)
+			log->flush();
+
+		for (size_t worker = 0; worker < workers.size(); worker++)
+			totals.add(workers[worker].statistics);
+
+		return totals;
+	}
+}}  // namespace fullsail_ai::fundamentals
@@ -0,0 +1,78 @@
+//! \file Simulation.h
+//! \brief Defines the <code>fullsail_ai::fundamentals::Simulation</code> class.
+#ifndef _FULLSAIL_AI_FUNDAMENTALS_SIMULATION_H_
+#define _FULLSAIL_AI_FUNDAMENTALS_SIMULATION_H_
+
+#include <vector>
+#include "../BehaviorTree/Behavior.h"
+#include "WorkStealingPool.h"
+#include "WorldGenerator.h"
+
+namespace fullsail_ai { namespace fundamentals {
+
+	class BehaviorLog;
+
+	//! \brief Outcome of one headless episode.
+	struct EpisodeResult
+	{
+		unsigned seed; // Seed of the generated world
+		unsigned ticks; // Number of agent updates run
+		bool agentAlive; // Whether the agent survived
+		bool goldRetrieved; // Whether the agent picked up the gold
+		bool wumpusKilled; // Whether the agent's arrow found the wumpus
+		bool timedOut; // Whether the episode was cut off at the tick limit
+	};
+
+	//! \brief Totals over a set of episodes.
+	struct SimulationStatistics
+	{
+		unsigned episodes;
+		unsigned wins; // Episodes in which the agent got the gold and survived
+		unsigned deaths;
+		unsigned goldRetrieved;
+		unsigned wumpusKilled;
+		unsigned timeouts;
+		unsigned long long ticks;
+
+		SimulationStatistics();
+
+		void add(EpisodeResult const& result);
+		void add(SimulationStatistics const& statistics);
+	};
+
+	//! \brief Runs <code>World</code> + <code>Agent</code> + behavior tree episodes without
+	//! any console output.
+	//!
+	//! An episode ends the way <code>Game</code>'s does, when the agent dies or has used
+	//! its arrow, or else after the tick limit, since some worlds leave the agent
+	//! wandering forever.
+	class Simulation
+	{
+		WorldGenerator generator;
+		unsigned tickLimit;
+
+	public:
+		//! \brief Creates a runner for square worlds of the specified size, generated by
+		//! <code>WorldGenerator</code>.
+		Simulation(unsigned _worldSize, unsigned _tickLimit);
+
+		//! \brief Runs one episode in the world generated from \a seed, with the agent
+		//! driven by \a behavior.
+		//!
+		//! With a \a log, every update is a tick of the agent numbered \a seed: the nodes
+		//! that succeed and the world after it are logged, tick 0 being the world the agent
+		//! enters.
+		EpisodeResult runEpisode(unsigned seed, Behavior& behavior, BehaviorLog* log = NULL) const;
+
+		//! \brief Runs one episode per seed on the pool and returns the totals.
+		//!
+		//! Each worker builds its own copy of <code>createBasicBehavior()</code>, so no
+		//! behavior node is shared between threads. The totals do not depend on how the
+		//! episodes were scheduled. Whatever the episodes logged to \a log has been written
+		//! when it returns.
+		SimulationStatistics run(std::vector<unsigned> const& seeds, WorkStealingPool& pool,
+		                         BehaviorLog* log = NULL) const;
+	};
+}}  // namespace fullsail_ai::fundamentals
+
+#endif  // _FULLSAIL_AI_FUNDAMENTALS_SIMULATION_H_
@@ -0,0 +1,174 @@
+//! \file WorkStealingPool.cpp
+//! \brief Implements the <code>fullsail_ai::fundamentals::WorkStealingPool</code> class.
+
+#include "WorkStealingPool.h"
+
+namespace fullsail_ai { namespace fundamentals {
+
+	WorkStealingPool::WorkStealingPool(unsigned workerCount)
+		: task(0), generation(0), activeWorkers(0), stopping(false)
+	{
+		if (workerCount == 0)
+			workerCount = 1;
+
+		shares = new Share[workerCount];
+
+		for (unsigned worker = 0; worker < workerCount; worker++)
+		{
+			shares[worker].begin = shares[worker].end = 0;
+			threads.push_back(std::thread(&WorkStealingPool::work, this, worker));
+		}
+	}
+
+	WorkStealingPool::~WorkStealingPool()
+	{
+		{
+			std::lock_guard<std::mutex> lock(controlMutex);
+			stopping = true;
+		}
+
+		workReady.notify_all();
+
+		for (size_t index = 0; index < threads.size(); index++)
+			threads[index].join();
+
+		delete[] shares;
+	}
+
+	unsigned WorkStealingPool::getWorkerCount() const
+	{
+		return (unsigned)threads.size();
+	}
+
+	void WorkStealingPool::parallelFor(std::size_t count, Task const& _task)
+	{
+		if (count == 0)
+			return;
+
+		unsigned workerCount = getWorkerCount();
+
+		// Deal out equal shares; the first (count % workerCount) workers get one extra.
+		for (unsigned worker = 0; worker < workerCount; worker++)
+		{
+			std::lock_guard<std::mutex> lock(shares[worker].mutex);
+			shares[worker].begin = count * worker / workerCount;
+			shares[worker].end = count * (worker + 1) / workerCount;
+		}
+
+		std::unique_lock<std::mutex> lock(controlMutex);
+		task = &_task;
+		activeWorkers = workerCount;
+		generation++;
+		workReady.notify_all();
+
+		while (activeWorkers > 0)
+			workDone.wait(lock);
+
+		task = 0;
+	}
+
+	void WorkStealingPool::work(unsigned worker)
+	{
+		unsigned seenGeneration = 0;
+
+		for (;;)
+		{
+			{
+				std::unique_lock<std::mutex> lock(controlMutex);
+
+				while (!stopping && generation == seenGeneration)
+					workReady.wait(lock);
+
+				if (stopping)
+					return;
+
+				seenGeneration = generation;
+			}
+
+			runShare(worker);
+
+			std::lock_guard<std::mutex> lock(controlMutex);
+
+			if (--activeWorkers == 0)
+				workDone.notify_one();
+		}
+	}
+
+	void WorkStealingPool::runShare(unsigned worker)
+	{
+		std::size_t index;
+
+		// Shares only ever shrink or move between workers, so once nothing is left to
+		// steal, every remaining index is already owned by a worker that will run it.
+		do
+		{
+			while (takeOwn(worker, index))
+				(*task)(index, worker);
+		}
+		while (steal(worker));
+	}
+
+	bool WorkStealingPool::takeOwn(unsigned worker, std::size_t& index)
+	{
+		Share& share = shares[worker];
+		std::lock_guard<std::mutex> lock(share.mutex);
+
+		if (share.begin == share.end)
+			return false;
+
+		index = share.begin++;
+		return true;
+	}
+
+	bool WorkStealingPool::steal(unsigned worker)
+	{
+		unsigned workerCount = getWorkerCount();
+
+		for (;;)
+		{
+			// Pick the victim with the most work left. The sizes are only a hint; the
+			// victim's share is checked again under its lock.
+			unsigned victim = worker;
+			std::size_t largest = 0;
+
+			for (unsigned other = 0; other < workerCount; other++)
+			{
+				if (other == worker)
+					continue;
+
+				std::lock_guard<std::mutex> lock(shares[other].mutex);
+				std::size_t remaining = shares[other].end - shares[other].begin;
+
+				if (remaining > largest)
+				{
+					largest = remaining;
+					victim = other;
+				}
+			}
+
+			if (victim == worker)
+				return false;
+
+			std::size_t begin, end;
+
+			{
+				Share& share = shares[victim];
+				std::lock_guard<std::mutex> lock(share.mutex);
+
+				// The victim may have run or lost its work in the meantime; look again.
+				if (share.begin == share.end)
+					continue;
+
+				// Take the back half, rounded up, so a single remaining index can be stolen.
+				begin = share.begin + (share.end - share.begin) / 2;
+				end = share.end;
+				share.end = begin;
+			}
+
+			std::lock_guard<std::mutex> lock(shares[worker].mutex);
+			shares[worker].begin = begin;
+			shares[worker].end = end;
+			return true;
+		}
+	}
+}}  // namespace fullsail_ai::fundamentals
@@ -0,0 +1,90 @@
+//! \file WorkStealingPool.h
+//! \brief Defines the <code>fullsail_ai::fundamentals::WorkStealingPool</code> class.
+#ifndef _FULLSAIL_AI_FUNDAMENTALS_WORK_STEALING_POOL_H_
+#define _FULLSAIL_AI_FUNDAMENTALS_WORK_STEALING_POOL_H_
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace fullsail_ai { namespace fundamentals {
+
+	//! \brief Fixed set of worker threads that run the iterations of a parallel loop,
+	//! balancing uneven iterations by stealing.
+	//!
+	//! Each call to <code>parallelFor()</code> deals the index range out to the workers
+	//! in equal contiguous shares. A worker runs its own share from the front; once it
+	//! runs dry it steals the back half of the largest share left, so long episodes on
+	//! one worker do not leave the others idle.
+	//!
+	//! \note
+	//!   - Tasks must not throw, and must not call <code>parallelFor()</code> themselves.
+	//!   - Only one thread may call <code>parallelFor()</code> at a time.
+	class WorkStealingPool
+	{
+	public:
+		//! \brief Type of a loop body. Receives the iteration index and the index of the
+		//! worker running it, which is less than <code>getWorkerCount()</code>.
+		typedef std::function<void (std::size_t index, unsigned worker)> Task;
+
+	private:
+		// The part of the index range one worker still has to run. Each share sits on its
+		// own cache line so that workers only contend on it while stealing.
+		struct alignas(64) Share
+		{
+			std::mutex mutex;
+			std::size_t begin;
+			std::size_t end;
+		};
+
+		std::vector<std::thread> threads;
+		Share* shares;
+
+		// Hands out loops to the workers and collects them again.
+		std::mutex controlMutex;
+		std::condition_variable workReady;
+		std::condition_variable workDone;
+		Task const* task;
+		unsigned generation;
+		unsigned activeWorkers;
+		bool stopping;
+
+		// The body of each worker thread.
+		void work(unsigned worker);
+
+		// Runs the worker's share of the current loop, stealing once it runs dry.
+		void runShare(unsigned worker);
+
+		// Takes the next index of the worker's own share. Returns false if it is empty.
+		bool takeOwn(unsigned worker, std::size_t& index);
+
+		// Moves the back half of the largest other share into the worker's own share.
+		// Returns false if there was nothing left to steal.
+		bool steal(unsigned worker);
+
+	public:
+		//! \brief Starts \a workerCount threads (at least one).
+		explicit WorkStealingPool(unsigned workerCount);
+
+		//! \brief Stops and joins the worker threads.
+		~WorkStealingPool();
+
+	private:
+		// Do not implement.
+		WorkStealingPool(WorkStealingPool const&);
+		WorkStealingPool& operator=(WorkStealingPool const&);
+
+	public:
+		//! \brief Returns the number of worker threads.
+		unsigned getWorkerCount() const;
+
+		//! \brief Runs \a task once for every index in [0, \a count) on the worker threads,
+		//! and returns once all of them have finished.
+		void parallelFor(std::size_t count, Task const& task);
+	};
+}}  // namespace fullsail_ai::fundamentals
+
+#endif  // _FULLSAIL_AI_FUNDAMENTALS_WORK_STEALING_POOL_H_
@@ -13,17 +13,29 @@ namespace fullsail_ai { namespace fundamentals {
 	{
 		width = _width;
 		height = _height;
-		stimulus.resize(width);
+		stimulus.assign(width, height);
 
 		for (int xIndex = 0; xIndex < width; xIndex++)
-		{
-			stimulus[xIndex].resize(height);
+			for (int yIndex = 0; yIndex < height; yIndex++)
+				stimulus(xIndex, yIndex) = _stimulus[xIndex][yIndex];
+
+		findStart();
+	}
+
+	World::World(char const* cells, unsigned _width, unsigned _height) : stimulus(cells, _width, _height)
+	{
+		width = _width;
+		height = _height;
+		findStart();
+	}
 
+	void World::findStart()
+	{
+		for (int xIndex = 0; xIndex < width; xIndex++)
+		{
 			for (int yIndex = 0; yIndex < height; yIndex++)
 			{
-				stimulus[xIndex][yIndex] = _stimulus[xIndex][yIndex];
-
-				if (stimulus[xIndex][yIndex] & START)
+				if (stimulus(xIndex, yIndex) & START)
 				{
 					agentX = xIndex;
 					agentY = yIndex;
@@ -40,7 +52,7 @@ namespace fullsail_ai { namespace fundamentals {
 	// Get methods
 	char World::getStimulus()
 	{
-		return stimulus[agentX][agentY];
+		return stimulus(agentX, agentY);
 	}
 	
 	unsigned World::getWidth()
@@ -53,6 +65,36 @@ namespace fullsail_ai { namespace fundamentals {
 		return height;
 	}
 
+	unsigned World::getAgentX() const
+	{
+		return agentX;
+	}
+
+	unsigned World::getAgentY() const
+	{
+		return agentY;
+	}
+
+	bool World::isAgentAlive() const
+	{
+		return agentAlive;
+	}
+
+	bool World::isWumpusAlive() const
+	{
+		return wumpusAlive;
+	}
+
+	bool World::isGoldRetrieved() const
+	{
+		return goldRetrieved;
+	}
+
+	bool World::doesAgentHaveArrow() const
+	{
+		return agentHasArrow;
+	}
+
 	// Agent actions
 	bool World::moveAgent(Direction direction)
 	{
@@ -93,7 +135,7 @@ namespace fullsail_ai { namespace fundamentals {
 			break;
 		}
 
-		if ((stimulus[agentX][agentY] & WUMPUS) || (stimulus[agentX][agentY] & PIT))
+		if ((stimulus(agentX, agentY) & WUMPUS) || (stimulus(agentX, agentY) & PIT))
 			agentAlive = false;
 
 		return success;
@@ -101,9 +143,9 @@ namespace fullsail_ai { namespace fundamentals {
 
 	bool World::retrieveGold()
 	{
-		if (stimulus[agentX][agentY] & GOLD)
+		if (stimulus(agentX, agentY) & GOLD)
 		{
-			stimulus[agentX][agentY] ^= GOLD;
+			stimulus(agentX, agentY) ^= GOLD;
 			goldRetrieved = true;
 			return true;
 		}
@@ -121,30 +163,30 @@ namespace fullsail_ai { namespace fundamentals {
 		switch (direction)
 		{
 		case UP:
-			if (agentY > 0 && stimulus[agentX][agentY-1] & WUMPUS)
+			if (agentY > 0 && stimulus(agentX, agentY-1) & WUMPUS)
 			{
-				stimulus[agentX][agentY-1] ^= WUMPUS;
+				stimulus(agentX, agentY-1) ^= WUMPUS;
 				wumpusAlive = false;
 			}
 			return;
 		case DOWN:
-			if (agentY < height - 1 && stimulus[agentX][agentY+1] & WUMPUS)
+			if (agentY < height - 1 && stimulus(agentX, agentY+1) & WUMPUS)
 			{
-				stimulus[agentX][agentY+1] ^= WUMPUS;
+				stimulus(agentX, agentY+1) ^= WUMPUS;
 				wumpusAlive = false;
 			}
 			return;
 		case LEFT:
-			if (agentX > 0 && stimulus[agentX-1][agentY] & WUMPUS)
+			if (agentX > 0 && stimulus(agentX-1, agentY) & WUMPUS)
 			{
-				stimulus[agentX-1][agentY] ^= WUMPUS;
+				stimulus(agentX-1, agentY) ^= WUMPUS;
 				wumpusAlive = false;
 			}
 			return;
 		case RIGHT:
-			if (agentY < height - 1 && stimulus[agentX+1][agentY] & WUMPUS)
+			if (agentX < width - 1 && stimulus(agentX+1, agentY) & WUMPUS)
 			{
-				stimulus[agentX+1][agentY] ^= WUMPUS;
+				stimulus(agentX+1, agentY) ^= WUMPUS;
 				wumpusAlive = false;
 			}
 			return;
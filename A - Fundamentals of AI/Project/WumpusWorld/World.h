@@ -6,6 +6,7 @@
 
 #include <vector>
 #include "definitions.h"
+#include "Grid2D.h"
 
 using namespace std;
 
@@ -16,7 +17,7 @@ namespace fullsail_ai { namespace fundamentals {
 		friend class Game;
 
 	private:
-		vector<vector<char>> stimulus;
+		Grid2D<char> stimulus;
 		int width, height;
 		int agentX, agentY;
 
@@ -25,14 +26,24 @@ namespace fullsail_ai { namespace fundamentals {
 		bool goldRetrieved;
 		bool agentHasArrow;
 
+		// Places the agent on the START cell and resets the game state.
+		void findStart();
+
 	public:
 		// Constructor
 		World(char** _stimulus, unsigned _width, unsigned _height);
+		World(char const* cells, unsigned _width, unsigned _height); // Cell (x, y) at x * _height + y
 
 		// Get methods
 		char getStimulus();
 		unsigned getWidth();
 		unsigned getHeight();
+		unsigned getAgentX() const;
+		unsigned getAgentY() const;
+		bool isAgentAlive() const;
+		bool isWumpusAlive() const;
+		bool isGoldRetrieved() const;
+		bool doesAgentHaveArrow() const;
 
 		// Agent commands
 		bool moveAgent(Direction);
@@ -0,0 +1,192 @@
+//! \file WorldGenerator.cpp
+//! \brief Implements the <code>fullsail_ai::fundamentals::WorldGenerator</code> class.
+
+#include <cstring>
+#include <vector>
+#include "WorldGenerator.h"
+
+namespace fullsail_ai { namespace fundamentals {
+
+	namespace {
+
+		// Maps up to this tall keep their working columns on the stack.
+		unsigned const smallHeight = 256;
+
+		// SplitMix64: small, fast, and defined purely in 64-bit arithmetic, so every
+		// platform produces the same sequence for the same seed.
+		struct Random
+		{
+			unsigned long long state;
+
+			explicit Random(unsigned long long seed) : state(seed) { }
+
+			unsigned long long next()
+			{
+				unsigned long long z = (state += 0x9E3779B97F4A7C15ull);
+				z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+				z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+				return z ^ (z >> 31);
+			}
+
+			// Returns a value in [0, range). The bias is negligible for map-sized ranges.
+			std::size_t below(std::size_t range)
+			{
+				return (std::size_t)(next() % range);
+			}
+		};
+
+		// Draws the pit flags of one column, four cells per 64-bit draw. No pit is ever
+		// drawn in the start cell.
+		class PitSource
+		{
+			Random& random;
+			unsigned threshold;
+			char const* start;
+
+			// Arithmetic instead of a branch: a 20% branch mispredicts far too often.
+			char flag(unsigned long long bits) const
+			{
+				return (char)(-(int)((unsigned)(bits & 0xFFFF) < threshold) & PIT);
+			}
+
+		public:
+			PitSource(Random& _random, unsigned _threshold, char const* _start)
+				: random(_random), threshold(_threshold), start(_start)
+			{
+			}
+
+			// Writes PIT or NONE to flags for each of the count map cells starting at cell.
+			// Bits left over from the column's last draw are discarded.
+			void fill(char* flags, char const* cell, unsigned count)
+			{
+				unsigned index = 0;
+
+				for (; index + 4 <= count; index += 4)
+				{
+					unsigned long long bits = random.next();
+					flags[index] = flag(bits);
+					flags[index + 1] = flag(bits >> 16);
+					flags[index + 2] = flag(bits >> 32);
+					flags[index + 3] = flag(bits >> 48);
+				}
+
+				if (index < count)
+				{
+					unsigned long long bits = random.next();
+
+					for (; index < count; index++, bits >>= 16)
+						flags[index] = flag(bits);
+				}
+
+				if (start >= cell && start < cell + count)
+					flags[start - cell] = NONE;
+			}
+		};
+
+		// Sets the flag on the four neighbors of the cell that are on the map.
+		void markNeighbors(char* cells, unsigned width, unsigned height, std::size_t index, char flag)
+		{
+			unsigned x = (unsigned)(index / height), y = (unsigned)(index % height);
+
+			if (x > 0)
+				cells[index - height] |= flag;
+			if (x + 1 < width)
+				cells[index + height] |= flag;
+			if (y > 0)
+				cells[index - 1] |= flag;
+			if (y + 1 < height)
+				cells[index + 1] |= flag;
+		}
+	}
+
+	WorldGenerator::WorldGenerator(unsigned _width, unsigned _height, double pitProbability)
+		: width(_width), height(_height), pitThreshold((unsigned)(pitProbability * 65536.0))
+	{
+	}
+
+	unsigned WorldGenerator::getWidth() const
+	{
+		return width;
+	}
+
+	unsigned WorldGenerator::getHeight() const
+	{
+		return height;
+	}
+
+	std::size_t WorldGenerator::getCellCount() const
+	{
+		return (std::size_t)width * height;
+	}
+
+	void WorldGenerator::generate(unsigned long long seed, char* cells) const
+	{
+		std::size_t cellCount = getCellCount();
+		Random random(seed);
+		std::size_t start = random.below(cellCount);
+
+		// Pits are drawn one column ahead of the column being written, into a rolling
+		// window of three padded columns, so each cell's breeze is gathered from its
+		// neighbors and every cell of the map is written exactly once.
+		std::size_t stride = (std::size_t)height + 2;
+		char smallWindow[3 * (smallHeight + 2)];
+		std::vector<char> largeWindow;
+		char* window = smallWindow;
+
+		if (height > smallHeight)
+		{
+			largeWindow.resize(3 * stride);
+			window = &largeWindow[0];
+		}
+
+		char* previous = window;
+		char* current = window + stride;
+		char* next = window + 2 * stride;
+		PitSource pits(random, pitThreshold, cells + start);
+
+		std::memset(window, NONE, 3 * stride);
+		pits.fill(current + 1, cells, height);
+
+		for (unsigned x = 0; x < width; x++)
+		{
+			char* column = cells + (std::size_t)x * height;
+
+			if (x + 1 < width)
+				pits.fill(next + 1, column + height, height);
+			else
+				std::memset(next + 1, NONE, height);
+
+			// PIT >> 2 == BREEZE, so the breeze falls out of the neighbors' pit bits.
+			for (unsigned y = 1; y <= height; y++)
+				column[y - 1] = current[y] | (char)(((previous[y] | next[y] | current[y - 1] | current[y + 1]) & PIT) >> 2);
+
+			char* oldest = previous;
+			previous = current;
+			current = next;
+			next = oldest;
+		}
+
+		cells[start] |= START;
+
+		// The wumpus goes anywhere but the start cell.
+		std::size_t wumpus = (start + 1 + random.below(cellCount - 1)) % cellCount;
+		cells[wumpus] |= WUMPUS;
+		markNeighbors(cells, width, height, wumpus, STENCH);
+
+		// The gold prefers a cell with no pit and no wumpus; look forward from a random one.
+		std::size_t gold = (start + 1 + random.below(cellCount - 1)) % cellCount;
+
+		for (std::size_t tries = 0; tries < cellCount; tries++)
+		{
+			std::size_t candidate = (gold + tries) % cellCount;
+
+			if (candidate != start && !(cells[candidate] & (PIT | WUMPUS)))
+			{
+				gold = candidate;
+				break;
+			}
+		}
+
+		cells[gold] |= GOLD;
+	}
+}}  // namespace fullsail_ai::fundamentals
@@ -0,0 +1,50 @@
+//! \file WorldGenerator.h
+//! \brief Defines the <code>fullsail_ai::fundamentals::WorldGenerator</code> class.
+#ifndef _FULLSAIL_AI_FUNDAMENTALS_WORLD_GENERATOR_H_
+#define _FULLSAIL_AI_FUNDAMENTALS_WORLD_GENERATOR_H_
+
+#include <cstddef>
+#include "definitions.h"
+
+namespace fullsail_ai { namespace fundamentals {
+
+	//! \brief Generates random Wumpus worlds from a seed.
+	//!
+	//! Each world has a <code>START</code> cell, a <code>PIT</code> in every other cell with
+	//! the given probability, one <code>WUMPUS</code> and one piece of <code>GOLD</code>, and
+	//! the <code>STENCH</code> and <code>BREEZE</code> around them.
+	//!
+	//! \note
+	//!   - Worlds are written to a flat buffer in the layout <code>World</code> reads:
+	//!     cell (x, y) is at index <code>x * height + y</code>.
+	//!   - The same seed always produces the same world, on every platform.
+	//!   - The start cell never holds a pit, the wumpus or the gold, and the gold is
+	//!     never placed in a pit or with the wumpus unless the map has no room left.
+	//!     The gold may still be unreachable.
+	class WorldGenerator
+	{
+		unsigned width;
+		unsigned height;
+		unsigned pitThreshold; // Out of 65536
+
+	public:
+		//! \brief Creates a generator for worlds of the specified size.
+		//!
+		//! \pre
+		//!   - \a _width and \a _height are at least 1, and their product is at least 2.
+		//!   - \a pitProbability is between 0 and 1.
+		WorldGenerator(unsigned _width, unsigned _height, double pitProbability = 0.2);
+
+		unsigned getWidth() const;
+		unsigned getHeight() const;
+
+		//! \brief Returns the number of cells <code>generate()</code> writes.
+		std::size_t getCellCount() const;
+
+		//! \brief Writes the world for \a seed to \a cells, which must hold
+		//! <code>getCellCount()</code> elements.
+		void generate(unsigned long long seed, char* cells) const;
+	};
+}}  // namespace fullsail_ai::fundamentals
+
+#endif  // _FULLSAIL_AI_FUNDAMENTALS_WORLD_GENERATOR_H_
@@ -1,4 +1,21 @@
 #pragma once
 
-// Used to export DLL functions
-#define DLLEXPORT __declspec(dllexport)
+// Used to export DLL functions. The BehaviorTree library exports them, and any project
+// built against it may import them by defining BEHAVIORTREE_IMPORTS. Elsewhere only what
+// is marked is visible outside the shared library, when it is built with
+// -fvisibility=hidden; DLLEXPORT_CLASS marks the classes other modules derive from or
+// query with typeid, whose vtables and type information must be visible as well.
+#if defined(_WIN32)
+	#if defined(BEHAVIORTREE_IMPORTS)
+		#define DLLEXPORT __declspec(dllimport)
+	#else
+		#define DLLEXPORT __declspec(dllexport)
+	#endif
+	#define DLLEXPORT_CLASS
+#elif defined(__GNUC__)
+	#define DLLEXPORT __attribute__((visibility("default")))
+	#define DLLEXPORT_CLASS __attribute__((visibility("default")))
+#else
+	#define DLLEXPORT
+	#define DLLEXPORT_CLASS
+#endif